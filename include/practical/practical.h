@@ -16,6 +16,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/smart_ptr/intrusive_ref_counter.hpp>
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -34,6 +35,9 @@ DECL_TYPED_NS( PracticalSemanticAnalyzer, JumpPointId, unsigned long, 0, Practic
 namespace PracticalSemanticAnalyzer {
     class CompilerArguments {
     public:
+        // Directory to keep binary images of parsed modules in, so unchanged sources are not parsed again. Empty
+        // disables the cache
+        std::string parseCacheDir;
     };
 
     struct SourceLocation {
@@ -169,6 +173,26 @@ namespace PracticalSemanticAnalyzer {
         CPtr removeFlags( Flags::Type lessFlags ) const {
             return setFlags( getFlags() & ~lessFlags );
         }
+
+        // Hash of the type's structure, flags included. Calculated the first time it is asked for.
+        //
+        // Thread safe, as interned types are shared between threads. Threads that race to fill the cache all calculate,
+        // and store, the same value
+        size_t getHash() const {
+            size_t ret = hashValue.load( std::memory_order_relaxed );
+            if( ret==0 ) {
+                ret = calculateHash();
+                hashValue.store( ret, std::memory_order_relaxed );
+            }
+
+            return ret;
+        }
+
+    private:
+        size_t calculateHash() const;
+
+        // 0 until calculated. A type whose hash is 0 calculates it every time
+        mutable std::atomic<size_t> hashValue = 0;
     };
     std::ostream &operator<<(std::ostream &out, StaticType::CPtr type);
 
@@ -307,7 +331,9 @@ namespace PracticalSemanticAnalyzer {
 namespace std {
     template<>
     struct hash< PracticalSemanticAnalyzer::StaticType > {
-        size_t operator()(const PracticalSemanticAnalyzer::StaticType &type) const;
+        size_t operator()(const PracticalSemanticAnalyzer::StaticType &type) const {
+            return type.getHash();
+        }
     };
 
     template<>
@@ -0,0 +1,124 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "nocopy.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Bump pointer allocator. Objects allocated from an arena are all destroyed together, when it is cleared or destroyed.
+// Destruction is iterative, so deep structures do not recurse through their destructors.
+class Arena : private NoCopy {
+public:
+    static constexpr size_t ChunkSize = 64*1024;
+
+    // Resetting or destroying a pointer into the arena leaves the object alone
+    struct Release {
+        void operator()( const void * ) const {}
+    };
+    template<typename T>
+    using Ptr = std::unique_ptr<T, Release>;
+
+    Arena() = default;
+    ~Arena() {
+        clear();
+    }
+
+    template<typename T, typename... Args>
+    Ptr<T> make(Args&&... args) {
+        static_assert( alignof(T) <= alignof(std::max_align_t), "Over aligned types are not supported" );
+
+        if constexpr( std::is_trivially_destructible_v<T> ) {
+            return Ptr<T>( new( allocate( sizeof(T), alignof(T) ) ) T( std::forward<Args>(args)... ) );
+        } else {
+            // Get all the memory first, so that once T exists, nothing can fail before its destructor is registered
+            void *record = allocate( sizeof(Destructor), alignof(Destructor) );
+            T *object = new( allocate( sizeof(T), alignof(T) ) ) T( std::forward<Args>(args)... );
+            destructors = new(record) Destructor{ destroy<T>, object, destructors };
+
+            return Ptr<T>( object );
+        }
+    }
+
+    // Destroy all objects, in reverse order of allocation, and free the memory
+    void clear() {
+        while( destructors!=nullptr ) {
+            Destructor *record = destructors;
+            destructors = record->previous;
+            record->destroy( record->object );
+        }
+
+        chunks.clear();
+        current = nullptr;
+        remaining = 0;
+        allocated = 0;
+    }
+
+    // Bytes handed out so far, including padding
+    size_t bytesAllocated() const {
+        return allocated;
+    }
+
+private:
+    struct Destructor {
+        void (*destroy)(void *object);
+        void *object;
+        Destructor *previous;
+    };
+
+    std::vector< std::unique_ptr<std::max_align_t[]> > chunks;
+    char *current = nullptr;
+    size_t remaining = 0;
+    size_t allocated = 0;
+    Destructor *destructors = nullptr;
+
+    template<typename T>
+    static void destroy(void *object) {
+        static_cast<T *>(object)->~T();
+    }
+
+    void *allocate(size_t size, size_t alignment) {
+        static_assert( alignof(std::max_align_t) >= alignof(Destructor) );
+
+        size_t padding = -reinterpret_cast<uintptr_t>(current) & (alignment-1);
+        if( padding+size > remaining ) {
+            // Objects too big to share a chunk get one of their own, and leave the current one in use
+            size_t chunkSize = std::max( size, ChunkSize );
+            std::unique_ptr<std::max_align_t[]> chunk(
+                    new std::max_align_t[ (chunkSize + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t) ] );
+            char *memory = reinterpret_cast<char *>( chunk.get() );
+            chunks.emplace_back( std::move(chunk) );
+
+            allocated += size;
+            if( chunkSize>ChunkSize )
+                return memory;
+
+            current = memory;
+            remaining = chunkSize;
+            padding = 0;
+        } else {
+            allocated += padding + size;
+        }
+
+        void *ret = current + padding;
+        current += padding + size;
+        remaining -= padding + size;
+
+        return ret;
+    }
+};
+
+#endif // ARENA_H
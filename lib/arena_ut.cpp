@@ -0,0 +1,100 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "arena.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+#include <vector>
+
+class ArenaTest : public CppUnit::TestFixture  {
+    struct Tracked {
+        std::vector<int> &log;
+        int id;
+
+        Tracked( std::vector<int> &log, int id ) : log(log), id(id) {}
+        ~Tracked() {
+            log.push_back(id);
+        }
+    };
+
+    void destruction() {
+        std::vector<int> log;
+
+        {
+            Arena arena;
+            auto first = arena.make<Tracked>( log, 1 );
+            auto second = arena.make<Tracked>( log, 2 );
+            CPPUNIT_ASSERT( first->id==1 );
+            CPPUNIT_ASSERT( second->id==2 );
+
+            // Releasing a pointer does not destroy the object
+            first.reset();
+            CPPUNIT_ASSERT( log.empty() );
+
+            arena.clear();
+            CPPUNIT_ASSERT( log==std::vector<int>({ 2, 1 }) );
+            CPPUNIT_ASSERT( arena.bytesAllocated()==0 );
+
+            arena.make<Tracked>( log, 3 );
+        }
+
+        CPPUNIT_ASSERT( log==std::vector<int>({ 2, 1, 3 }) );
+    }
+
+    void alignment() {
+        Arena arena;
+
+        for( size_t i=0; i<3*Arena::ChunkSize; ++i ) {
+            auto c = arena.make<char>( 'a' );
+            auto d = arena.make<double>( 1.5 );
+            auto s = arena.make<std::string>( "Strings are not trivially destructible" );
+
+            CPPUNIT_ASSERT( reinterpret_cast<uintptr_t>( d.get() ) % alignof(double) == 0 );
+            CPPUNIT_ASSERT( reinterpret_cast<uintptr_t>( s.get() ) % alignof(std::string) == 0 );
+            CPPUNIT_ASSERT( *c=='a' && *d==1.5 );
+        }
+
+        CPPUNIT_ASSERT( arena.bytesAllocated() > 3*Arena::ChunkSize );
+    }
+
+    void bigObjects() {
+        struct Big {
+            char buffer[ 2*Arena::ChunkSize ];
+        };
+
+        Arena arena;
+        auto small1 = arena.make<int>( 1 );
+        auto big = arena.make<Big>();
+        auto small2 = arena.make<int>( 2 );
+
+        big->buffer[ sizeof(Big::buffer)-1 ] = 'x';
+        // The big object got a chunk of its own, and did not waste what was left of the current one
+        CPPUNIT_ASSERT( small2.get()==small1.get()+1 );
+        CPPUNIT_ASSERT( *small1==1 && *small2==2 );
+    }
+
+public:
+    static CppUnit::Test *suite()
+    {
+        CppUnit::TestSuite *suiteOfTests = new CppUnit::TestSuite( "ArenaTest" );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ArenaTest>(
+                    "destruction",
+                    &ArenaTest::destruction ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ArenaTest>(
+                    "alignment",
+                    &ArenaTest::alignment ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ArenaTest>(
+                    "bigObjects",
+                    &ArenaTest::bigObjects ) );
+        return suiteOfTests;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ArenaTest );
@@ -13,9 +13,9 @@
 namespace AST {
 
 CompoundStatement::CompoundStatement(
-        const NonTerminals::CompoundStatement &parserCompound, const LookupContext &parentCtx ) :
+        NonTerminals::FlatTree::Cursor parserCompound, const LookupContext &parentCtx ) :
     lookupCtx( &parentCtx ),
-    statementList( parserCompound.statements )
+    statementList( parserCompound.child(0) )
 {}
 
 void CompoundStatement::buildAST() {
@@ -11,7 +11,7 @@
 
 #include "ast/statement_list.h"
 #include "lookup_context.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST {
 
@@ -20,7 +20,7 @@ class CompoundStatement {
     StatementList statementList;
 
 public:
-    explicit CompoundStatement( const NonTerminals::CompoundStatement &parserCompound, const LookupContext &parentCtx );
+    explicit CompoundStatement( NonTerminals::FlatTree::Cursor parserCompound, const LookupContext &parentCtx );
     void buildAST();
     void codeGen( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
 };
@@ -12,14 +12,19 @@
 
 namespace AST {
 
-ConditionalStatement::ConditionalStatement( const NonTerminals::Statement::ConditionalStatement &parserCondition ) :
-    condition( parserCondition.condition )
+ConditionalStatement::ConditionalStatement( NonTerminals::FlatTree::Cursor parserCondition ) :
+    condition( parserCondition.child(0) )
 {
-    ASSERT( parserCondition.ifClause );
-    ifClause = safenew<Statement>( *parserCondition.ifClause );
+    auto clauses = parserCondition.children();
+    auto clause = clauses.begin();
 
-    if( parserCondition.elseClause ) {
-        elseClause = safenew<Statement>( *parserCondition.elseClause );
+    ++clause;
+    ASSERT( clause!=clauses.end() );
+    ifClause = safenew<Statement>( *clause );
+
+    ++clause;
+    if( clause!=clauses.end() ) {
+        elseClause = safenew<Statement>( *clause );
     }
 }
 
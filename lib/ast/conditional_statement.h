@@ -11,7 +11,7 @@
 
 #include "expression.h"
 #include "lookup_context.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST {
 
@@ -22,7 +22,7 @@ class ConditionalStatement {
     std::unique_ptr<Statement> ifClause, elseClause;
 
 public:
-    explicit ConditionalStatement( const NonTerminals::Statement::ConditionalStatement &parserCondition );
+    explicit ConditionalStatement( NonTerminals::FlatTree::Cursor parserCondition );
 
     void buildAST( LookupContext &lookupCtx );
     void codeGen( const LookupContext &lookupCtx, PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
@@ -21,7 +21,7 @@ using namespace PracticalSemanticAnalyzer;
 
 namespace AST {
 
-Expression::Expression( const NonTerminals::Expression &parserExpression ) :
+Expression::Expression( NonTerminals::FlatTree::Cursor parserExpression ) :
     parserExpression( parserExpression )
 {
 }
@@ -34,80 +34,46 @@ SourceLocation Expression::getLocation() const {
 void Expression::buildASTImpl(
         LookupContext &lookupContext, ExpectedResult expectedResult, Weight &weight, Weight weightLimit )
 {
-    struct Visitor {
-        Expression *_this;
-        LookupContext &lookupContext;
-        ExpectedResult expectedResult;
-        Weight &weight;
-        const Weight weightLimit;
-
-        void operator()( const std::unique_ptr<NonTerminals::CompoundExpression> &parserExpression ) {
-            auto expression = safenew<ExpressionImpl::CompoundExpression>( *parserExpression, lookupContext );
-
-            expression->buildAST( lookupContext, expectedResult, weight, weightLimit );
-            _this->actualExpression = std::move(expression);
-        }
-
-        void operator()( const NonTerminals::Literal &parserLiteral ) {
-            auto literal = safenew<ExpressionImpl::Literal>( parserLiteral );
-
-            literal->buildAST( lookupContext, expectedResult, weight, weightLimit );
-            _this->actualExpression = std::move(literal);
-        }
-
-        void operator()( const NonTerminals::Identifier &parserIdentifier ) {
-            auto identifier = safenew<ExpressionImpl::Identifier>( parserIdentifier );
-
-            identifier->buildAST( lookupContext, expectedResult, weight, weightLimit );
-            _this->actualExpression = std::move(identifier);
-        }
-
-        void operator()( const NonTerminals::Expression::UnaryOperator &op ) {
-            auto unaryOp = safenew<ExpressionImpl::UnaryOp>(op);
-
-            unaryOp->buildAST( lookupContext, expectedResult, weight, weightLimit );
-            _this->actualExpression = std::move(unaryOp);
-        }
-
-        void operator()( const NonTerminals::Expression::BinaryOperator &op ) {
-            auto binaryOp = safenew<ExpressionImpl::BinaryOp>(op);
-
-            binaryOp->buildAST( lookupContext, expectedResult, weight, weightLimit );
-            _this->actualExpression = std::move(binaryOp);
-        }
-
-        void operator()( const NonTerminals::Expression::CastOperator &cast ) {
-            auto castOp = safenew<ExpressionImpl::CastOp>(cast);
-
-            castOp->buildAST( lookupContext, expectedResult, weight, weightLimit );
-            _this->actualExpression = std::move(castOp);
-        }
-
-        void operator()( const NonTerminals::Expression::FunctionCall &parserFuncCall ) {
-            auto functionCall = safenew<ExpressionImpl::FunctionCall>( parserFuncCall );
-
-            functionCall->buildAST( lookupContext, expectedResult, weight, weightLimit );
-            _this->actualExpression = std::move(functionCall);
-        }
-
-        void operator()( const std::unique_ptr<NonTerminals::ConditionalExpression> &parserCondition ) {
-            auto condition = safenew<ExpressionImpl::ConditionalExpression>( *parserCondition );
-
-            condition->buildAST( lookupContext, expectedResult, weight, weightLimit );
-            _this->actualExpression = std::move(condition);
-        }
-
-        void operator()( const NonTerminals::Type &type ) {
-            ABORT()<<"TODO implement";
-        }
-    };
-
-    std::visit(
-            Visitor{
-                ._this = this, .lookupContext = lookupContext, .expectedResult = expectedResult,
-                .weight = weight, .weightLimit = weightLimit
-            },
-            parserExpression.value );
+    using Kind = NonTerminals::FlatTree::Kind;
+
+    switch( parserExpression.kind() ) {
+    case Kind::CompoundExpression:
+        actualExpression = safenew<ExpressionImpl::CompoundExpression>( parserExpression, lookupContext );
+        break;
+    case Kind::LiteralInt:
+    case Kind::LiteralBool:
+    case Kind::LiteralPointer:
+    case Kind::LiteralString:
+        actualExpression = safenew<ExpressionImpl::Literal>( parserExpression );
+        break;
+    case Kind::Identifier:
+        actualExpression = safenew<ExpressionImpl::Identifier>( parserExpression );
+        break;
+    case Kind::UnaryOperator:
+        actualExpression = safenew<ExpressionImpl::UnaryOp>( parserExpression );
+        break;
+    case Kind::BinaryOperator:
+        actualExpression = safenew<ExpressionImpl::BinaryOp>( parserExpression );
+        break;
+    case Kind::CastOperator:
+        actualExpression = safenew<ExpressionImpl::CastOp>( parserExpression );
+        break;
+    case Kind::FunctionCall:
+        actualExpression = safenew<ExpressionImpl::FunctionCall>( parserExpression );
+        break;
+    case Kind::ConditionalExpression:
+        actualExpression = safenew<ExpressionImpl::ConditionalExpression>( parserExpression );
+        break;
+    case Kind::TypeIdentifier:
+    case Kind::TypeArray:
+    case Kind::TypePointer:
+        ABORT()<<"TODO implement";
+        break;
+    default:
+        ABORT()<<"Parse tree node is not an expression";
+    }
+
+    actualExpression->buildAST( lookupContext, expectedResult, weight, weightLimit );
 
     metadata.type = actualExpression->getType();
     metadata.valueRange = actualExpression->getValueRange();
@@ -11,7 +11,7 @@
 
 #include "ast/expected_result.h"
 #include "ast/expression/base.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 #include "ast/lookup_context.h"
 
@@ -20,11 +20,11 @@
 namespace AST {
 
 class Expression final : public ExpressionImpl::Base {
-    const NonTerminals::Expression &parserExpression;
+    NonTerminals::FlatTree::Cursor parserExpression;
     std::unique_ptr< ExpressionImpl::Base > actualExpression;
 
 public:
-    explicit Expression( const NonTerminals::Expression &parserExpression );
+    explicit Expression( NonTerminals::FlatTree::Cursor parserExpression );
 
     template<typename T>
     const T *tryGetActualExpression() const {
@@ -19,7 +19,7 @@ namespace AST::ExpressionImpl {
 
 using namespace PracticalSemanticAnalyzer;
 
-AddressOf::AddressOf( const NonTerminals::Expression &parserOperand ) :
+AddressOf::AddressOf( NonTerminals::FlatTree::Cursor parserOperand ) :
     operand( parserOperand )
 {}
 
@@ -17,7 +17,7 @@ class AddressOf {
     Expression operand;
 
 public:
-    explicit AddressOf( const NonTerminals::Expression &parserOperand );
+    explicit AddressOf( NonTerminals::FlatTree::Cursor parserOperand );
 
     void buildASTImpl(
             LookupContext &lookupContext, ExpectedResult expectedResult, ExpressionMetadata &metadata,
@@ -18,6 +18,7 @@ namespace AST::ExpressionImpl {
 
 // Non member private helpers
 static std::unordered_map< Tokenizer::Tokens, std::string > operatorNames;
+static std::unordered_map< Tokenizer::Tokens, Tokenizer::SymbolId > operatorSymbols;
 
 static void defineMatchingPairs(
         LookupContext::Function::Definition::CodeGenProto *codeGenerator,
@@ -50,8 +51,8 @@ static void defineMatchingPairs(
     }
 }
 
-static String opToFuncName( Tokenizer::Tokens token ) {
-    return operatorNames.at(token);
+static Tokenizer::SymbolId opToSymbol( Tokenizer::Tokens token ) {
+    return operatorSymbols.at(token);
 }
 
 // Static methods
@@ -135,29 +136,31 @@ void BinaryOp::init(LookupContext &builtinCtx) {
 
     inserter = operatorNames.emplace( Tokenizer::Tokens::OP_SHIFT_LEFT, "__opShiftLeft" );
     inserter = operatorNames.emplace( Tokenizer::Tokens::OP_SHIFT_RIGHT, "__opShiftRight" );
+
+    for( const auto &name : operatorNames )
+        operatorSymbols.emplace( name.first, Tokenizer::Symbols::intern( name.second ) );
 }
 
-BinaryOp::BinaryOp( const NonTerminals::Expression::BinaryOperator &parserOp ) :
+BinaryOp::BinaryOp( NonTerminals::FlatTree::Cursor parserOp ) :
     parserOp(parserOp)
 {}
 
 SourceLocation BinaryOp::getLocation() const {
-    return parserOp.op->location;
+    return parserOp.token()->location;
 }
 
 // Protected methods
 void BinaryOp::buildASTImpl(
         LookupContext &lookupContext, ExpectedResult expectedResult, Weight &weight, Weight weightLimit )
 {
-    String baseName = opToFuncName( parserOp.op->token );
-    auto identifier = lookupContext.lookupIdentifier( baseName );
-    ASSERT( identifier )<<"Binary operator "<<parserOp.op->token<<" is not yet implemented by the compiler";
+    auto identifier = lookupContext.lookupIdentifier( opToSymbol( parserOp.token()->token ) );
+    ASSERT( identifier )<<"Binary operator "<<parserOp.token()->token<<" is not yet implemented by the compiler";
     const LookupContext::Function &function =
             std::get<LookupContext::Function>(*identifier);
 
     resolver.resolveOverloads(
             lookupContext, expectedResult, function.overloads, weight, weightLimit, metadata,
-            { parserOp.operands[0].get(), parserOp.operands[1].get() }, parserOp.op );
+            { parserOp.child(0), parserOp.child(1) }, parserOp.token() );
 }
 
 ExpressionId BinaryOp::codeGenImpl( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const {
@@ -11,18 +11,18 @@
 
 #include "ast/expression/overload_resolver.h"
 #include "ast/expression.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST::ExpressionImpl {
 
 class BinaryOp final : public Base {
-    const NonTerminals::Expression::BinaryOperator &parserOp;
+    NonTerminals::FlatTree::Cursor parserOp;
     OverloadResolver resolver;
 
 public:
     static void init(LookupContext &builtinCtx);
 
-    explicit BinaryOp( const NonTerminals::Expression::BinaryOperator &parserOp );
+    explicit BinaryOp( NonTerminals::FlatTree::Cursor parserOp );
 
     SourceLocation getLocation() const override;
 
@@ -10,23 +10,23 @@
 
 namespace AST::ExpressionImpl {
 
-CastOp::CastOp( const NonTerminals::Expression::CastOperator &parserCast ) :
+CastOp::CastOp( NonTerminals::FlatTree::Cursor parserCast ) :
     parserCast(parserCast),
-    expression(*parserCast.expression)
+    expression(parserCast.child(1))
 {
 }
 
 SourceLocation CastOp::getLocation() const {
-    return parserCast.op->location;
+    return parserCast.token()->location;
 }
 
 void CastOp::buildASTImpl(
         LookupContext &lookupContext, ExpectedResult expectedResult, Weight &weight, Weight weightLimit
     )
 {
-    metadata.type = lookupContext.lookupType( parserCast.destType );
+    metadata.type = lookupContext.lookupType( parserCast.child(0) );
 
-    switch( parserCast.op->token ) {
+    switch( parserCast.token()->token ) {
     case Tokenizer::Tokens::RESERVED_EXPECT:
         {
             // Just give the expression a mandatory expected type
@@ -35,7 +35,7 @@ void CastOp::buildASTImpl(
         }
         break;
     default:
-        ABORT()<<"Unidentified token "<<parserCast.op->token<<" passed as cast";
+        ABORT()<<"Unidentified token "<<parserCast.token()->token<<" passed as cast";
     }
 }
 
@@ -10,16 +10,16 @@
 #define AST_EXPRESSION_CAST_OP_H
 
 #include "ast/expression.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST::ExpressionImpl {
 
 class CastOp : public Base {
-    const NonTerminals::Expression::CastOperator &parserCast;
+    NonTerminals::FlatTree::Cursor parserCast;
     Expression expression;
 
 public:
-    explicit CastOp( const NonTerminals::Expression::CastOperator &parserCast );
+    explicit CastOp( NonTerminals::FlatTree::Cursor parserCast );
 
     SourceLocation getLocation() const override;
 
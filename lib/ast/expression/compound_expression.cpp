@@ -11,10 +11,10 @@
 namespace AST::ExpressionImpl {
 
 CompoundExpression::CompoundExpression(
-        const NonTerminals::CompoundExpression &parserExpression, const LookupContext &parentCtx ) :
+        NonTerminals::FlatTree::Cursor parserExpression, const LookupContext &parentCtx ) :
     lookupContext( &parentCtx ),
-    statements(parserExpression.statementList),
-    expression(parserExpression.expression)
+    statements(parserExpression.child(0)),
+    expression(parserExpression.child(1))
 {
 }
 
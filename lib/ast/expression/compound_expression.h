@@ -13,7 +13,7 @@
 #include "ast/expression.h"
 #include "ast/statement.h"
 #include "ast/statement_list.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST::ExpressionImpl {
 
@@ -23,7 +23,7 @@ class CompoundExpression final : public Base {
     Expression expression;
 
 public:
-    CompoundExpression( const NonTerminals::CompoundExpression &parserExpression, const LookupContext &parentCtx );
+    CompoundExpression( NonTerminals::FlatTree::Cursor parserExpression, const LookupContext &parentCtx );
 
     SourceLocation getLocation() const override;
 
@@ -11,10 +11,10 @@
 
 namespace AST::ExpressionImpl {
 
-ConditionalExpression::ConditionalExpression( const NonTerminals::ConditionalExpression &parserCondition ) :
-    condition(parserCondition.condition),
-    ifClause(parserCondition.ifClause),
-    elseClause(parserCondition.elseClause)
+ConditionalExpression::ConditionalExpression( NonTerminals::FlatTree::Cursor parserCondition ) :
+    condition(parserCondition.child(0)),
+    ifClause(parserCondition.child(1)),
+    elseClause(parserCondition.child(2))
 {}
 
 SourceLocation ConditionalExpression::getLocation() const {
@@ -18,7 +18,7 @@ class ConditionalExpression : public Base {
     Expression ifClause, elseClause;
 
 public:
-    explicit ConditionalExpression( const NonTerminals::ConditionalExpression &parserCondition );
+    explicit ConditionalExpression( NonTerminals::FlatTree::Cursor parserCondition );
 
     SourceLocation getLocation() const override;
 
@@ -15,7 +15,7 @@
 
 namespace AST::ExpressionImpl {
 
-Dereference::Dereference( const NonTerminals::Expression &parserOperand ) :
+Dereference::Dereference( NonTerminals::FlatTree::Cursor parserOperand ) :
     operand( parserOperand )
 {}
 
@@ -17,7 +17,7 @@ class Dereference {
     Expression operand;
 
 public:
-    explicit Dereference( const NonTerminals::Expression &parserOperand );
+    explicit Dereference( NonTerminals::FlatTree::Cursor parserOperand );
 
     void buildASTImpl(
             LookupContext &lookupContext, ExpectedResult expectedResult, ExpressionMetadata &metadata,
@@ -16,20 +16,20 @@ using namespace PracticalSemanticAnalyzer;
 
 namespace AST::ExpressionImpl {
 
-FunctionCall::FunctionCall( const NonTerminals::Expression::FunctionCall &parserFunctionCall ) :
+FunctionCall::FunctionCall( NonTerminals::FlatTree::Cursor parserFunctionCall ) :
     parserFunctionCall( parserFunctionCall )
 {
 }
 
 SourceLocation FunctionCall::getLocation() const {
-    return parserFunctionCall.op->location;
+    return parserFunctionCall.getLocation();
 }
 
 // protected methods
 void FunctionCall::buildASTImpl(
         LookupContext &lookupContext, ExpectedResult expectedResult, Weight &weight, Weight weightLimit )
 {
-    functionId.emplace( *parserFunctionCall.expression );
+    functionId.emplace( parserFunctionCall.child(0) );
     functionId->buildAST( lookupContext, ExpectedResult(), weight, weightLimit );
 
     const Identifier *identifier = functionId->tryGetActualExpression<Identifier>();
@@ -47,17 +47,21 @@ void FunctionCall::buildASTImpl(
         }
 
         void operator()( const LookupContext::Function &function ) {
-            size_t numArguments = _this->parserFunctionCall.arguments.arguments.size();
-            const NonTerminals::Expression *arguments[numArguments];
-
-            for( unsigned i=0; i<numArguments; ++i ) {
-                arguments[i] = &_this->parserFunctionCall.arguments.arguments[i];
+            // The first child is the function itself
+            size_t numArguments = _this->parserFunctionCall.numChildren() - 1;
+            NonTerminals::FlatTree::Cursor arguments[numArguments];
+
+            unsigned i=0;
+            for( auto argument : _this->parserFunctionCall.children() ) {
+                if( i>0 )
+                    arguments[i-1] = argument;
+                ++i;
             }
 
             _this->resolver.resolveOverloads(
                     lookupContext, expectedResult, function.overloads,
                     weight, weightLimit,
-                    _this->metadata, Slice(arguments, numArguments), _this->parserFunctionCall.op );
+                    _this->metadata, Slice(arguments, numArguments), _this->parserFunctionCall.token() );
             _this->metadata.type = downCast( _this->resolver.getType().getReturnType() );
             _this->metadata.valueRange = _this->metadata.type->defaultRange();
         }
@@ -12,17 +12,17 @@
 #include "ast/expression/base.h"
 #include "ast/expression/overload_resolver.h"
 #include "ast/expression.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST::ExpressionImpl {
 
 class FunctionCall : public Base {
-    const NonTerminals::Expression::FunctionCall &parserFunctionCall;
+    NonTerminals::FlatTree::Cursor parserFunctionCall;
     std::optional<Expression> functionId;
     OverloadResolver resolver;
 
 public:
-    explicit FunctionCall( const NonTerminals::Expression::FunctionCall &parserFunctionCall );
+    explicit FunctionCall( NonTerminals::FlatTree::Cursor parserFunctionCall );
 
     SourceLocation getLocation() const override;
 
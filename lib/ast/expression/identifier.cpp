@@ -15,27 +15,27 @@ using namespace PracticalSemanticAnalyzer;
 
 namespace AST::ExpressionImpl {
 
-Identifier::Identifier( const NonTerminals::Identifier &parserIdentifier ) :
+Identifier::Identifier( NonTerminals::FlatTree::Cursor parserIdentifier ) :
     parserIdentifier( parserIdentifier )
 {
 }
 
 String Identifier::getName() const {
-    return parserIdentifier.identifier->text;
+    return parserIdentifier.token()->text;
 }
 
 SourceLocation Identifier::getLocation() const {
-    return parserIdentifier.identifier->location;
+    return parserIdentifier.token()->location;
 }
 
 void Identifier::buildASTImpl(
         LookupContext &lookupContext, ExpectedResult expectedResult, Weight &weight, Weight weightLimit )
 {
-    identifier = lookupContext.lookupIdentifier( parserIdentifier.identifier->text );
+    identifier = lookupContext.lookupIdentifier( parserIdentifier.token()->symbol );
 
     if( identifier==nullptr ) {
         throw SymbolNotFound(
-                parserIdentifier.identifier->text, parserIdentifier.identifier->location );
+                parserIdentifier.token()->text, parserIdentifier.token()->location );
     }
 
     struct Visitor {
@@ -10,16 +10,16 @@
 #define AST_EXPRESSION_IDENTIFIER_H
 
 #include "ast/expression/base.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST::ExpressionImpl {
 
 class Identifier : public Base {
-    const NonTerminals::Identifier &parserIdentifier;
+    NonTerminals::FlatTree::Cursor parserIdentifier;
     const LookupContext::Identifier *identifier = nullptr;
 
 public:
-    explicit Identifier( const NonTerminals::Identifier &parserIdentifier );
+    explicit Identifier( NonTerminals::FlatTree::Cursor parserIdentifier );
 
     String getName() const;
 
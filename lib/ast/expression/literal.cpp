@@ -20,7 +20,7 @@ using namespace PracticalSemanticAnalyzer;
 
 namespace AST::ExpressionImpl {
 
-Literal::Literal( const NonTerminals::Literal &parserLiteral ) :
+Literal::Literal( NonTerminals::FlatTree::Cursor parserLiteral ) :
     parserLiteral( parserLiteral )
 {
 }
@@ -32,83 +32,59 @@ SourceLocation Literal::getLocation() const {
 void Literal::buildASTImpl(
         LookupContext &lookupContext, ExpectedResult expectedResult, Weight &weight, Weight weightLimit )
 {
-    struct Visitor {
-        Literal &_this;
-        Weight &weight;
-        Weight weightLimit;
-        const ExpectedResult &expectedResult;
-
-        void operator()( const NonTerminals::LiteralInt &literal ) {
-            _this.buildAstInt( literal, weight, weightLimit, expectedResult );
-        }
-
-        void operator()( const NonTerminals::LiteralBool &literal ) {
-            _this.buildAstBool( literal, weight, weightLimit, expectedResult );
-        }
-
-        void operator()( const NonTerminals::LiteralPointer &literal ) {
-            _this.buildAstPointer( literal, weight, weightLimit, expectedResult );
-        }
-
-        void operator()( const NonTerminals::LiteralString &literal ) {
-            _this.buildAstString( literal, weight, weightLimit, expectedResult );
-        }
-    };
-
-    std::visit(
-            Visitor{
-                ._this = *this, .weight = weight, .weightLimit = weightLimit,
-                .expectedResult = expectedResult
-            },
-            parserLiteral.literal );
+    switch( parserLiteral.kind() ) {
+    case NonTerminals::FlatTree::Kind::LiteralInt:
+        buildAstInt( weight, weightLimit, expectedResult );
+        break;
+    case NonTerminals::FlatTree::Kind::LiteralBool:
+        buildAstBool( weight, weightLimit, expectedResult );
+        break;
+    case NonTerminals::FlatTree::Kind::LiteralPointer:
+        buildAstPointer( weight, weightLimit, expectedResult );
+        break;
+    case NonTerminals::FlatTree::Kind::LiteralString:
+        buildAstString( weight, weightLimit, expectedResult );
+        break;
+    default:
+        ABORT()<<"Parse tree node is not a literal";
+    }
 }
 
 ExpressionId Literal::codeGenImpl( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const {
-    struct Visitor {
-        const Literal &_this;
-        PracticalSemanticAnalyzer::FunctionGen *functionGen;
-
-        ExpressionId operator()( const NonTerminals::LiteralInt &literal ) {
-            return _this.codeGenInt( literal, functionGen );
-        }
-
-        ExpressionId operator()( const NonTerminals::LiteralBool &literal ) {
-            return _this.codeGenBool( literal, functionGen );
-        }
-
-        ExpressionId operator()( const NonTerminals::LiteralPointer &literal ) {
-            return _this.codeGenPointer( literal, functionGen );
-        }
-
-        ExpressionId operator()( const NonTerminals::LiteralString &literal ) {
-            return _this.codeGenString( literal, functionGen );
-        }
-    };
-
-    return std::visit( Visitor{ ._this = *this, .functionGen = functionGen }, parserLiteral.literal );
+    switch( parserLiteral.kind() ) {
+    case NonTerminals::FlatTree::Kind::LiteralInt:
+        return codeGenInt( functionGen );
+    case NonTerminals::FlatTree::Kind::LiteralBool:
+        return codeGenBool( functionGen );
+    case NonTerminals::FlatTree::Kind::LiteralPointer:
+        return codeGenPointer( functionGen );
+    case NonTerminals::FlatTree::Kind::LiteralString:
+        return codeGenString( functionGen );
+    default:
+        ABORT()<<"Parse tree node is not a literal";
+    }
 }
 
 // Private
-void Literal::buildAstInt(
-        const NonTerminals::LiteralInt &literal, Weight &weight, Weight weightLimit,
-        ExpectedResult expectedResult )
+void Literal::buildAstInt( Weight &weight, Weight weightLimit, ExpectedResult expectedResult )
 {
     ASSERT( !metadata.type )<<"Cannot reuse AST nodes";
+    LongEnoughInt value = parserLiteral.intValue();
 
     StaticTypeImpl::CPtr naturalType;
-    if( literal.value>std::numeric_limits<uint32_t>::max() ) {
-        ASSERT( literal.value<=std::numeric_limits<uint64_t>::max() );
+    if( value>std::numeric_limits<uint32_t>::max() ) {
+        ASSERT( value<=std::numeric_limits<uint64_t>::max() );
         naturalType = AST::getBuiltinCtx().lookupType("U64");
-    } else if( literal.value>std::numeric_limits<uint16_t>::max() ) {
+    } else if( value>std::numeric_limits<uint16_t>::max() ) {
         naturalType = AST::getBuiltinCtx().lookupType("U32");
-    } else if( literal.value>std::numeric_limits<uint8_t>::max() ) {
+    } else if( value>std::numeric_limits<uint8_t>::max() ) {
         naturalType = AST::getBuiltinCtx().lookupType("U16");
     } else {
         naturalType = AST::getBuiltinCtx().lookupType("U8");
     }
     ASSERT( naturalType );
 
-    metadata.valueRange = UnsignedIntValueRange::allocate( literal.value, literal.value );
+    metadata.valueRange = UnsignedIntValueRange::allocate( value, value );
 
     if( !expectedResult ) {
         static const StaticTypeImpl::CPtr DefaultLiteralIntType =
@@ -130,9 +106,9 @@ void Literal::buildAstInt(
         if( (*expectedScalar)->getType() == StaticType::Scalar::Type::SignedInt ) {
             LongEnoughInt limit=1;
             limit <<= (*expectedScalar)->getSize()-1;
-            if( literal.value<limit ) {
+            if( value<limit ) {
                 metadata.type = expectedResult.getType();
-                metadata.valueRange = SignedIntValueRange::allocate( literal.value, literal.value );
+                metadata.valueRange = SignedIntValueRange::allocate( value, value );
 
                 weight += Weight( (*expectedScalar)->getLiteralWeight(), 0 );
 
@@ -150,7 +126,7 @@ void Literal::buildAstInt(
             LongEnoughInt limit=1;
             limit <<= (*expectedScalar)->getSize();
 
-            if( literal.value < limit ) {
+            if( value < limit ) {
                 weight += Weight( (*expectedScalar)->getLiteralWeight(), 0 );
                 metadata.type = expectedResult.getType();
                 return;
@@ -168,73 +144,61 @@ void Literal::buildAstInt(
     weight += Weight( std::get< const StaticType::Scalar *>( naturalType->getType() )->getLiteralWeight() );
 }
 
-void Literal::buildAstBool(
-        const NonTerminals::LiteralBool &literal, Weight &weight, Weight weightLimit,
-        ExpectedResult expectedResult )
+void Literal::buildAstBool( Weight &weight, Weight weightLimit, ExpectedResult expectedResult )
 {
     metadata.type = AST::getBuiltinCtx().lookupType("Bool");
-    metadata.valueRange = BoolValueRange::allocate( literal.value==false, literal.value==true );
+    bool value = parserLiteral.boolValue();
+    metadata.valueRange = BoolValueRange::allocate( value==false, value==true );
 }
 
-void Literal::buildAstPointer(
-        const NonTerminals::LiteralPointer &literal, Weight &weight, Weight weightLimit,
-        ExpectedResult expectedResult )
+void Literal::buildAstPointer( Weight &weight, Weight weightLimit, ExpectedResult expectedResult )
 {
     if( ! expectedResult )
-        throw PointerExpected( nullptr, literal.token->location );
+        throw PointerExpected( nullptr, getLocation() );
 
     auto expectedType = expectedResult.getType();
     auto expectedTypeType = expectedType->getType();
     auto pointedType = std::get_if<const StaticType::Pointer *>(&expectedTypeType);
     if( pointedType == nullptr )
-        throw PointerExpected( expectedType, literal.token->location );
+        throw PointerExpected( expectedType, getLocation() );
 
     metadata.type = expectedType;
     metadata.valueRange = new PointerValueRange( nullptr );
 }
 
-void Literal::buildAstString(
-        const NonTerminals::LiteralString &literal, Weight &weight, Weight weightLimit,
-        ExpectedResult expectedResult )
+void Literal::buildAstString( Weight &weight, Weight weightLimit, ExpectedResult expectedResult )
 {
     auto c8Type = AST::getBuiltinCtx().lookupType("C8");
     metadata.type = StaticTypeImpl::allocate( PointerTypeImpl( c8Type ) );
     metadata.valueRange = new PointerValueRange( c8Type->defaultRange() );
 }
 
-ExpressionId Literal::codeGenInt(
-        const NonTerminals::LiteralInt &literal, PracticalSemanticAnalyzer::FunctionGen *functionGen ) const
+ExpressionId Literal::codeGenInt( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const
 {
     ExpressionId id = allocateId();
 
-    functionGen->setLiteral( id, literal.value, metadata.type );
+    functionGen->setLiteral( id, parserLiteral.intValue(), metadata.type );
 
     return id;
 }
 
-ExpressionId Literal::codeGenBool(
-        const NonTerminals::LiteralBool &literal,
-        PracticalSemanticAnalyzer::FunctionGen *functionGen ) const
+ExpressionId Literal::codeGenBool( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const
 {
     ExpressionId id = allocateId();
-    functionGen->setLiteral( id, literal.value );
+    functionGen->setLiteral( id, parserLiteral.boolValue() );
 
     return id;
 }
 
-ExpressionId Literal::codeGenString(
-        const NonTerminals::LiteralString &literal,
-        PracticalSemanticAnalyzer::FunctionGen *functionGen ) const
+ExpressionId Literal::codeGenString( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const
 {
     ExpressionId id = allocateId();
-    functionGen->setLiteral( id, literal.value + '\0' );
+    functionGen->setLiteral( id, parserLiteral.stringValue() + '\0' );
 
     return id;
 }
 
-ExpressionId Literal::codeGenPointer(
-        const NonTerminals::LiteralPointer &literal,
-        PracticalSemanticAnalyzer::FunctionGen *functionGen ) const
+ExpressionId Literal::codeGenPointer( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const
 {
     ExpressionId id = allocateId();
 
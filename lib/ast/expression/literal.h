@@ -10,16 +10,16 @@
 #define AST_EXPRESSION_LITERAL_H
 
 #include "ast/expression/base.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST::ExpressionImpl {
 
 class Literal final : public Base {
     // Members
-    const NonTerminals::Literal &parserLiteral;
+    NonTerminals::FlatTree::Cursor parserLiteral;
 
 public:
-    explicit Literal( const NonTerminals::Literal &parserLiteral );
+    explicit Literal( NonTerminals::FlatTree::Cursor parserLiteral );
 
     SourceLocation getLocation() const override;
 
@@ -30,31 +30,15 @@ protected:
     ExpressionId codeGenImpl( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const override;
 
 private:
-    void buildAstInt(
-            const NonTerminals::LiteralInt &literal, Weight &weight, Weight weightLimit,
-            ExpectedResult expectedResult );
-    void buildAstBool(
-            const NonTerminals::LiteralBool &literal, Weight &weight, Weight weightLimit,
-            ExpectedResult expectedResult );
-    void buildAstPointer(
-            const NonTerminals::LiteralPointer &literal, Weight &weight, Weight weightLimit,
-            ExpectedResult expectedResult );
-    void buildAstString(
-            const NonTerminals::LiteralString &literal, Weight &weight, Weight weightLimit,
-            ExpectedResult expectedResult );
-
-    ExpressionId codeGenInt(
-            const NonTerminals::LiteralInt &literal,
-            PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
-    ExpressionId codeGenBool(
-            const NonTerminals::LiteralBool &literal,
-            PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
-    ExpressionId codeGenString(
-            const NonTerminals::LiteralString &literal,
-            PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
-    ExpressionId codeGenPointer(
-            const NonTerminals::LiteralPointer &literal,
-            PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
+    void buildAstInt( Weight &weight, Weight weightLimit, ExpectedResult expectedResult );
+    void buildAstBool( Weight &weight, Weight weightLimit, ExpectedResult expectedResult );
+    void buildAstPointer( Weight &weight, Weight weightLimit, ExpectedResult expectedResult );
+    void buildAstString( Weight &weight, Weight weightLimit, ExpectedResult expectedResult );
+
+    ExpressionId codeGenInt( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
+    ExpressionId codeGenBool( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
+    ExpressionId codeGenString( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
+    ExpressionId codeGenPointer( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
 };
 
 } // namespace AST::ExpressionImpl
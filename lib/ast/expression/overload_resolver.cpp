@@ -21,7 +21,7 @@ void OverloadResolver::resolveOverloads(
         Weight &weight,
         Weight weightLimit,
         ExpressionMetadata &metadata,
-        Slice<const NonTerminals::Expression *const> parserArguments,
+        Slice<const NonTerminals::FlatTree::Cursor> parserArguments,
         const Tokenizer::Token *sourceLocation
     )
 {
@@ -54,7 +54,7 @@ void OverloadResolver::buildActualCall(
             LookupContext &lookupContext, Weight &weight, Weight weightLimit,
             const LookupContext::Function::Definition *definition,
             ExpressionMetadata &metadata,
-            Slice<const NonTerminals::Expression *const> parserArguments )
+            Slice<const NonTerminals::FlatTree::Cursor> parserArguments )
 {
     auto functionType = std::get<const StaticType::Function *>( definition->type->getType() );
     size_t numArguments = functionType->getNumArguments();
@@ -63,7 +63,7 @@ void OverloadResolver::buildActualCall(
     arguments.reserve( numArguments );
 
     for( unsigned argumentNum=0; argumentNum<numArguments; ++argumentNum ) {
-        Expression &argument = arguments.emplace_back( *parserArguments[argumentNum] );
+        Expression &argument = arguments.emplace_back( parserArguments[argumentNum] );
         Weight additionalWeight;
         argument.buildAST(
                 lookupContext, ExpectedResult( functionType->getArgumentType(argumentNum) ),
@@ -96,7 +96,7 @@ void OverloadResolver::resolveOverloadsByReturn(
         Weight &weight,
         Weight weightLimit,
         ExpressionMetadata &metadata,
-        Slice<const NonTerminals::Expression *const> parserArguments,
+        Slice<const NonTerminals::FlatTree::Cursor> parserArguments,
         const Tokenizer::Token *sourceLocation
     )
 {
@@ -159,7 +159,7 @@ void OverloadResolver::resolveOverloadsByArguments(
         Weight &weight,
         Weight weightLimit,
         ExpressionMetadata &metadata,
-        Slice<const NonTerminals::Expression *const> parserArguments,
+        Slice<const NonTerminals::FlatTree::Cursor> parserArguments,
         const Tokenizer::Token *sourceLocation
     )
 {
@@ -194,7 +194,7 @@ void OverloadResolver::findBestOverloadByArgument(
         Weight &weight,
         Weight weightLimit,
         ExpressionMetadata &metadata,
-        Slice<const NonTerminals::Expression *const> parserArguments,
+        Slice<const NonTerminals::FlatTree::Cursor> parserArguments,
         const Tokenizer::Token *sourceLocation
     )
 {
@@ -12,6 +12,7 @@
 #include "ast/expression/base.h"
 #include "ast/expected_result.h"
 #include "ast/lookup_context.h"
+#include "parser/flat_tree.h"
 
 namespace AST::ExpressionImpl {
 
@@ -27,7 +28,7 @@ public:
             Weight &weight,
             Weight weightLimit,
             ExpressionMetadata &metadata,
-            Slice<const NonTerminals::Expression *const> parserArguments,
+            Slice<const NonTerminals::FlatTree::Cursor> parserArguments,
             const Tokenizer::Token *sourceLocation
         );
 
@@ -40,7 +41,7 @@ private:
             LookupContext &lookupContext, Weight &weight, Weight weightLimit,
             const LookupContext::Function::Definition *definition,
             ExpressionMetadata &metadata,
-            Slice<const NonTerminals::Expression *const> parserArguments );
+            Slice<const NonTerminals::FlatTree::Cursor> parserArguments );
 
     void resolveOverloadsByReturn(
             LookupContext &lookupContext,
@@ -49,7 +50,7 @@ private:
             Weight &weight,
             Weight weightLimit,
             ExpressionMetadata &metadata,
-            Slice<const NonTerminals::Expression *const> parserArguments,
+            Slice<const NonTerminals::FlatTree::Cursor> parserArguments,
             const Tokenizer::Token *sourceLocation
         );
     void resolveOverloadsByArguments(
@@ -58,7 +59,7 @@ private:
             Weight &weight,
             Weight weightLimit,
             ExpressionMetadata &metadata,
-            Slice<const NonTerminals::Expression *const> parserArguments,
+            Slice<const NonTerminals::FlatTree::Cursor> parserArguments,
             const Tokenizer::Token *sourceLocation
         );
     void findBestOverloadByArgument(
@@ -67,7 +68,7 @@ private:
             Weight &weight,
             Weight weightLimit,
             ExpressionMetadata &metadata,
-            Slice<const NonTerminals::Expression *const> parserArguments,
+            Slice<const NonTerminals::FlatTree::Cursor> parserArguments,
             const Tokenizer::Token *sourceLocation
         );
 };
@@ -16,9 +16,10 @@ namespace AST::ExpressionImpl {
 
 // Non member private helpers
 static std::unordered_map< Tokenizer::Tokens, std::string > operatorNames;
+static std::unordered_map< Tokenizer::Tokens, Tokenizer::SymbolId > operatorSymbols;
 
-static String opToFuncName( Tokenizer::Tokens token ) {
-    return operatorNames.at(token);
+static Tokenizer::SymbolId opToSymbol( Tokenizer::Tokens token ) {
+    return operatorSymbols.at(token);
 }
 
 // Static methods
@@ -47,14 +48,17 @@ void UnaryOp::init(LookupContext &builtinCtx) {
     inserter = operatorNames.emplace( Tokenizer::Tokens::OP_PLUS_PLUS, "__opPlusPlus" );
     inserter = operatorNames.emplace( Tokenizer::Tokens::OP_LOGIC_NOT, "__opNot" );
     builtinCtx.addBuiltinFunction( inserter.first->second, boolType, { boolType }, Operators::logicalNot, Operators::logicalNotVrp );
+
+    for( const auto &name : operatorNames )
+        operatorSymbols.emplace( name.first, Tokenizer::Symbols::intern( name.second ) );
 }
 
-UnaryOp::UnaryOp( const NonTerminals::Expression::UnaryOperator &parserOp ) :
+UnaryOp::UnaryOp( NonTerminals::FlatTree::Cursor parserOp ) :
     parserOp(parserOp)
 {}
 
 SourceLocation UnaryOp::getLocation() const {
-    return parserOp.op->location;
+    return parserOp.token()->location;
 }
 
 // Protected methods
@@ -64,15 +68,15 @@ void UnaryOp::buildASTImpl(
     bool defaultHandling = true;
 
     // The special cases
-    switch( parserOp.op->token ) {
+    switch( parserOp.token()->token ) {
     case Tokenizer::Tokens::OP_AMPERSAND:
         defaultHandling = false;
-        body.emplace<AddressOf>( *parserOp.operand ).
+        body.emplace<AddressOf>( parserOp.child(0) ).
                 buildASTImpl(lookupContext, expectedResult, metadata, weight, weightLimit);
         break;
     case Tokenizer::Tokens::OP_PTR:
         defaultHandling = false;
-        body.emplace<Dereference>( *parserOp.operand ).
+        body.emplace<Dereference>( parserOp.child(0) ).
                 buildASTImpl(lookupContext, expectedResult, metadata, weight, weightLimit);
         break;
     default:
@@ -88,14 +92,13 @@ void UnaryOp::buildASTFromTemplate(
         OverloadResolver &resolver, LookupContext &lookupContext, ExpectedResult expectedResult,
         Weight &weight, Weight weightLimit )
 {
-    String baseName = opToFuncName( parserOp.op->token );
-    auto identifier = lookupContext.lookupIdentifier( baseName );
-    ASSERT( identifier )<<"Unary operator "<<parserOp.op->token<<" is not yet implemented by the compiler";
+    auto identifier = lookupContext.lookupIdentifier( opToSymbol( parserOp.token()->token ) );
+    ASSERT( identifier )<<"Unary operator "<<parserOp.token()->token<<" is not yet implemented by the compiler";
     const LookupContext::Function &function =
             std::get<LookupContext::Function>(*identifier);
 
     resolver.resolveOverloads( lookupContext, expectedResult, function.overloads, weight, weightLimit, metadata,
-            { parserOp.operand.get() }, parserOp.op );
+            { parserOp.child(0) }, parserOp.token() );
 }
 
 ExpressionId UnaryOp::codeGenImpl( PracticalSemanticAnalyzer::FunctionGen *functionGen ) const {
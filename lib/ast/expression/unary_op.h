@@ -13,18 +13,18 @@
 #include "ast/expression/dereference.h"
 #include "ast/expression/overload_resolver.h"
 #include "ast/expression.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST::ExpressionImpl {
 
 class UnaryOp final : public Base {
-    const NonTerminals::Expression::UnaryOperator &parserOp;
+    NonTerminals::FlatTree::Cursor parserOp;
     std::variant<std::monostate, OverloadResolver, AddressOf, Dereference> body;
 
 public:
     static void init(LookupContext &builtinCtx);
 
-    explicit UnaryOp( const NonTerminals::Expression::UnaryOperator &parserOp );
+    explicit UnaryOp( NonTerminals::FlatTree::Cursor parserOp );
 
     SourceLocation getLocation() const override;
 
@@ -22,7 +22,8 @@ Function::Function( const NonTerminals::FuncDef &parserFunction, const LookupCon
     name( parserFunction.decl.name.identifier->text ),
     lookupCtx( &parentCtx )
 {
-    const LookupContext::Identifier *identifierDef = parentCtx.lookupIdentifier( name );
+    const LookupContext::Identifier *identifierDef =
+            parentCtx.lookupIdentifier( parserFunction.decl.name.identifier->symbol );
     ASSERT( identifierDef );
     const LookupContext::Function *funcDef = std::get_if<LookupContext::Function>( identifierDef );
     ASSERT( funcDef );
@@ -62,39 +63,35 @@ void Function::codeGen( std::shared_ptr<FunctionGen> functionGen ) {
             "",
             parserFunction.decl.name.identifier->location );
 
-    struct Visitor {
-        Function *_this;
-        FunctionGen *functionGen;
+    NonTerminals::FlatTree::Cursor root = parserFunction.getFlatBody().root();
 
-        void operator()( const std::monostate &mono ) {
-            ABORT()<<"Unreachable code reached";
-        }
-
-        void operator()( const NonTerminals::CompoundExpression &parserExpression ) {
-            _this->codeGen( parserExpression.statementList, functionGen );
+    switch( root.kind() ) {
+    case NonTerminals::FlatTree::Kind::CompoundExpression:
+        {
+            codeGen( root.child(0), functionGen.get() );
 
-            Expression expression( parserExpression.expression );
+            Expression expression( root.child(1) );
 
             Weight weight;
-            expression.buildAST( _this->lookupCtx, _this->getReturnType(), weight, Expression::NoWeightLimit );
+            expression.buildAST( lookupCtx, getReturnType(), weight, Expression::NoWeightLimit );
 
-            functionGen->returnValue( expression.codeGen( functionGen ) );
+            functionGen->returnValue( expression.codeGen( functionGen.get() ) );
         }
-
-        void operator()( const NonTerminals::CompoundStatement &parserStatement ) {
-            _this->codeGen( parserStatement.statements, functionGen );
-
-            functionGen->returnValue();
-        }
-    };
-
-    std::visit( Visitor{ ._this = this, .functionGen = functionGen.get() }, parserFunction.body );
+        break;
+    case NonTerminals::FlatTree::Kind::CompoundStatement:
+        codeGen( root.child(0), functionGen.get() );
+
+        functionGen->returnValue();
+        break;
+    default:
+        ABORT()<<"Unreachable code reached";
+    }
 
     functionGen->functionLeave();
 }
 
 void Function::codeGen(
-        const NonTerminals::StatementList &statementList, PracticalSemanticAnalyzer::FunctionGen *functionGen )
+        NonTerminals::FlatTree::Cursor statementList, PracticalSemanticAnalyzer::FunctionGen *functionGen )
 {
     StatementList sl( statementList );
 
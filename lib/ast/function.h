@@ -11,6 +11,7 @@
 
 #include "ast/lookup_context.h"
 #include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST {
 
@@ -27,7 +28,7 @@ public:
     explicit Function( const NonTerminals::FuncDef &parserFunction, const LookupContext &parentCtx );
 
     void codeGen( std::shared_ptr<PracticalSemanticAnalyzer::FunctionGen> functionGen );
-    void codeGen( const NonTerminals::StatementList &statementList, PracticalSemanticAnalyzer::FunctionGen *functionGen );
+    void codeGen( NonTerminals::FlatTree::Cursor statementList, PracticalSemanticAnalyzer::FunctionGen *functionGen );
 
     StaticTypeImpl::CPtr getReturnType() const;
 
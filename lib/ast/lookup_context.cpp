@@ -35,23 +35,20 @@ StaticTypeImpl::CPtr LookupContext::_genericFunctionType =
 ValueRangeBase::CPtr LookupContext::_genericFunctionRange =
     new PointerValueRange( nullptr, BoolValueRange(false, false) );
 
-StaticTypeImpl::CPtr LookupContext::lookupType( String name, const SourceLocation &location ) const {
-    auto iter = types.find( sliceToString(name) );
-
-    if( iter==types.end() ) {
-        if( parent )
-            return parent->lookupType(name, location);
-        else
-            throw SymbolNotFound( name, location );
+StaticTypeImpl::CPtr LookupContext::lookupType( const Tokenizer::Token &identifier ) const {
+    for( const LookupContext *ctx = this; ctx!=nullptr; ctx = ctx->parent ) {
+        auto iter = ctx->types.find( identifier.symbol );
+        if( iter!=ctx->types.end() )
+            return iter->second;
     }
 
-    return iter->second;
+    throw SymbolNotFound( identifier.text, identifier.location );
 }
 
 StaticTypeImpl::CPtr LookupContext::lookupType( String name ) const {
     ASSERT( ! parent )<<"Lookup type without location only valid on built-in context";
 
-    auto iter = types.find( sliceToString(name) );
+    auto iter = types.find( Tokenizer::Symbols::find(name) );
     ASSERT( iter != types.end() )<<"Lookup failed on built-in type "<<name;
 
     return iter->second;
@@ -67,7 +64,7 @@ StaticTypeImpl::CPtr LookupContext::lookupType( const NonTerminals::Type &type )
 
 
         StaticTypeImpl::CPtr operator()( const NonTerminals::Identifier &id ) {
-            return _this->lookupType( id.identifier->text, id.identifier->location );
+            return _this->lookupType( *id.identifier );
         }
 
         StaticTypeImpl::CPtr operator()( const NonTerminals::Type::Array &array )
@@ -94,6 +91,33 @@ StaticTypeImpl::CPtr LookupContext::lookupType( const NonTerminals::Type &type )
     return std::visit( Visitor( { ._this = this } ), type.type );
 }
 
+StaticTypeImpl::CPtr LookupContext::lookupType( NonTerminals::FlatTree::Cursor type ) const {
+    switch( type.kind() ) {
+    case NonTerminals::FlatTree::Kind::TypeIdentifier:
+        return lookupType( *type.token() );
+    case NonTerminals::FlatTree::Kind::TypeArray:
+        {
+            auto ret = lookupType( type.child(0) );
+
+            if( !ret )
+                return StaticTypeImpl::CPtr();
+
+            return StaticTypeImpl::allocate( ArrayTypeImpl( std::move(ret), type.intValue() ) );
+        }
+    case NonTerminals::FlatTree::Kind::TypePointer:
+        {
+            auto ret = lookupType( type.child(0) );
+
+            if( !ret )
+                return StaticTypeImpl::CPtr();
+
+            return StaticTypeImpl::allocate( PointerTypeImpl( std::move(ret) ) );
+        }
+    default:
+        ABORT()<<"Parse tree node is not a type";
+    }
+}
+
 StaticTypeImpl::CPtr LookupContext::lookupType( const NonTerminals::TransientType &type ) const {
     auto ret = lookupType( type.type );
     if( type.ref )
@@ -105,9 +129,9 @@ StaticTypeImpl::CPtr LookupContext::lookupType( const NonTerminals::TransientTyp
 StaticTypeImpl::CPtr LookupContext::registerScalarType( ScalarTypeImpl &&type, ValueRangeBase::CPtr defaultValueRange ) {
     std::string name = sliceToString(type.getName());
     auto iter = types.emplace(
-            name,
+            Tokenizer::Symbols::intern(name),
             StaticTypeImpl::allocate( std::move(type), std::move(defaultValueRange) ) );
-    ASSERT( iter.second )<<"registerBuiltinType called on "<<iter.first->second<<" ("<<iter.first->first<<", "<<name<<") which is already registered";
+    ASSERT( iter.second )<<"registerBuiltinType called on "<<iter.first->second<<" ("<<name<<") which is already registered";
 
     return iter.first->second;
 }
@@ -116,14 +140,15 @@ void LookupContext::addBuiltinFunction(
         const std::string &name, StaticTypeImpl::CPtr returnType, Slice<const StaticTypeImpl::CPtr> argumentTypes,
         Function::Definition::CodeGenProto *codeGen, Function::Definition::VrpProto *calcVrp)
 {
-    auto iter = symbols.find( name );
+    Tokenizer::SymbolId symbol = Tokenizer::Symbols::intern( name );
+    auto iter = symbols.find( symbol );
 
     Function *function = nullptr;
     if( iter!=symbols.end() ) {
         function = std::get_if<Function>( &iter->second );
         ASSERT( function!=nullptr );
     } else {
-        auto inserter = symbols.emplace( name, Function{} );
+        auto inserter = symbols.emplace( symbol, Function{} );
         function = &std::get<Function>(inserter.first->second);
     }
 
@@ -165,7 +190,7 @@ void LookupContext::addFunctionDeclarationPass1( const Tokenizer::Token *token )
 }
 
 void LookupContext::addFunctionDefinitionPass1( const Tokenizer::Token *token ) {
-    auto iter = symbols.find( token->text );
+    auto iter = symbols.find( token->symbol );
 
     Function *function = nullptr;
     if( iter!=symbols.end() ) {
@@ -174,7 +199,7 @@ void LookupContext::addFunctionDefinitionPass1( const Tokenizer::Token *token )
             throw pass1_error( "Function is trying to overload a variable", token->location );
             // More info: where variable was first declared
     } else {
-        auto inserter = symbols.emplace( token->text, Function{} );
+        auto inserter = symbols.emplace( token->symbol, Function{} );
         function = &std::get<Function>(inserter.first->second);
     }
 
@@ -222,15 +247,21 @@ LookupContext::AbiType LookupContext::parseAbiString( String abiString, const So
 }
 
 const LookupContext::Identifier *LookupContext::lookupIdentifier( String name ) const {
-    auto iter = symbols.find(name);
-    if( iter==symbols.end() ) {
-        if( getParent()==nullptr )
-            return nullptr;
+    Tokenizer::SymbolId symbol = Tokenizer::Symbols::find(name);
+    if( symbol==Tokenizer::NoSymbol )
+        return nullptr;
+
+    return lookupIdentifier( symbol );
+}
 
-        return getParent()->lookupIdentifier( name );
+const LookupContext::Identifier *LookupContext::lookupIdentifier( Tokenizer::SymbolId symbol ) const {
+    for( const LookupContext *ctx = this; ctx!=nullptr; ctx = ctx->getParent() ) {
+        auto iter = ctx->symbols.find(symbol);
+        if( iter!=ctx->symbols.end() )
+            return &iter->second;
     }
 
-    return &iter->second;
+    return nullptr;
 }
 
 StaticTypeImpl::CPtr LookupContext::genericFunctionType() {
@@ -242,7 +273,7 @@ ValueRangeBase::CPtr LookupContext::genericFunctionRange() {
 }
 
 void LookupContext::addLocalVar( const Tokenizer::Token *token, StaticTypeImpl::CPtr type, ExpressionId lvalue ) {
-    auto iter = symbols.emplace( token->text, Variable(token, type, lvalue) );
+    auto iter = symbols.emplace( token->symbol, Variable(token, type, lvalue) );
 
     if( !iter.second ) {
         throw SymbolRedefined(token->text, token->location);
@@ -367,7 +398,7 @@ ExpressionId LookupContext::globalFunctionCall(
 LookupContext::Function::Definition &LookupContext::addFunctionPass2(
         const Tokenizer::Token *token, StaticTypeImpl::CPtr type, AbiType abi, bool isDefinition )
 {
-    auto iter = symbols.find( token->text );
+    auto iter = symbols.find( token->symbol );
     ASSERT( iter!=symbols.end() )<<"addFunctionPass2 called for "<<token->text<<" without 1st pass";
     Function *function = std::get_if<Function>( &iter->second );
     ASSERT( function!=nullptr );
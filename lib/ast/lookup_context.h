@@ -11,6 +11,7 @@
 
 #include "ast/static_type.h"
 #include "parser.h"
+#include "parser/flat_tree.h"
 #include "tokenizer.h"
 
 #include <practical/slice.h>
@@ -115,10 +116,10 @@ private:
     static StaticTypeImpl::CPtr _genericFunctionType;
     static ValueRangeBase::CPtr _genericFunctionRange;
 
-    std::unordered_map< std::string, StaticTypeImpl::CPtr > types;
+    std::unordered_map< Tokenizer::SymbolId, StaticTypeImpl::CPtr > types;
     const LookupContext *parent = nullptr;
 
-    std::unordered_map< String, Identifier > symbols;
+    std::unordered_map< Tokenizer::SymbolId, Identifier > symbols;
 
     std::unordered_map<
             PracticalSemanticAnalyzer::StaticType::CPtr,
@@ -140,10 +141,11 @@ public:
     }
 
 private:
-    StaticTypeImpl::CPtr lookupType( String name, const SourceLocation &location ) const;
+    StaticTypeImpl::CPtr lookupType( const Tokenizer::Token &identifier ) const;
 public:
     StaticTypeImpl::CPtr lookupType( String name ) const;
     StaticTypeImpl::CPtr lookupType( const NonTerminals::Type &type ) const;
+    StaticTypeImpl::CPtr lookupType( NonTerminals::FlatTree::Cursor type ) const;
     StaticTypeImpl::CPtr lookupType( const NonTerminals::TransientType &type ) const;
 
     StaticTypeImpl::CPtr registerScalarType( ScalarTypeImpl &&type, ValueRangeBase::CPtr defaultValueRange );
@@ -172,6 +174,7 @@ public:
     void addLocalVar( const Tokenizer::Token *token, StaticTypeImpl::CPtr type, ExpressionId lvalue );
 
     const Identifier *lookupIdentifier( String name ) const;
+    const Identifier *lookupIdentifier( Tokenizer::SymbolId symbol ) const;
 
     // Generic type and range to use for unspecified function
     static StaticTypeImpl::CPtr genericFunctionType();
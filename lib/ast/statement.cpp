@@ -13,13 +13,11 @@
 
 namespace AST {
 
-Statement::Statement( const NonTerminals::Statement &parserStatement ) : parserStatement(parserStatement)
+Statement::Statement( NonTerminals::FlatTree::Cursor parserStatement ) : parserStatement(parserStatement)
 {
 }
 
-Statement::Statement( const Statement &that ) :
-    parserStatement( *(const NonTerminals::Statement *)(1) )
-{
+Statement::Statement( const Statement &that ) {
     ABORT()<<"ASSERT FAILED: Statement copy constructor called";
 }
 
@@ -29,41 +27,39 @@ Statement::~Statement() {
 }
 
 void Statement::buildAST( LookupContext &lookupCtx ) {
-    struct Visitor {
-        Statement &_this;
-        LookupContext &lookupCtx;
-
-        void operator()( std::monostate mono ) {
-            ABORT()<<"Statement is in monostate";
-        }
-
-        void operator()( const NonTerminals::Expression &parserExpression ) {
-            auto &expression = _this.underlyingStatement.emplace<Expression>(parserExpression);
-            Weight weight;
-            expression.buildAST(lookupCtx, ExpectedResult(), weight, Expression::NoWeightLimit);
-        }
-
-        void operator()( const NonTerminals::VariableDefinition &parserVarDef ) {
-            auto &varDef = _this.underlyingStatement.emplace<VariableDefinition>(parserVarDef);
+    switch( parserStatement.kind() ) {
+    case NonTerminals::FlatTree::Kind::EmptyStatement:
+        ABORT()<<"Statement is in monostate";
+    case NonTerminals::FlatTree::Kind::VariableDefinition:
+        {
+            auto &varDef = underlyingStatement.emplace<VariableDefinition>(parserStatement);
             varDef.buildAST(lookupCtx);
         }
-
-        void operator()( const NonTerminals::Statement::ConditionalStatement &parserCondition ) {
-            auto &condition = _this.underlyingStatement.emplace<ConditionalStatement>(parserCondition);
+        break;
+    case NonTerminals::FlatTree::Kind::ConditionalStatement:
+        {
+            auto &condition = underlyingStatement.emplace<ConditionalStatement>(parserStatement);
             condition.buildAST(lookupCtx);
         }
-
-        void operator()( const std::unique_ptr<NonTerminals::CompoundStatement> &parserCompound ) {
-            auto &compound = _this.underlyingStatement.emplace<
+        break;
+    case NonTerminals::FlatTree::Kind::CompoundStatement:
+        {
+            auto &compound = underlyingStatement.emplace<
                     std::unique_ptr<CompoundStatement>
                 >(
-                    safenew<CompoundStatement>( *parserCompound, lookupCtx )
+                    safenew<CompoundStatement>( parserStatement, lookupCtx )
                 );
             compound->buildAST();
         }
-    };
-
-    std::visit( Visitor{ ._this=*this, .lookupCtx=lookupCtx }, parserStatement.content );
+        break;
+    default:
+        {
+            auto &expression = underlyingStatement.emplace<Expression>(parserStatement);
+            Weight weight;
+            expression.buildAST(lookupCtx, ExpectedResult(), weight, Expression::NoWeightLimit);
+        }
+        break;
+    }
 }
 
 void Statement::codeGen( const LookupContext &lookupCtx, PracticalSemanticAnalyzer::FunctionGen *functionGen ) const {
@@ -83,10 +79,6 @@ void Statement::codeGen( const LookupContext &lookupCtx, PracticalSemanticAnalyz
             varDef.codeGen( lookupCtx, functionGen );
         }
 
-        void operator()( const NonTerminals::Statement::ConditionalStatement &condition ) {
-            ABORT()<<"TODO implement";
-        }
-
         void operator()( const ConditionalStatement &condition ) {
             condition.codeGen(lookupCtx, functionGen);
         }
@@ -13,20 +13,20 @@
 #include "ast/expression.h"
 #include "ast/lookup_context.h"
 #include "ast/variable_definition.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST {
 
 class CompoundStatement;
 
 class Statement {
-    const NonTerminals::Statement &parserStatement;
+    NonTerminals::FlatTree::Cursor parserStatement;
     std::variant<
             std::monostate, Expression, VariableDefinition, ConditionalStatement, std::unique_ptr<CompoundStatement>
         > underlyingStatement;
 
 public:
-    explicit Statement( const NonTerminals::Statement &parserStatement );
+    explicit Statement( NonTerminals::FlatTree::Cursor parserStatement );
     Statement( const Statement &rhs ); // Declared only. Should never be called
     ~Statement();
 
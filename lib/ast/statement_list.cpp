@@ -10,10 +10,11 @@
 
 namespace AST {
 
-StatementList::StatementList( const NonTerminals::StatementList &statementList )
+StatementList::StatementList( NonTerminals::FlatTree::Cursor statementList )
 {
-    statements.reserve( statementList.statements.size() );
-    for( auto &parserStatement : statementList.statements ) {
+    ASSERT( statementList.kind()==NonTerminals::FlatTree::Kind::StatementList );
+    statements.reserve( statementList.numChildren() );
+    for( auto parserStatement : statementList.children() ) {
         statements.emplace_back( parserStatement );
     }
 }
@@ -11,7 +11,7 @@
 
 #include "ast/lookup_context.h"
 #include "ast/statement.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 namespace AST {
 
@@ -19,7 +19,7 @@ class StatementList {
     std::vector<Statement> statements;
 
 public:
-    explicit StatementList( const NonTerminals::StatementList &statementList );
+    explicit StatementList( NonTerminals::FlatTree::Cursor statementList );
 
     void buildAST( LookupContext &lookupCtx );
     void codeGen( const LookupContext &lookupCtx, PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
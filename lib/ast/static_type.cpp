@@ -12,11 +12,49 @@
 #include "ast/pointers.h"
 
 #include <sstream>
+#include <unordered_map>
 
 using namespace PracticalSemanticAnalyzer;
 
 namespace AST {
 
+// Non member private helpers
+namespace {
+
+struct ComponentsHash {
+    size_t operator()( const std::pair<const StaticTypeImpl *, size_t> &key ) const {
+        return std::hash<const StaticTypeImpl *>{}( key.first ) * FibonacciHashMultiplier + key.second;
+    }
+
+    size_t operator()( const std::vector<const StaticTypeImpl *> &key ) const {
+        size_t result = 0;
+        for( const StaticTypeImpl *component : key ) {
+            result += std::hash<const StaticTypeImpl *>{}( component );
+            result *= FibonacciHashMultiplier;
+        }
+
+        return result;
+    }
+};
+
+// Interned types, keyed by the (already interned) types they are made of
+struct InternedTypes {
+    std::unordered_map< const StaticTypeImpl *, StaticTypeImpl::CPtr > pointers;
+    std::unordered_map< std::pair<const StaticTypeImpl *, size_t>, StaticTypeImpl::CPtr, ComponentsHash > arrays;
+    // Return type, then the argument types
+    std::unordered_map< std::vector<const StaticTypeImpl *>, StaticTypeImpl::CPtr, ComponentsHash > functions;
+    // Keyed by the type with no flags and the flags
+    std::unordered_map< std::pair<const StaticTypeImpl *, size_t>, StaticTypeImpl::CPtr, ComponentsHash > variants;
+};
+
+InternedTypes &internedTypes() {
+    static InternedTypes types;
+
+    return types;
+}
+
+} // anonymous namespace
+
 ScalarTypeImpl::ScalarTypeImpl(
         String name, String mangledName, size_t size, size_t alignment, Scalar::Type type,
         PracticalSemanticAnalyzer::TypeId backendType, unsigned literalWeight
@@ -156,10 +194,84 @@ size_t ArrayTypeImpl::getNumElements() const {
     return dimension;
 }
 
-StaticTypeImpl::StaticTypeImpl( const StaticTypeImpl &that ) :
-    valueRange( that.valueRange ),
-    flags( that.flags )
+StaticTypeImpl::CPtr StaticTypeImpl::allocate( ScalarTypeImpl &&scalar, ValueRangeBase::CPtr valueRange ) {
+    return new StaticTypeImpl( std::move(scalar), std::move(valueRange) );
+}
+
+StaticTypeImpl::CPtr StaticTypeImpl::allocate( FunctionTypeImpl &&function ) {
+    std::vector<const StaticTypeImpl *> key;
+    key.reserve( function.argumentTypes.size() + 1 );
+    key.emplace_back( function.returnType.get() );
+    for( const auto &argument : function.argumentTypes )
+        key.emplace_back( argument.get() );
+
+    auto &functions = internedTypes().functions;
+    auto iter = functions.find( key );
+    if( iter!=functions.end() )
+        return iter->second;
+
+    CPtr type = new StaticTypeImpl( std::move(function) );
+    functions.emplace( std::move(key), type );
+
+    return type;
+}
+
+StaticTypeImpl::CPtr StaticTypeImpl::allocate( PointerTypeImpl &&pointer ) {
+    const StaticTypeImpl *key = pointer.pointed.get();
+
+    auto &pointers = internedTypes().pointers;
+    auto iter = pointers.find( key );
+    if( iter!=pointers.end() )
+        return iter->second;
+
+    CPtr type = new StaticTypeImpl( std::move(pointer) );
+    pointers.emplace( key, type );
+
+    return type;
+}
+
+StaticTypeImpl::CPtr StaticTypeImpl::allocate( ArrayTypeImpl &&array ) {
+    auto key = std::make_pair( array.elementType.get(), array.dimension );
+
+    auto &arrays = internedTypes().arrays;
+    auto iter = arrays.find( key );
+    if( iter!=arrays.end() )
+        return iter->second;
+
+    CPtr type = new StaticTypeImpl( std::move(array) );
+    arrays.emplace( key, type );
+
+    return type;
+}
+
+StaticType::CPtr StaticTypeImpl::setFlags( Flags::Type newFlags ) const {
+    if( flags==newFlags )
+        return this;
+
+    const StaticTypeImpl *base = unflagged ? unflagged.get() : this;
+    if( newFlags==0 )
+        return base;
+
+    auto key = std::make_pair( base, size_t(newFlags) );
+
+    auto &variants = internedTypes().variants;
+    auto iter = variants.find( key );
+    if( iter!=variants.end() )
+        return iter->second;
+
+    CPtr type = new StaticTypeImpl( *base, newFlags );
+    variants.emplace( key, type );
+
+    return type;
+}
+
+StaticTypeImpl::StaticTypeImpl( const StaticTypeImpl &base, Flags::Type flags ) :
+    valueRange( base.valueRange ),
+    flags( flags ),
+    unflagged( &base )
 {
+    ASSERT( base.flags==0 );
+
     struct Visitor {
         StaticTypeImpl *_this;
 
@@ -180,7 +292,7 @@ StaticTypeImpl::StaticTypeImpl( const StaticTypeImpl &that ) :
         }
     };
 
-    std::visit( Visitor{ ._this=this }, that.content );
+    std::visit( Visitor{ ._this=this }, base.content );
 }
 
 StaticTypeImpl::StaticTypeImpl( ScalarTypeImpl &&scalar, ValueRangeBase::CPtr valueRange ) :
@@ -54,6 +54,8 @@ class FunctionTypeImpl final : public PracticalSemanticAnalyzer::StaticType::Fun
     boost::intrusive_ptr<const StaticTypeImpl> returnType;
     std::vector< boost::intrusive_ptr<const StaticTypeImpl> > argumentTypes;
 
+    friend StaticTypeImpl;
+
 public:
     explicit FunctionTypeImpl(
             boost::intrusive_ptr<const StaticTypeImpl> &&returnType,
@@ -80,6 +82,8 @@ class ArrayTypeImpl final : public PracticalSemanticAnalyzer::StaticType::Array
     boost::intrusive_ptr<const StaticTypeImpl> elementType;
     size_t dimension;
 
+    friend StaticTypeImpl;
+
 public:
     explicit ArrayTypeImpl( boost::intrusive_ptr<const StaticTypeImpl> elementType, size_t dimension );
 
@@ -91,6 +95,8 @@ public:
 class PointerTypeImpl final : public PracticalSemanticAnalyzer::StaticType::Pointer {
     boost::intrusive_ptr<const StaticTypeImpl> pointed;
 
+    friend StaticTypeImpl;
+
 public:
     explicit PointerTypeImpl( boost::intrusive_ptr<const StaticTypeImpl> pointed );
 
@@ -98,6 +104,8 @@ public:
     virtual PracticalSemanticAnalyzer::StaticType::CPtr getPointedType() const override;
 };
 
+// Types are interned: each distinct type, flags included, has exactly one instance. Comparing types is comparing
+// pointers.
 class StaticTypeImpl final : public PracticalSemanticAnalyzer::StaticType {
 private:
     std::variant<
@@ -109,15 +117,18 @@ private:
     ValueRangeBase::CPtr valueRange;
     mutable std::string mangledName;
     Flags::Type flags = 0;
+    // The instance with no flags this one is a variant of. nullptr if flags==0
+    boost::intrusive_ptr<const StaticTypeImpl> unflagged;
 
 public:
     using CPtr = boost::intrusive_ptr<const StaticTypeImpl>;
     using Ptr = boost::intrusive_ptr<StaticTypeImpl>;
 
-    template<typename... Args>
-    static Ptr allocate(Args&&... args) {
-        return new StaticTypeImpl( std::forward<Args>(args)... );
-    }
+    // Each scalar is a distinct type. Other types return the existing instance, if there is one
+    static CPtr allocate( ScalarTypeImpl &&scalar, ValueRangeBase::CPtr valueRange );
+    static CPtr allocate( FunctionTypeImpl &&function );
+    static CPtr allocate( PointerTypeImpl &&pointer );
+    static CPtr allocate( ArrayTypeImpl &&array );
 
     virtual Types getType() const override final;
 
@@ -132,21 +143,13 @@ public:
         return flags;
     }
 
-    virtual StaticType::CPtr setFlags( Flags::Type newFlags ) const override {
-        if( flags==newFlags )
-            return this;
-
-        Ptr ret = allocate( *this );
-        ret->flags = newFlags;
-
-        return ret;
-    }
+    virtual StaticType::CPtr setFlags( Flags::Type newFlags ) const override;
 
     friend std::ostream &operator<<( std::ostream &out, const AST::StaticTypeImpl::CPtr &type );
 
 private:
-    // Copy
-    explicit StaticTypeImpl( const StaticTypeImpl &that );
+    // Variant of a type with no flags
+    explicit StaticTypeImpl( const StaticTypeImpl &base, Flags::Type flags );
 
     explicit StaticTypeImpl( ScalarTypeImpl &&scalar, ValueRangeBase::CPtr valueRange );
     explicit StaticTypeImpl( FunctionTypeImpl &&function );
@@ -162,13 +165,7 @@ const ArrayTypeImpl *downCast( const PracticalSemanticAnalyzer::StaticType::Arra
 } // End namespace AST
 
 inline bool operator==( const AST::StaticTypeImpl::CPtr &lhs, const AST::StaticTypeImpl::CPtr &rhs ) {
-    if( !lhs && !rhs )
-        return true;
-
-    if( !lhs || !rhs )
-        return false;
-
-    return *lhs == *rhs;
+    return lhs.get() == rhs.get();
 }
 
 inline bool operator!=( const AST::StaticTypeImpl::CPtr &lhs, const AST::StaticTypeImpl::CPtr &rhs ) {
@@ -12,30 +12,30 @@ using namespace PracticalSemanticAnalyzer;
 
 namespace AST {
 
-VariableDefinition::VariableDefinition(const NonTerminals::VariableDefinition &parserVarDef) :
+VariableDefinition::VariableDefinition(NonTerminals::FlatTree::Cursor parserVarDef) :
     parserVarDef( parserVarDef ),
-    initValue( *parserVarDef.initValue )
+    initValue( parserVarDef.child(1) )
 {
 }
 
 void VariableDefinition::buildAST( LookupContext &lookupCtx ) {
-    auto varType = lookupCtx.lookupType( parserVarDef.body.type );
+    auto varType = lookupCtx.lookupType( parserVarDef.child(0) );
 
     Weight weight;
     initValue.buildAST(lookupCtx, varType, weight, Expression::NoWeightLimit);
 
-    lookupCtx.addLocalVar( parserVarDef.body.name.identifier, varType, Expression::allocateId() );
+    lookupCtx.addLocalVar( parserVarDef.token(), varType, Expression::allocateId() );
 }
 
 void VariableDefinition::codeGen(
         const LookupContext &lookupCtx, PracticalSemanticAnalyzer::FunctionGen *functionGen ) const
 {
-    const LookupContext::Identifier *identifier = lookupCtx.lookupIdentifier( parserVarDef.body.name.identifier->text );
+    const LookupContext::Identifier *identifier = lookupCtx.lookupIdentifier( parserVarDef.token()->symbol );
     const auto &varDef = std::get< LookupContext::Variable >(*identifier);
 
     ExpressionId initValueExpressionId = initValue.codeGen(functionGen);
 
-    functionGen->allocateStackVar(varDef.lvalueId, varDef.type, parserVarDef.body.name.identifier->text);
+    functionGen->allocateStackVar(varDef.lvalueId, varDef.type, parserVarDef.token()->text);
 
     functionGen->assign( varDef.lvalueId, initValueExpressionId );
 }
@@ -11,18 +11,18 @@
 
 #include "ast/expression.h"
 #include "ast/lookup_context.h"
-#include "parser.h"
+#include "parser/flat_tree.h"
 
 #include <practical/practical.h>
 
 namespace AST {
 
 class VariableDefinition {
-    const NonTerminals::VariableDefinition &parserVarDef;
+    NonTerminals::FlatTree::Cursor parserVarDef;
     Expression initValue;
 
 public:
-    explicit VariableDefinition(const NonTerminals::VariableDefinition &parserVarDef);
+    explicit VariableDefinition(NonTerminals::FlatTree::Cursor parserVarDef);
 
     void buildAST( LookupContext &lookupCtx );
     void codeGen( const LookupContext &lookupCtx, PracticalSemanticAnalyzer::FunctionGen *functionGen ) const;
@@ -101,7 +101,7 @@ private:
     }
 };
 
-std::ostream &operator<<(std::ostream &out, unsigned __int128 val) {
+inline std::ostream &operator<<(std::ostream &out, unsigned __int128 val) {
     char output[50];
     int i=0;
 
@@ -120,7 +120,7 @@ std::ostream &operator<<(std::ostream &out, unsigned __int128 val) {
     return out;
 }
 
-std::ostream &operator<<(std::ostream &out, signed __int128 val) {
+inline std::ostream &operator<<(std::ostream &out, signed __int128 val) {
     if( val<0 ) {
         val = -val;
         out<<'-';
@@ -129,7 +129,7 @@ std::ostream &operator<<(std::ostream &out, signed __int128 val) {
     return out<<static_cast<unsigned __int128>(val);
 }
 
-std::ostream &operator<<(std::ostream &out, ExactInt i) {
+inline std::ostream &operator<<(std::ostream &out, ExactInt i) {
     switch( i.getType() ) {
     case ExactInt::Type::SIGNED:
         out<<i.getSigned();
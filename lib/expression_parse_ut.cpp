@@ -0,0 +1,246 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "parser.h"
+#include "tokenizer.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+class ExpressionParseTest : public CppUnit::TestFixture  {
+    struct Case {
+        const char *source;
+        // Tokens consumed followed by the tree, or "fail"
+        const char *expected;
+    };
+
+    // What the parser produced before operators were parsed by precedence climbing. That parser lost the token range
+    // of an expression whenever it moved it. Those ranges show as "@-", and match any range
+    static constexpr Case Cases[] = {
+        // Prefix operators, chained
+        { "-a", "2 (- a@1-2)@0-2" },
+        { "- -a", "3 (- (- a@2-3)@1-3)@0-3" },
+        { "!-~a", "4 (! (- (~ a@3-4)@2-4)@1-4)@0-4" },
+        { "~!-+a", "5 (~ (! (- (+ a@4-5)@3-5)@2-5)@1-5)@0-5" },
+        { "!!a", "3 (! (! a@2-3)@1-3)@0-3" },
+        { "- - - 3", "4 (- (- (- 3@3-4)@2-4)@1-4)@0-4" },
+        { "-a * b", "4 (* (- a@1-2)@0-2 b@3-4)@0-4" },
+        { "-a@", "3 (- (@ a@-)@1-3)@0-3" },
+        { "!p@@", "4 (! (@ (@ p@-)@-)@1-4)@0-4" },
+        // Casts
+        { "expect!S32( a )", "6 (expect S32 a@4-5)@0-6" },
+        { "expect!S32( a ) + 1", "8 (+ (expect S32 a@4-5)@0-6 1@7-8)@0-8" },
+        { "-expect!U8( b )", "7 (- (expect U8 b@5-6)@1-7)@0-7" },
+        { "expect!S32( expect!U8( a ) )", "11 (expect S32 (expect U8 a@8-9)@4-10)@0-11" },
+        { "!expect!Bool( a )", "7 (! (expect Bool a@5-6)@1-7)@0-7" },
+        { "expect!S32@( p )", "7 (expect S32 @ p@5-6)@0-7" },
+        { "expect!S32( a )@", "6 (expect S32 a@4-5)@0-6" },
+        // Assignments group right to left
+        { "a = b", "3 (= a@0-1 b@2-3)@0-3" },
+        { "a = b = c", "5 (= a@0-1 (= b@2-3 c@4-5)@2-5)@0-5" },
+        { "a += b -= c * 2", "7 (+= a@0-1 (-= b@2-3 (* c@4-5 2@6-7)@4-7)@2-7)@0-7" },
+        { "a = b + c = d", "7 (= a@0-1 (= (+ b@2-3 c@4-5)@2-5 d@6-7)@2-7)@0-7" },
+        { "a = b || c && d", "7 (= a@0-1 (|| b@2-3 (&& c@4-5 d@6-7)@4-7)@2-7)@0-7" },
+        // Postfix operators
+        { "p@", "2 (@ p@-)@0-2" },
+        { "a&", "2 (& a@-)@0-2" },
+        { "p@@", "3 (@ (@ p@-)@-)@0-3" },
+        { "a&@", "3 (@ (& a@-)@-)@0-3" },
+        { "p@&", "3 (& (@ p@-)@-)@0-3" },
+        { "f( a )@", "5 (@ (call f@- a@2-3)@-)@0-5" },
+        { "f( a, b )( c )", "9 (call (call f@- a@- b@4-5)@- c@7-8)@0-9" },
+        { "f()", "3 (call f@-)@0-3" },
+        { "f( a + b, -c, d& )", "12 (call f@- (+ a@2-3 b@4-5)@- (- c@7-8)@- (& d@-)@9-11)@0-12" },
+        { "p@ + 1", "4 (+ (@ p@-)@0-2 1@3-4)@0-4" },
+        { "a& + 1", "4 (+ (& a@-)@0-2 1@3-4)@0-4" },
+        { "a ++ b", "2 (++ a@-)@0-2" },
+        // After an operand, & is taken to be address of. Bitwise AND is never reached
+        { "a & b", "2 (& a@-)@0-2" },
+        { "a& & b", "3 (& (& a@-)@-)@0-3" },
+        { "a & b&", "2 (& a@-)@0-2" },
+        { "a&b&c", "2 (& a@-)@0-2" },
+        { "a& & b&", "3 (& (& a@-)@-)@0-3" },
+        { "a&&b", "3 (&& a@0-1 b@2-3)@0-3" },
+        { "a & &b", "3 (& (& a@-)@-)@0-3" },
+        { "(a & b)&", "fail" },
+        { "x& == y&", "5 (== (& x@-)@0-2 (& y@-)@3-5)@0-5" },
+        // Precedence and left to right grouping
+        { "a", "1 a@0-1" },
+        { "a + b * c", "5 (+ a@0-1 (* b@2-3 c@4-5)@2-5)@0-5" },
+        { "a + b * c - d", "7 (- (+ a@0-1 (* b@2-3 c@4-5)@2-5)@- d@6-7)@0-7" },
+        { "a - b - c", "5 (- (- a@0-1 b@2-3)@- c@4-5)@0-5" },
+        { "a * b / c % d", "7 (% (/ (* a@0-1 b@2-3)@- c@4-5)@- d@6-7)@0-7" },
+        { "a << b < c == d && e || f",
+                "11 (|| (&& (== (< (<< a@0-1 b@2-3)@0-3 c@4-5)@0-5 d@6-7)@0-7 e@8-9)@0-9 f@10-11)@0-11" },
+        { "a | b ^ c & d", "6 (^ (| a@0-1 b@2-3)@- (& c@-)@4-6)@0-6" },
+        { "(a + b) * c", "7 (* (+ a@1-2 b@3-4)@0-5 c@6-7)@0-7" },
+        // Compound and conditional expressions
+        { "(if( a ) { b } else { c })", "13 (if a@- {}@- {}@-)@0-13" },
+        { "(if( a ) { b } else { c }) + 1", "15 (+ (if a@- {}@- {}@-)@0-13 1@14-15)@0-15" },
+        { "a + (if( a ) { b } else { c })", "15 (+ a@0-1 (if a@- {}@- {}@-)@2-15)@0-15" },
+        { "{ a }", "3 {{ a }}@0-3" },
+        { "a + { b }", "1 type a@0-1" },
+        // Types that read as expressions
+        { "S32", "1 S32@0-1" },
+        { "S32@", "2 (@ S32@-)@0-2" },
+        { "S32@ + 1", "4 (+ (@ S32@-)@0-2 1@3-4)@0-4" },
+        { "f( S32 )", "4 (call f@- S32@2-3)@0-4" },
+        // Parses that stop early, or fail
+        { "a +", "1 type a@0-1" },
+        { "a b", "1 a@0-1" },
+        { "a = ", "1 type a@0-1" },
+        { "+", "fail" }
+    };
+
+    struct RenderVisitor {
+        const Tokenizer::Token *base;
+        Slice<const Tokenizer::Token> parsed;
+
+        static std::string text(Slice<const Tokenizer::Token> tokens) {
+            std::string ret;
+            for( const Tokenizer::Token &token : tokens ) {
+                if( !ret.empty() )
+                    ret += " ";
+                ret += sliceToString( token.text );
+            }
+
+            return ret;
+        }
+
+        std::string operator()( const NonTerminals::NodePtr<NonTerminals::CompoundExpression> & ) const {
+            return "{" + text( parsed ) + "}";
+        }
+
+        std::string operator()( const NonTerminals::Literal & ) const {
+            return text( parsed );
+        }
+
+        std::string operator()( const NonTerminals::Identifier &identifier ) const {
+            return sliceToString( identifier.identifier->text );
+        }
+
+        std::string operator()( const NonTerminals::Expression::UnaryOperator &op ) const {
+            return "(" + sliceToString( op.op->text ) + " " + render( *op.operand, base ) + ")";
+        }
+
+        std::string operator()( const NonTerminals::Expression::BinaryOperator &op ) const {
+            return "(" + sliceToString( op.op->text ) + " " + render( *op.operands[0], base ) + " " +
+                    render( *op.operands[1], base ) + ")";
+        }
+
+        std::string operator()( const NonTerminals::Expression::CastOperator &op ) const {
+            return "(" + sliceToString( op.op->text ) + " " + text( op.destType.getNTTokens() ) + " " +
+                    render( *op.expression, base ) + ")";
+        }
+
+        std::string operator()( const NonTerminals::Expression::FunctionCall &call ) const {
+            std::string ret = "(call " + render( *call.expression, base );
+            for( const NonTerminals::Expression &argument : call.arguments.arguments )
+                ret += " " + render( argument, base );
+
+            return ret + ")";
+        }
+
+        std::string operator()( const NonTerminals::NodePtr<NonTerminals::ConditionalExpression> &condition ) const {
+            return "(if " + render( condition->condition, base ) + " " + render( condition->ifClause, base ) + " " +
+                    render( condition->elseClause, base ) + ")";
+        }
+
+        std::string operator()( const NonTerminals::Type &type ) const {
+            return "type " + text( type.getNTTokens() );
+        }
+    };
+
+    // Lisp like rendering of an expression tree. Each node is followed by the range of tokens it was parsed from
+    static std::string render(const NonTerminals::Expression &expression, const Tokenizer::Token *base) {
+        Slice<const Tokenizer::Token> parsed = expression.getNTTokens();
+        std::string ret = std::visit( RenderVisitor{ .base = base, .parsed = parsed }, expression.value );
+        if( parsed.size()==0 )
+            return ret + "@-";
+
+        size_t first = parsed.get() - base;
+        return ret + "@" + std::to_string( first ) + "-" + std::to_string( first + parsed.size() );
+    }
+
+    static std::string parse(const char *source) {
+        std::vector<Tokenizer::Token> tokens = Tokenizer::Tokenizer::tokenizeSignificant( source );
+
+        Arena arena;
+        NonTerminals::ArenaScope scope( arena );
+        NonTerminals::Expression expression;
+        NonTerminals::ParseResult result = expression.tryParse( tokens );
+        if( !result )
+            return "fail";
+
+        return std::to_string( result.consumed() ) + " " + render( expression, tokens.data() );
+    }
+
+    // Same as expected, except that where expected has no range, actual may have any
+    static bool matches(const std::string &expected, const std::string &actual) {
+        size_t i = 0, j = 0;
+        while( i<expected.size() && j<actual.size() ) {
+            if( expected.compare( i, 2, "@-" )==0 && actual[j]=='@' ) {
+                i += 2;
+                ++j;
+                if( j<actual.size() && actual[j]=='-' ) {
+                    ++j;
+                } else {
+                    while( j<actual.size() && ( isdigit( actual[j] ) || actual[j]=='-' ) )
+                        ++j;
+                }
+
+                continue;
+            }
+
+            if( expected[i]!=actual[j] )
+                return false;
+
+            ++i;
+            ++j;
+        }
+
+        return i==expected.size() && j==actual.size();
+    }
+
+public:
+    void rangeMatching() {
+        CPPUNIT_ASSERT( matches( "2 (- a@1-2)@0-2", "2 (- a@1-2)@0-2" ) );
+        CPPUNIT_ASSERT( matches( "2 (- a@-)@0-2", "2 (- a@1-2)@0-2" ) );
+        CPPUNIT_ASSERT( matches( "2 (- a@-)@0-2", "2 (- a@-)@0-2" ) );
+        CPPUNIT_ASSERT( !matches( "2 (- a@1-2)@0-2", "2 (- a@-)@0-2" ) );
+        CPPUNIT_ASSERT( !matches( "2 (- a@1-2)@0-2", "2 (- a@0-2)@0-2" ) );
+        CPPUNIT_ASSERT( !matches( "2 (- a@-)@0-2", "2 (+ a@1-2)@0-2" ) );
+        CPPUNIT_ASSERT( !matches( "2 (- a@-)@0-2", "2 (- a@1-2)@0-3" ) );
+    }
+
+    void sameTrees() {
+        for( const Case &test : Cases ) {
+            std::string actual = parse( test.source );
+            CPPUNIT_ASSERT_MESSAGE(
+                    std::string( test.source ) + ": expected " + test.expected + ", got " + actual,
+                    matches( test.expected, actual ) );
+        }
+    }
+
+    static CppUnit::Test *suite()
+    {
+        CppUnit::TestSuite *suiteOfTests = new CppUnit::TestSuite( "ExpressionParseTest" );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ExpressionParseTest>(
+                    "rangeMatching",
+                    &ExpressionParseTest::rangeMatching ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ExpressionParseTest>(
+                    "sameTrees",
+                    &ExpressionParseTest::sameTrees ) );
+        return suiteOfTests;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ExpressionParseTest );
@@ -0,0 +1,475 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "parser/flat_tree.h"
+#include "parser/module.h"
+
+#include <practical/errors.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <unistd.h>
+
+// Function body walking benchmark
+//
+// The AST does not walk a function body once. Overload resolution builds the AST of each argument again for every
+// candidate it tries, so nodes get visited many times over. This compares walking the parser's pointer tree that many
+// times to flattening the body once and walking the FlatTree instead. Bodies are generated from a fixed seed, so
+// numbers from different builds are comparable.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+class Generator {
+    std::mt19937 random;
+    std::string text;
+
+public:
+    explicit Generator(unsigned seed) : random(seed) {}
+
+    std::string take() {
+        return std::move(text);
+    }
+
+    size_t size() const {
+        return text.size();
+    }
+
+    unsigned pick(unsigned limit) {
+        return random() % limit;
+    }
+
+    Generator &operator<<(const char *str) {
+        text += str;
+        return *this;
+    }
+
+    Generator &operator<<(unsigned number) {
+        text += std::to_string(number);
+        return *this;
+    }
+
+    void expression(unsigned depth) {
+        static const char *const Variables[] = { "a", "b", "c" };
+        static const char *const Operators[] = { " + ", " - ", " * ", " < ", " == " };
+
+        switch( pick( depth<6 ? 9 : 2 ) ) {
+        case 0:
+            *this << pick(100);
+            break;
+        case 1:
+            *this << Variables[ pick(3) ];
+            break;
+        case 2:
+            *this << "(";
+            expression(depth+1);
+            *this << ")";
+            break;
+        case 3:
+        case 4:
+            expression(depth+1);
+            *this << Operators[ pick(5) ];
+            expression(depth+1);
+            break;
+        case 5:
+            *this << "g" << pick(4) << "( ";
+            expression(depth+1);
+            *this << ", ";
+            expression(depth+1);
+            *this << " )";
+            break;
+        case 6:
+            *this << "expect!S32( ";
+            expression(depth+1);
+            *this << " )";
+            break;
+        case 7:
+            *this << "(if( ";
+            expression(depth+1);
+            *this << " ) { ";
+            expression(depth+1);
+            *this << " } else { ";
+            expression(depth+1);
+            *this << " })";
+            break;
+        default:
+            *this << "-(";
+            expression(depth+1);
+            *this << ")";
+            break;
+        }
+    }
+
+    void statement(unsigned depth) {
+        switch( pick( depth<3 ? 4 : 2 ) ) {
+        case 0:
+            *this << "def v" << pick(10) << " : S32 = ";
+            expression(depth+1);
+            *this << "; ";
+            break;
+        case 1:
+            expression(depth+1);
+            *this << "; ";
+            break;
+        case 2:
+            *this << "if( ";
+            expression(depth+1);
+            *this << " ) { ";
+            statement(depth+1);
+            *this << "} else { ";
+            statement(depth+1);
+            *this << "} ";
+            break;
+        default:
+            *this << "{ ";
+            statement(depth+1);
+            statement(depth+1);
+            *this << "} ";
+            break;
+        }
+    }
+
+    void function(unsigned index) {
+        *this << "def h" << index << "( a : S32, b : S32 ) -> S32 {\n    def c : S32@ = a&;\n";
+        for( unsigned count = 4 + pick(8); count>0; --count ) {
+            *this << "    ";
+            statement(0);
+            *this << "\n";
+        }
+        *this << "    ";
+        expression(0);
+        *this << "\n}\n";
+    }
+};
+
+// Visits a body through the parser's own nodes, in the same order FlatTree lays them out. Like the AST, it looks at
+// each node's type, tokens and children
+struct PointerWalk {
+    size_t nodes = 0, tokens = 0;
+
+    void node(Slice<const Tokenizer::Token> parsed) {
+        ++nodes;
+        tokens += parsed.size();
+    }
+
+    void walk(const NonTerminals::Expression &expression) {
+        using namespace NonTerminals;
+
+        Slice<const Tokenizer::Token> parsed = expression.getNTTokens();
+        struct Visitor {
+            PointerWalk *_this;
+            Slice<const Tokenizer::Token> parsed;
+
+            void operator()( const NodePtr<CompoundExpression> &compound ) {
+                _this->walk( *compound );
+            }
+
+            void operator()( const Literal &literal ) {
+                _this->node( parsed );
+            }
+
+            void operator()( const Identifier &identifier ) {
+                _this->node( parsed );
+            }
+
+            void operator()( const Expression::UnaryOperator &op ) {
+                _this->node( parsed );
+                _this->walk( *op.operand );
+            }
+
+            void operator()( const Expression::BinaryOperator &op ) {
+                _this->node( parsed );
+                _this->walk( *op.operands[0] );
+                _this->walk( *op.operands[1] );
+            }
+
+            void operator()( const Expression::CastOperator &op ) {
+                _this->node( parsed );
+                _this->walk( op.destType );
+                _this->walk( *op.expression );
+            }
+
+            void operator()( const Expression::FunctionCall &call ) {
+                _this->node( parsed );
+                _this->walk( *call.expression );
+                for( const Expression &argument : call.arguments.arguments )
+                    _this->walk( argument );
+            }
+
+            void operator()( const NodePtr<ConditionalExpression> &condition ) {
+                _this->node( parsed );
+                _this->walk( condition->condition );
+                _this->walk( condition->ifClause );
+                _this->walk( condition->elseClause );
+            }
+
+            void operator()( const Type &type ) {
+                _this->walk( type );
+            }
+        };
+
+        std::visit( Visitor{ ._this = this, .parsed = parsed }, expression.value );
+    }
+
+    void walk(const NonTerminals::Type &type) {
+        using namespace NonTerminals;
+
+        node( type.getNTTokens() );
+        if( auto array = std::get_if<Type::Array>( &type.type ) )
+            walk( *array->elementType );
+        else if( auto pointer = std::get_if<Type::Pointer>( &type.type ) )
+            walk( *pointer->pointed );
+    }
+
+    void walk(const NonTerminals::Statement &statement) {
+        using namespace NonTerminals;
+
+        Slice<const Tokenizer::Token> parsed = statement.getNTTokens();
+        struct Visitor {
+            PointerWalk *_this;
+            Slice<const Tokenizer::Token> parsed;
+
+            void operator()( std::monostate ) {
+                _this->node( parsed );
+            }
+
+            void operator()( const Expression &expression ) {
+                _this->walk( expression );
+            }
+
+            void operator()( const VariableDefinition &definition ) {
+                _this->node( definition.getNTTokens() );
+                _this->walk( definition.body.type );
+                if( definition.initValue )
+                    _this->walk( *definition.initValue );
+            }
+
+            void operator()( const Statement::ConditionalStatement &condition ) {
+                _this->node( parsed );
+                _this->walk( condition.condition );
+                _this->walk( *condition.ifClause );
+                if( condition.elseClause )
+                    _this->walk( *condition.elseClause );
+            }
+
+            void operator()( const NodePtr<CompoundStatement> &compound ) {
+                _this->walk( *compound );
+            }
+        };
+
+        std::visit( Visitor{ ._this = this, .parsed = parsed }, statement.content );
+    }
+
+    void walk(const NonTerminals::StatementList &statementList) {
+        node( statementList.getNTTokens() );
+        for( const NonTerminals::Statement &statement : statementList.statements )
+            walk( statement );
+    }
+
+    void walk(const NonTerminals::CompoundExpression &compound) {
+        node( compound.getNTTokens() );
+        walk( compound.statementList );
+        walk( compound.expression );
+    }
+
+    void walk(const NonTerminals::CompoundStatement &compound) {
+        node( compound.getNTTokens() );
+        walk( compound.statements );
+    }
+
+    void walk(const NonTerminals::FuncDef::Body &body) {
+        if( auto expression = std::get_if<NonTerminals::CompoundExpression>( &body ) )
+            walk( *expression );
+        else
+            walk( std::get<NonTerminals::CompoundStatement>( body ) );
+    }
+};
+
+struct FlatWalk {
+    size_t nodes = 0, kinds = 0, tokens = 0;
+
+    void walk(NonTerminals::FlatTree::Cursor cursor) {
+        ++nodes;
+        kinds += static_cast<size_t>( cursor.kind() );
+        tokens += cursor.tokens().size();
+
+        for( NonTerminals::FlatTree::Cursor child : cursor.children() )
+            walk( child );
+    }
+};
+
+struct Options {
+    size_t size = 1024*1024;
+    unsigned repetitions = 5;
+    unsigned seed = 1;
+    unsigned walks = 64;
+};
+
+// Best time, in seconds, test reports over a module whose function bodies are yet to be parsed
+template<typename Test>
+double best(const Options &options, const std::string &text, Test test) {
+    double bestSeconds = 0;
+    for( unsigned i=0; i<options.repetitions; ++i ) {
+        NonTerminals::Module module;
+        module.lazyFunctionBodies = true;
+        module.parse( String(text) );
+
+        double seconds = test( module );
+        if( i==0 || seconds<bestSeconds )
+            bestSeconds = seconds;
+    }
+
+    return bestSeconds;
+}
+
+int run(const Options &options) {
+    Generator generator( options.seed );
+    for( unsigned i=0; i<4; ++i )
+        generator << "def g" << i << "( x : S32, y : S32 ) -> S32 { x + y * " << i << " }\n";
+    for( unsigned i=0; generator.size() < options.size; ++i )
+        generator.function(i);
+    std::string text = generator.take();
+
+    NonTerminals::Module module;
+    module.parse( String(text) );
+
+    // Both walks must see the same nodes, or we are not comparing the same work
+    size_t numNodes = 0;
+    for( const NonTerminals::FuncDef &function : module.functionDefinitions ) {
+        PointerWalk pointerWalk;
+        pointerWalk.walk( function.getBody() );
+
+        FlatWalk flatWalk;
+        flatWalk.walk( function.getFlatBody().root() );
+
+        if( pointerWalk.nodes!=flatWalk.nodes || pointerWalk.tokens!=flatWalk.tokens ||
+                function.getFlatBody().size()!=flatWalk.nodes )
+        {
+            std::cerr << "Walks of function " << function.getName() << " disagree\n";
+            return 1;
+        }
+
+        numNodes += pointerWalk.nodes;
+    }
+
+    // Each body is timed from right after it is parsed.
+    //
+    // The walkers keep counting across walks. Otherwise, the compiler may notice walking the same tree again gives
+    // the same result, and skip it
+    size_t check = 0;
+    auto pointerWalks = [&]( const NonTerminals::Module &module, unsigned walks ) {
+        PointerWalk walk;
+        Clock::duration elapsed{};
+        for( const NonTerminals::FuncDef &function : module.functionDefinitions ) {
+            const NonTerminals::FuncDef::Body &body = function.getBody();
+
+            auto start = Clock::now();
+            for( unsigned i=0; i<walks; ++i )
+                walk.walk( body );
+            elapsed += Clock::now() - start;
+        }
+        check += walk.nodes + walk.tokens;
+
+        return std::chrono::duration<double>( elapsed ).count();
+    };
+    auto flatWalks = [&]( const NonTerminals::Module &module, unsigned walks ) {
+        FlatWalk walk;
+        Clock::duration elapsed{};
+        for( const NonTerminals::FuncDef &function : module.functionDefinitions ) {
+            const NonTerminals::FuncDef::Body &body = function.getBody();
+
+            auto start = Clock::now();
+            NonTerminals::FlatTree tree( body, function.getNTTokens() );
+            for( unsigned i=0; i<walks; ++i )
+                walk.walk( tree.root() );
+            elapsed += Clock::now() - start;
+        }
+        check += walk.kinds + walk.tokens;
+
+        return std::chrono::duration<double>( elapsed ).count();
+    };
+
+    printf( "%zu bytes, %zu functions, %zu nodes\n", text.size(), module.functionDefinitions.size(), numNodes );
+    printf( "  %6s %14s %18s %8s\n", "walks", "pointer tree", "flatten and walk", "speedup" );
+
+    double flattenSeconds = best( options, text,
+            [&]( const NonTerminals::Module &module ) { return flatWalks( module, 0 ); } );
+    printf( "  %6u %14s %15.2f ms\n", 0, "", flattenSeconds * 1e3 );
+
+    // Walks after the first find the body in cache, so the cost is not linear in the number of walks
+    for( unsigned walks = 1; walks<=options.walks; walks*=2 ) {
+        double pointerSeconds = best( options, text,
+                [&]( const NonTerminals::Module &module ) { return pointerWalks( module, walks ); } );
+        double flatSeconds = best( options, text,
+                [&]( const NonTerminals::Module &module ) { return flatWalks( module, walks ); } );
+
+        printf( "  %6u %11.2f ms %15.2f ms %7.2fx\n", walks, pointerSeconds * 1e3, flatSeconds * 1e3,
+                pointerSeconds / flatSeconds );
+    }
+
+    // Keep the walks from being optimized away
+    if( check==0 )
+        printf( "\n" );
+
+    return 0;
+}
+
+void help() {
+    std::cout <<
+            "practical-sa-tree-bench: compare walking function bodies as pointer trees and as flat trees\n"
+            "Usage: practical-sa-tree-bench [options]\n"
+            "Options:\n"
+            "-s<KiB>\tSize of the generated source (default 1024)\n"
+            "-r<num>\tNumber of timed runs, best one is reported (default 5)\n"
+            "-S<num>\tRandom seed for the source generator (default 1)\n"
+            "-w<num>\tMost times to walk each body. Walk counts double up to it (default 64)\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+    int opt;
+
+    while( (opt=getopt(argc, argv, "s:r:S:w:?")) != -1 ) {
+        switch( opt ) {
+        case 's':
+            options.size = strtoul( optarg, nullptr, 10 ) * 1024;
+            break;
+        case 'r':
+            options.repetitions = std::max( strtoul( optarg, nullptr, 10 ), 1ul );
+            break;
+        case 'S':
+            options.seed = strtoul( optarg, nullptr, 10 );
+            break;
+        case 'w':
+            options.walks = strtoul( optarg, nullptr, 10 );
+            break;
+        case '?':
+            help();
+            return 0;
+        default:
+            std::cerr << "Invalid option '-" << static_cast<char>(opt) << "'. Use -? for help." << std::endl;
+            help();
+            return 1;
+        }
+    }
+
+    try {
+        return run( options );
+    } catch( PracticalSemanticAnalyzer::compile_error &error ) {
+        std::cerr << "Generated source failed to parse: " << error.what() << "\n";
+        return 1;
+    }
+}
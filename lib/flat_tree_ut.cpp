@@ -0,0 +1,168 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "parser/flat_tree.h"
+#include "parser/module.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+#include <vector>
+
+using NonTerminals::FlatTree;
+
+class FlatTreeTest : public CppUnit::TestFixture  {
+    static constexpr char Source[] =
+            "def nested( a : S32 ) -> S32 {\n"
+            "    def x : S32 = a + 1;\n"
+            "    if( x > 0 ) { { x; } } else { expect!S32( x ); }\n"
+            "    (if( x > 2 ) { x * 2 } else { 3 })\n"
+            "}\n"
+            "def statements() {\n"
+            "    def p : S32[4]@;\n"
+            "}\n";
+
+    NonTerminals::Module module;
+
+    const FlatTree &body(size_t function) {
+        CPPUNIT_ASSERT( function<module.functionDefinitions.size() );
+        return module.functionDefinitions[function].getFlatBody();
+    }
+
+    static std::string text(FlatTree::Cursor cursor) {
+        std::string ret;
+        for( const Tokenizer::Token &token : cursor.tokens() )
+            ret += sliceToString( token.text );
+
+        return ret;
+    }
+
+    static void checkKinds(FlatTree::Cursor cursor, std::vector<FlatTree::Kind> kinds) {
+        CPPUNIT_ASSERT_EQUAL( kinds.size(), cursor.numChildren() );
+
+        size_t index = 0;
+        for( FlatTree::Cursor child : cursor.children() ) {
+            CPPUNIT_ASSERT( child.kind()==kinds[index] );
+            CPPUNIT_ASSERT( child.kind()==cursor.child(index).kind() );
+            CPPUNIT_ASSERT_EQUAL( text(child), text( cursor.child(index) ) );
+            ++index;
+        }
+    }
+
+    // Iterating the children and asking for each by number must see the same nodes. Returns the subtree's size
+    static size_t checkConsistent(FlatTree::Cursor cursor) {
+        size_t size = 1, index = 0;
+        for( FlatTree::Cursor child : cursor.children() ) {
+            FlatTree::Cursor numbered = cursor.child(index);
+            CPPUNIT_ASSERT( child.kind()==numbered.kind() );
+            CPPUNIT_ASSERT_EQUAL( child.numChildren(), numbered.numChildren() );
+
+            size += checkConsistent( child );
+            ++index;
+        }
+        CPPUNIT_ASSERT_EQUAL( index, cursor.numChildren() );
+
+        return size;
+    }
+
+public:
+    void setUp() override {
+        module.parse( Source );
+    }
+
+    void nestedExpression() {
+        using Kind = FlatTree::Kind;
+
+        FlatTree::Cursor root = body(0).root();
+        CPPUNIT_ASSERT( root.kind()==Kind::CompoundExpression );
+        checkKinds( root, { Kind::StatementList, Kind::ConditionalExpression } );
+
+        FlatTree::Cursor statements = root.child(0);
+        checkKinds( statements, { Kind::VariableDefinition, Kind::ConditionalStatement } );
+
+        FlatTree::Cursor definition = statements.child(0);
+        CPPUNIT_ASSERT_EQUAL( std::string("x"), sliceToString( definition.token()->text ) );
+        checkKinds( definition, { Kind::TypeIdentifier, Kind::BinaryOperator } );
+        checkKinds( definition.child(1), { Kind::Identifier, Kind::LiteralInt } );
+        CPPUNIT_ASSERT_EQUAL( std::string("a+1"), text( definition.child(1) ) );
+        CPPUNIT_ASSERT_EQUAL( LongEnoughInt(1), definition.child(1).child(1).intValue() );
+
+        // Compound statements inside compound statements
+        FlatTree::Cursor condition = statements.child(1);
+        checkKinds( condition, { Kind::BinaryOperator, Kind::CompoundStatement, Kind::CompoundStatement } );
+
+        FlatTree::Cursor inner = condition.child(1).child(0);
+        checkKinds( inner, { Kind::CompoundStatement } );
+        checkKinds( inner.child(0), { Kind::StatementList } );
+        checkKinds( inner.child(0).child(0), { Kind::Identifier } );
+        CPPUNIT_ASSERT_EQUAL( size_t(0), inner.child(0).child(0).child(0).numChildren() );
+
+        checkKinds( condition.child(2).child(0), { Kind::CastOperator } );
+        checkKinds( condition.child(2).child(0).child(0), { Kind::TypeIdentifier, Kind::Identifier } );
+
+        // Compound expressions as the clauses of a conditional expression
+        FlatTree::Cursor value = root.child(1);
+        checkKinds( value, { Kind::BinaryOperator, Kind::CompoundExpression, Kind::CompoundExpression } );
+        checkKinds( value.child(1), { Kind::StatementList, Kind::BinaryOperator } );
+        CPPUNIT_ASSERT_EQUAL( size_t(0), value.child(1).child(0).numChildren() );
+        CPPUNIT_ASSERT_EQUAL( std::string("x*2"), text( value.child(1).child(1) ) );
+        checkKinds( value.child(2), { Kind::StatementList, Kind::LiteralInt } );
+        CPPUNIT_ASSERT_EQUAL( LongEnoughInt(3), value.child(2).child(1).intValue() );
+
+        CPPUNIT_ASSERT_EQUAL( body(0).size(), checkConsistent( root ) );
+    }
+
+    void nestedTypes() {
+        using Kind = FlatTree::Kind;
+
+        FlatTree::Cursor root = body(1).root();
+        CPPUNIT_ASSERT( root.kind()==Kind::CompoundStatement );
+        checkKinds( root, { Kind::StatementList } );
+        checkKinds( root.child(0), { Kind::VariableDefinition } );
+
+        // No initial value
+        FlatTree::Cursor definition = root.child(0).child(0);
+        checkKinds( definition, { Kind::TypePointer } );
+        checkKinds( definition.child(0), { Kind::TypeArray } );
+        checkKinds( definition.child(0).child(0), { Kind::TypeIdentifier } );
+        CPPUNIT_ASSERT_EQUAL( LongEnoughInt(4), definition.child(0).child(0).intValue() );
+
+        CPPUNIT_ASSERT_EQUAL( body(1).size(), checkConsistent( root ) );
+    }
+
+    void lazyBodies() {
+        // Bodies parsed when first asked for flatten the same as those parsed with the module
+        NonTerminals::Module lazy;
+        lazy.lazyFunctionBodies = true;
+        lazy.parse( Source );
+
+        CPPUNIT_ASSERT_EQUAL( module.functionDefinitions.size(), lazy.functionDefinitions.size() );
+        for( size_t i=0; i<module.functionDefinitions.size(); ++i ) {
+            const FlatTree &flattened = lazy.functionDefinitions[i].getFlatBody();
+            CPPUNIT_ASSERT_EQUAL( body(i).size(), flattened.size() );
+            CPPUNIT_ASSERT_EQUAL( body(i).size(), checkConsistent( flattened.root() ) );
+        }
+    }
+
+    static CppUnit::Test *suite()
+    {
+        CppUnit::TestSuite *suiteOfTests = new CppUnit::TestSuite( "FlatTreeTest" );
+        suiteOfTests->addTest( new CppUnit::TestCaller<FlatTreeTest>(
+                    "nestedExpression",
+                    &FlatTreeTest::nestedExpression ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<FlatTreeTest>(
+                    "nestedTypes",
+                    &FlatTreeTest::nestedTypes ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<FlatTreeTest>(
+                    "lazyBodies",
+                    &FlatTreeTest::lazyBodies ) );
+        return suiteOfTests;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( FlatTreeTest );
@@ -0,0 +1,143 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "parser/cache.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <unistd.h>
+
+class ModuleCacheTest : public CppUnit::TestFixture  {
+    static constexpr char Source[] =
+            "decl (\"C\") puts( s : C8@ ) -> S32;\n"
+            "struct Point { def x : S32; def y : S32; }\n"
+            "// Comment\n"
+            "def twice( a : S32 ) -> S32 {\n"
+            "    def b : S32 = a * 2;\n"
+            "    if( b > 10 ) { b } else { expect!S32( a + 0x10 ) }\n"
+            "}\n"
+            "def main() -> S32 {\n"
+            "    def x : S32 = 3;\n"
+            "    def p : S32@ = x&;\n"
+            "    def done : Bool = true;\n"
+            "    puts( \"text\" );\n"
+            "    if( !done ) { x = twice( p@ ); }\n"
+            "    x\n"
+            "}\n";
+
+    std::string directory;
+
+    std::string path(const char *name) const {
+        return directory + "/" + name;
+    }
+
+    static std::string readFile(const std::string &path) {
+        std::ifstream file( path, std::ios::binary );
+        return std::string( std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() );
+    }
+
+    static void writeFile(const std::string &path, const std::string &content) {
+        std::ofstream file( path, std::ios::binary | std::ios::trunc );
+        file.write( content.data(), content.size() );
+    }
+
+    // Save, load the image into a new module, and save that. Both images must be the same
+    void roundTrip(NonTerminals::Module &module) {
+        CPPUNIT_ASSERT( NonTerminals::ModuleCache::save( module, Source, path("original") ) );
+
+        NonTerminals::Module loaded;
+        CPPUNIT_ASSERT( NonTerminals::ModuleCache::load( loaded, Source, path("original") ) );
+        CPPUNIT_ASSERT( NonTerminals::ModuleCache::save( loaded, Source, path("loaded") ) );
+
+        std::string original = readFile( path("original") );
+        CPPUNIT_ASSERT( original.size()>0 );
+        CPPUNIT_ASSERT( original==readFile( path("loaded") ) );
+
+        CPPUNIT_ASSERT_EQUAL( module.functionDefinitions.size(), loaded.functionDefinitions.size() );
+        CPPUNIT_ASSERT_EQUAL( module.functionDeclarations.size(), loaded.functionDeclarations.size() );
+        CPPUNIT_ASSERT_EQUAL( module.structureDefinitions.size(), loaded.structureDefinitions.size() );
+    }
+
+public:
+    void setUp() override {
+        char name[] = "/tmp/practical_cache_ut.XXXXXX";
+        CPPUNIT_ASSERT( mkdtemp( name )!=nullptr );
+        directory = name;
+    }
+
+    void tearDown() override {
+        for( const char *name : { "original", "loaded", "damaged" } )
+            std::remove( path(name).c_str() );
+        rmdir( directory.c_str() );
+    }
+
+    void saveLoad() {
+        NonTerminals::Module module;
+        module.parse( Source );
+        roundTrip( module );
+    }
+
+    void saveLoadStreaming() {
+        NonTerminals::Module module;
+        module.parseStreaming( Source );
+        roundTrip( module );
+    }
+
+    void corruptImages() {
+        NonTerminals::Module module;
+        module.parse( Source );
+        CPPUNIT_ASSERT( NonTerminals::ModuleCache::save( module, Source, path("original") ) );
+        std::string image = readFile( path("original") );
+
+        // Any flipped word is rejected, as is any truncation
+        for( size_t i=0; i<image.size(); i+=sizeof(uint32_t) ) {
+            std::string damaged = image;
+            damaged[i] ^= 0x01;
+            writeFile( path("damaged"), damaged );
+
+            NonTerminals::Module loaded;
+            CPPUNIT_ASSERT_MESSAGE( "Damage at " + std::to_string(i) + " went unnoticed",
+                    !NonTerminals::ModuleCache::load( loaded, Source, path("damaged") ) );
+        }
+
+        for( size_t size : { size_t(0), image.size()/2, image.size()-sizeof(uint32_t) } ) {
+            writeFile( path("damaged"), image.substr( 0, size ) );
+
+            NonTerminals::Module loaded;
+            CPPUNIT_ASSERT( !NonTerminals::ModuleCache::load( loaded, Source, path("damaged") ) );
+        }
+
+        // An image is only good for the source it was made from
+        std::string otherSource = std::string(Source) + " ";
+        NonTerminals::Module loaded;
+        CPPUNIT_ASSERT( !NonTerminals::ModuleCache::load( loaded, otherSource, path("original") ) );
+    }
+
+    static CppUnit::Test *suite()
+    {
+        CppUnit::TestSuite *suiteOfTests = new CppUnit::TestSuite( "ModuleCacheTest" );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ModuleCacheTest>(
+                    "saveLoad",
+                    &ModuleCacheTest::saveLoad ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ModuleCacheTest>(
+                    "saveLoadStreaming",
+                    &ModuleCacheTest::saveLoadStreaming ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ModuleCacheTest>(
+                    "corruptImages",
+                    &ModuleCacheTest::corruptImages ) );
+        return suiteOfTests;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ModuleCacheTest );
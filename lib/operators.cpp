@@ -10,122 +10,140 @@
 
 #include "asserts.h"
 
+#include <iterator>
+#include <limits>
+
 using namespace Tokenizer;
 
 namespace Operators {
 
-const std::vector< OperatorPriority > operators = {
-    {
-        // 1
-        .kind = OperatorPriority::OpKind::Infix,
-        .operators = {
-            { Tokens::OP_DOUBLE_COLON, OperatorType::Regular }
-        }
-    },
-    {
-        // 2
-        .kind = OperatorPriority::OpKind::Postfix,
-        .operators = {
-            { Tokens::OP_PLUS_PLUS, OperatorType::Regular },
-            { Tokens::OP_MINUS_MINUS, OperatorType::Regular },
-            { Tokens::BRACKET_ROUND_OPEN, OperatorType::Function },
-            { Tokens::BRACKET_SQUARE_OPEN, OperatorType::SliceSubscript },
-            { Tokens::OP_DOT, OperatorType::Regular },
-            { Tokens::OP_ARROW, OperatorType::Regular },
-            { Tokens::OP_PTR, OperatorType::Regular },    // Pointer dereference
-            { Tokens::OP_AMPERSAND, OperatorType::Regular },   // Address of
-        }
-    },
-    {
-        // 3
-        .kind = OperatorPriority::OpKind::Prefix,
-        .operators = {
-            { Tokens::OP_PLUS_PLUS, OperatorType::Regular },
-            { Tokens::OP_MINUS_MINUS, OperatorType::Regular },
-            { Tokens::OP_PLUS, OperatorType::Regular },        // Unary plus
-            { Tokens::OP_MINUS, OperatorType::Regular },       // Unary minus
-            { Tokens::OP_BIT_NOT, OperatorType::Regular },
-            { Tokens::OP_LOGIC_NOT, OperatorType::Regular },
-            { Tokens::RESERVED_EXPECT, OperatorType::Cast },
-        }
-    },
-    {
-        // 5
-        .kind = OperatorPriority::OpKind::Infix,
-        .operators = {
-            { Tokens::OP_MULTIPLY, OperatorType::Regular },
-            { Tokens::OP_DIVIDE, OperatorType::Regular },
-            { Tokens::OP_MODULOUS, OperatorType::Regular },
-            { Tokens::OP_AMPERSAND, OperatorType::Regular },   // Bitwise AND
-        }
-    },
-    {
-        // 6
-        .kind = OperatorPriority::OpKind::Infix,
-        .operators = {
-            { Tokens::OP_PLUS, OperatorType::Regular },
-            { Tokens::OP_MINUS, OperatorType::Regular },
-            { Tokens::OP_BIT_OR, OperatorType::Regular },
-            { Tokens::OP_BIT_XOR, OperatorType::Regular },
-        }
-    },
-    {
-        // 7
-        .kind = OperatorPriority::OpKind::Infix,
-        .operators = {
-            { Tokens::OP_SHIFT_LEFT, OperatorType::Regular },
-            { Tokens::OP_SHIFT_RIGHT, OperatorType::Regular },
-        }
-    },
-    {
-        // 8
-        .kind = OperatorPriority::OpKind::Infix,
-        .operators = {
-            { Tokens::OP_LESS_THAN, OperatorType::Regular },
-            { Tokens::OP_LESS_THAN_EQ, OperatorType::Regular },
-            { Tokens::OP_GREATER_THAN, OperatorType::Regular },
-            { Tokens::OP_GREATER_THAN_EQ, OperatorType::Regular },
-        }
-    },
-    {
-        // 9
-        .kind = OperatorPriority::OpKind::Infix,
-        .operators = {
-            { Tokens::OP_EQUALS, OperatorType::Regular },
-            { Tokens::OP_NOT_EQUALS, OperatorType::Regular },
-        }
-    },
-    {
-        // 10
-        .kind = OperatorPriority::OpKind::Infix,
-        .operators = {
-            { Tokens::OP_LOGIC_AND, OperatorType::Regular },
-        }
-    },
-    {
-        // 11
-        .kind = OperatorPriority::OpKind::Infix,
-        .operators = {
-            { Tokens::OP_LOGIC_OR, OperatorType::Regular },
-        }
-    },
-    {
-        // 12
-        .kind = OperatorPriority::OpKind::InfixRight2Left,
-        .operators = {
-            { Tokens::OP_ASSIGN, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_PLUS, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_MINUS, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_MULTIPLY, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_DIVIDE, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_MODULOUS, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_LEFT_SHIFT, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_RIGHT_SHIFT, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_BIT_AND, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_BIT_OR, OperatorType::Regular },
-            { Tokens::OP_ASSIGN_BIT_XOR, OperatorType::Regular },
-        }
-    },
+static constexpr Operator precedence[] = {
+    { 1, OpKind::Infix, Tokens::OP_DOUBLE_COLON, OperatorType::Regular },
+
+    { 2, OpKind::Postfix, Tokens::OP_PLUS_PLUS, OperatorType::Regular },
+    { 2, OpKind::Postfix, Tokens::OP_MINUS_MINUS, OperatorType::Regular },
+    { 2, OpKind::Postfix, Tokens::BRACKET_ROUND_OPEN, OperatorType::Function },
+    { 2, OpKind::Postfix, Tokens::BRACKET_SQUARE_OPEN, OperatorType::SliceSubscript },
+    { 2, OpKind::Postfix, Tokens::OP_DOT, OperatorType::Regular },
+    { 2, OpKind::Postfix, Tokens::OP_ARROW, OperatorType::Regular },
+    { 2, OpKind::Postfix, Tokens::OP_PTR, OperatorType::Regular },          // Pointer dereference
+    { 2, OpKind::Postfix, Tokens::OP_AMPERSAND, OperatorType::Regular },    // Address of
+
+    { 3, OpKind::Prefix, Tokens::OP_PLUS_PLUS, OperatorType::Regular },
+    { 3, OpKind::Prefix, Tokens::OP_MINUS_MINUS, OperatorType::Regular },
+    { 3, OpKind::Prefix, Tokens::OP_PLUS, OperatorType::Regular },          // Unary plus
+    { 3, OpKind::Prefix, Tokens::OP_MINUS, OperatorType::Regular },         // Unary minus
+    { 3, OpKind::Prefix, Tokens::OP_BIT_NOT, OperatorType::Regular },
+    { 3, OpKind::Prefix, Tokens::OP_LOGIC_NOT, OperatorType::Regular },
+    { 3, OpKind::Prefix, Tokens::RESERVED_EXPECT, OperatorType::Cast },
+
+    { 4, OpKind::Infix, Tokens::OP_MULTIPLY, OperatorType::Regular },
+    { 4, OpKind::Infix, Tokens::OP_DIVIDE, OperatorType::Regular },
+    { 4, OpKind::Infix, Tokens::OP_MODULOUS, OperatorType::Regular },
+    { 4, OpKind::Infix, Tokens::OP_AMPERSAND, OperatorType::Regular },      // Bitwise AND
+
+    { 5, OpKind::Infix, Tokens::OP_PLUS, OperatorType::Regular },
+    { 5, OpKind::Infix, Tokens::OP_MINUS, OperatorType::Regular },
+    { 5, OpKind::Infix, Tokens::OP_BIT_OR, OperatorType::Regular },
+    { 5, OpKind::Infix, Tokens::OP_BIT_XOR, OperatorType::Regular },
+
+    { 6, OpKind::Infix, Tokens::OP_SHIFT_LEFT, OperatorType::Regular },
+    { 6, OpKind::Infix, Tokens::OP_SHIFT_RIGHT, OperatorType::Regular },
+
+    { 7, OpKind::Infix, Tokens::OP_LESS_THAN, OperatorType::Regular },
+    { 7, OpKind::Infix, Tokens::OP_LESS_THAN_EQ, OperatorType::Regular },
+    { 7, OpKind::Infix, Tokens::OP_GREATER_THAN, OperatorType::Regular },
+    { 7, OpKind::Infix, Tokens::OP_GREATER_THAN_EQ, OperatorType::Regular },
+
+    { 8, OpKind::Infix, Tokens::OP_EQUALS, OperatorType::Regular },
+    { 8, OpKind::Infix, Tokens::OP_NOT_EQUALS, OperatorType::Regular },
+
+    { 9, OpKind::Infix, Tokens::OP_LOGIC_AND, OperatorType::Regular },
+
+    { 10, OpKind::Infix, Tokens::OP_LOGIC_OR, OperatorType::Regular },
+
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_PLUS, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_MINUS, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_MULTIPLY, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_DIVIDE, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_MODULOUS, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_LEFT_SHIFT, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_RIGHT_SHIFT, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_BIT_AND, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_BIT_OR, OperatorType::Regular },
+    { 11, OpKind::InfixRight2Left, Tokens::OP_ASSIGN_BIT_XOR, OperatorType::Regular },
 };
 
+static constexpr size_t numLevels() {
+    size_t ret = 0;
+
+    for( const Operator &op : precedence ) {
+        if( op.level > ret )
+            ret = op.level;
+    }
+
+    return ret;
+}
+
+static constexpr size_t lowestPrefixLevel() {
+    size_t ret = std::numeric_limits<size_t>::max();
+
+    for( const Operator &op : precedence ) {
+        if( op.kind==OpKind::Prefix && op.level < ret )
+            ret = op.level;
+    }
+
+    return ret;
+}
+
+// Whether the table is sorted by level, and all operators of each level are of the same kind
+static constexpr bool wellFormed() {
+    for( size_t i=1; i<std::size(precedence); ++i ) {
+        if( precedence[i].level < precedence[i-1].level )
+            return false;
+        if( precedence[i].level==precedence[i-1].level && precedence[i].kind!=precedence[i-1].kind )
+            return false;
+    }
+
+    return true;
+}
+
+static constexpr size_t maxRoles() {
+    size_t ret = 0;
+
+    for( const Operator &op : precedence ) {
+        size_t roles = 0;
+        for( const Operator &other : precedence ) {
+            if( other.token==op.token )
+                roles++;
+        }
+
+        if( roles > ret )
+            ret = roles;
+    }
+
+    return ret;
+}
+
+static_assert( wellFormed(), "Operators must be listed by level, and all operators of a level must be of the same kind" );
+static_assert( maxRoles() <= Bindings::MaxRoles, "A token is more kinds of operator than Bindings has room for" );
+
+// Since the table is sorted, each token's roles end up tightest first
+static constexpr std::array<Bindings, NumTokens> generateBindings() {
+    std::array<Bindings, NumTokens> ret{};
+
+    for( const Operator &op : precedence ) {
+        Bindings &bindings = ret[ static_cast<size_t>(op.token) ];
+        bindings.roles[ bindings.numRoles++ ] = op;
+    }
+
+    return ret;
+}
+
+const size_t NumLevels = numLevels();
+const size_t LowestPrefixLevel = lowestPrefixLevel();
+
+constexpr std::array<Bindings, NumTokens> bindingPowers = generateBindings();
+
 } // Namespace Operators
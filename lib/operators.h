@@ -11,23 +11,67 @@
 
 #include "tokenizer.h"
 
-#include <practical/slice.h>
-
-#include <unordered_map>
-#include <vector>
+#include <array>
 
 namespace Operators {
 
 enum class OperatorType { Regular, Function, SliceSubscript, Cast };
 
-struct OperatorPriority {
-    enum class OpKind { Prefix, Infix, InfixRight2Left, Postfix } kind;
+enum class OpKind { Prefix, Infix, InfixRight2Left, Postfix };
+
+struct Operator {
+    // Operators of lower levels bind tighter. All operators of a level are of the same kind
+    size_t level;
+    OpKind kind;
+    Tokenizer::Tokens token;
+    OperatorType type;
+};
+
+// Expressions with no explicit level may use the operators of all levels
+extern const size_t NumLevels;
+// Operands that may use operators of this level or above may start with a prefix operator
+extern const size_t LowestPrefixLevel;
+
+// All of the operators a single token may be, by level
+struct Bindings {
+    static constexpr size_t MaxRoles = 2;
+
+    std::array<Operator, MaxRoles> roles{};
+    size_t numRoles = 0;
 
-    using OperatorsMap = std::unordered_map< Tokenizer::Tokens, OperatorType >;
-    OperatorsMap operators;
+    // The prefix operator a token is when starting an operand that may use operators up to `level`. nullptr if none
+    const Operator *prefix(size_t level) const {
+        const Operator *ret = nullptr;
+
+        for( size_t i=0; i<numRoles && roles[i].level<=level; ++i ) {
+            if( roles[i].kind==OpKind::Prefix )
+                ret = &roles[i];
+        }
+
+        return ret;
+    }
+
+    // The operator a token is when following an operand whose operators are all of level `minLevel` or above. As
+    // prefix operators do not follow anything, this is the tightest non-prefix operator of at least that level
+    const Operator *following(size_t minLevel) const {
+        for( size_t i=0; i<numRoles; ++i ) {
+            if( roles[i].level>=minLevel && roles[i].kind!=OpKind::Prefix )
+                return &roles[i];
+        }
+
+        return nullptr;
+    }
 };
 
-extern const std::vector< OperatorPriority > operators;
+// Tokens::RESERVED_STRUCT is the last token
+static constexpr size_t NumTokens = static_cast<size_t>(Tokenizer::Tokens::RESERVED_STRUCT) + 1;
+
+// Binding powers of all tokens, generated at compile time from the precedence table
+extern const std::array<Bindings, NumTokens> bindingPowers;
+
+static inline const Bindings &bindings(Tokenizer::Tokens token) {
+    return bindingPowers[ static_cast<size_t>(token) ];
+}
 
 } // Namespace Operators
 
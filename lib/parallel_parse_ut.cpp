@@ -0,0 +1,154 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "parser/cache.h"
+
+#include <practical/errors.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <unistd.h>
+
+class ParallelParseTest : public CppUnit::TestFixture  {
+    static constexpr unsigned ThreadCounts[] = { 2, 3, 8 };
+
+    std::string directory;
+
+    std::string path(const char *name) const {
+        return directory + "/" + name;
+    }
+
+    static std::string readFile(const std::string &path) {
+        std::ifstream file( path, std::ios::binary );
+        return std::string( std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() );
+    }
+
+    // Many small definitions, so that there are more of them than threads
+    static std::string program() {
+        std::string ret =
+                "decl (\"C\") puts( s : C8@ ) -> S32;\n"
+                "struct Point { def x : S32; def y : S32; }\n";
+
+        for( unsigned i=0; i<40; ++i ) {
+            std::string name = "f" + std::to_string(i);
+            ret += "def " + name + "( a : S32 ) -> S32 {\n"
+                    "    def b : S32 = a * " + std::to_string(i) + ";\n"
+                    "    if( b > 10 ) { b; } else { puts( \"text;}\" ); }\n"
+                    "    (if( b > 2 ) { b - 1 } else { expect!S32( a + 0x10 ) })\n"
+                    "}\n";
+            if( i%5==0 )
+                ret += "decl " + name + "_decl( p : S32[3]@ );\n";
+        }
+
+        return ret;
+    }
+
+    // The parallel parse must leave the same parse tree as the sequential one. Compare the images the module cache
+    // writes for them, which hold all of it
+    void checkSame(const std::string &source, unsigned threads) {
+        NonTerminals::Module sequential;
+        sequential.parse( source );
+        CPPUNIT_ASSERT( NonTerminals::ModuleCache::save( sequential, source, path("sequential") ) );
+
+        NonTerminals::Module parallel;
+        parallel.parseParallel( source, threads );
+        CPPUNIT_ASSERT( NonTerminals::ModuleCache::save( parallel, source, path("parallel") ) );
+
+        CPPUNIT_ASSERT_EQUAL( sequential.functionDefinitions.size(), parallel.functionDefinitions.size() );
+        CPPUNIT_ASSERT_EQUAL( sequential.functionDeclarations.size(), parallel.functionDeclarations.size() );
+        CPPUNIT_ASSERT_EQUAL( sequential.structureDefinitions.size(), parallel.structureDefinitions.size() );
+        for( size_t i=0; i<sequential.functionDefinitions.size(); ++i ) {
+            CPPUNIT_ASSERT_EQUAL(
+                    sliceToString( sequential.functionDefinitions[i].getName() ),
+                    sliceToString( parallel.functionDefinitions[i].getName() ) );
+        }
+
+        std::string image = readFile( path("sequential") );
+        CPPUNIT_ASSERT( image.size()>0 );
+        CPPUNIT_ASSERT( image==readFile( path("parallel") ) );
+    }
+
+    static std::string errorOf(const std::string &source, unsigned threads) {
+        NonTerminals::Module module;
+        try {
+            if( threads==0 )
+                module.parse( source );
+            else
+                module.parseParallel( source, threads );
+        } catch( PracticalSemanticAnalyzer::compile_error &error ) {
+            return error.what();
+        }
+
+        CPPUNIT_FAIL( "Source parsed with no error: " + source );
+    }
+
+public:
+    void setUp() override {
+        char name[] = "/tmp/practical_parallel_ut.XXXXXX";
+        CPPUNIT_ASSERT( mkdtemp( name )!=nullptr );
+        directory = name;
+    }
+
+    void tearDown() override {
+        for( const char *name : { "sequential", "parallel" } )
+            std::remove( path(name).c_str() );
+        rmdir( directory.c_str() );
+    }
+
+    void sameDefinitions() {
+        std::string source = program();
+        for( unsigned threads : ThreadCounts )
+            checkSame( source, threads );
+
+        // Fewer definitions than threads
+        checkSame( "def main() -> S32 { 0 }\n", 8 );
+        checkSame( "decl f();\ndef main() -> S32 { 0 }\n", 8 );
+    }
+
+    void sameErrors() {
+        std::string good = program();
+        const std::string sources[] = {
+            // In the middle of the program
+            good + "def broken( a : S32 ) -> S32 { a + }\n" + good,
+            // Not a definition
+            good + "5;\n" + good,
+            // Unbalanced brackets throw off finding where definitions end
+            good + "def open( a : S32 ) -> S32 { (a }\n" + good,
+            good + "def closed( a : S32 ) -> S32 { a) }\n" + good,
+            // Definitions that end where none was expected
+            good + "struct Point { def x : S32 }\n",
+            good + "def f() -> S32 { 1 };\n",
+            "def main() -> S32 {",
+        };
+
+        for( const std::string &source : sources ) {
+            std::string expected = errorOf( source, 0 );
+            for( unsigned threads : ThreadCounts )
+                CPPUNIT_ASSERT_EQUAL( expected, errorOf( source, threads ) );
+        }
+    }
+
+    static CppUnit::Test *suite()
+    {
+        CppUnit::TestSuite *suiteOfTests = new CppUnit::TestSuite( "ParallelParseTest" );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ParallelParseTest>(
+                    "sameDefinitions",
+                    &ParallelParseTest::sameDefinitions ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<ParallelParseTest>(
+                    "sameErrors",
+                    &ParallelParseTest::sameErrors ) );
+        return suiteOfTests;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ParallelParseTest );
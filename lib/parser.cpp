@@ -8,6 +8,7 @@
  */
 #include "parser.h"
 
+#include "parser/flat_tree.h"
 #include "parser_internal.h"
 #include "scope_tracing.h"
 
@@ -17,30 +18,33 @@ using namespace InternalNonTerminals;
 
 namespace NonTerminals {
 
-size_t TransientType::parse(Slice<const Tokenizer::Token> source) {
+ParseResult TransientType::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    tokensConsumed = type.parse(source);
+    RULE_PARSE( type.tryParse(source) );
 
     ref = wishForToken( Tokenizer::Tokens::RESERVED_REF, source, tokensConsumed, true );
 
     RULE_LEAVE();
 }
 
-size_t LiteralPointer::parse(Slice<const Tokenizer::Token> source) {
+ParseResult LiteralPointer::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    token = &expectToken(
+    RULE_CHECK( expectToken(
             Tokenizer::Tokens::RESERVED_NULL, source, tokensConsumed,
-            "Expected null literal", "EOF while parsing literal");
+            "Expected null literal", "EOF while parsing literal") );
+    token = &source[tokensConsumed-1];
 
     RULE_LEAVE();
 }
 
-size_t Literal::parse(Slice<const Tokenizer::Token> source) {
+ParseResult Literal::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    const Tokenizer::Token *currentToken = nextToken(source, tokensConsumed, "EOF while parsing literal");
+    const Tokenizer::Token *currentToken = nextToken(source, tokensConsumed);
+    if( currentToken==nullptr )
+        RULE_FAIL("EOF while parsing literal", SourceLocation());
 
     NonTerminal *underlyingLiteral = nullptr;
 
@@ -65,12 +69,12 @@ size_t Literal::parse(Slice<const Tokenizer::Token> source) {
         underlyingLiteral = &literal.emplace<LiteralPointer>();
         break;
     default:
-        throw parser_error("Not a literal", currentToken->location);
+        RULE_FAIL("Not a literal", currentToken->location);
     }
 
     ASSERT( tokensConsumed>0 );
     tokensConsumed--;
-    tokensConsumed += underlyingLiteral->parse( source.subslice(tokensConsumed) );
+    RULE_PARSE( underlyingLiteral->tryParse( source.subslice(tokensConsumed) ) );
 
     RULE_LEAVE();
 }
@@ -98,7 +102,7 @@ SourceLocation Literal::getLocation() const {
     return std::visit( Visitor{}, literal );
 }
 
-size_t FunctionArguments::parse(Slice<const Tokenizer::Token> source) {
+ParseResult FunctionArguments::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
     bool firstArgument = true;
@@ -106,189 +110,295 @@ size_t FunctionArguments::parse(Slice<const Tokenizer::Token> source) {
         if( firstArgument ) {
             firstArgument = false;
         } else {
-            expectToken(
+            RULE_CHECK( expectToken(
                     Tokenizer::Tokens::COMMA, source, tokensConsumed, "Function argument list needs to be delimited by commas",
-                    "EOF while scanning arguments list" );
+                    "EOF while scanning arguments list" ) );
         }
 
         Expression *argument = &arguments.emplace_back();
-        tokensConsumed += argument->parse( source.subslice(tokensConsumed) );
+        RULE_PARSE( argument->tryParse( source.subslice(tokensConsumed) ) );
     }
 
     RULE_LEAVE();
 }
 
-size_t Expression::parse(Slice<const Tokenizer::Token> source) {
+ParseResult Expression::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    if( wishForToken(Tokenizer::Tokens::RESERVED_IF, source, tokensConsumed) ) {
+    RULE_PARSE( ParseMemo::parse(
+            ParseMemo::Rule::Expression, *this, source, [&]() { return parseFresh(source); } ) );
+
+    RULE_LEAVE();
+}
+
+ParseResult Expression::parseFresh(Slice<const Tokenizer::Token> source) {
+    RULE_ENTER(source);
+
+    if( wishForToken(Tokenizer::Tokens::RESERVED_IF, source, tokensConsumed, false) ) {
         ConditionalExpressionOrStatement condition;
-        tokensConsumed = condition.parse( source, ExpectedResult::Expression );
+        RULE_PARSE( condition.tryParse( source, ExpectedResult::Expression ) );
 
-        value = safenew<ConditionalExpression>( condition.removeExpression() );
+        value = newNode<ConditionalExpression>( condition.removeExpression() );
 
         RULE_LEAVE();
     }
 
-    tokensConsumed=0;
-    if( wishForToken(Tokenizer::Tokens::BRACKET_CURLY_OPEN, source, tokensConsumed) ) {
+    if( wishForToken(Tokenizer::Tokens::BRACKET_CURLY_OPEN, source, tokensConsumed, false) ) {
         CompoundExpression compound;
-        tokensConsumed=compound.parse(source);
+        RULE_PARSE( compound.tryParse(source) );
 
-        value = safenew<CompoundExpression>( std::move(compound) );
+        value = newNode<CompoundExpression>( std::move(compound) );
 
         RULE_LEAVE();
     }
 
-    std::exception_ptr expressionParseError;
-    try {
-        tokensConsumed = actualParse(source, Operators::operators.size());
+    // An identifier followed by `@`s is both a type and the start of an expression. Parse it once, as a type, and carry
+    // on from there as an expression. What is a type and nothing more is the type
+    Type type;
+    ParseResult typeResult = type.tryParse(source);
+    if( !typeResult ) {
+        FAILURE_CAUGHT(typeResult);
+        RULE_PARSE( actualParse(source, Operators::NumLevels) );
+
         RULE_LEAVE();
-    } catch( parser_error &error ) {
-        EXCEPTION_CAUGHT(error);
-        expressionParseError = std::current_exception();
     }
 
-    try {
-        Type *type = &value.emplace<Type>();
-        tokensConsumed = type->parse(source);
-    } catch( parser_error &error ) {
-        EXCEPTION_CAUGHT(error);
-        // We only tried to parse as type as a hail Mary. If it failed, we want the original error
-        std::rethrow_exception(expressionParseError);
+    size_t minLevel = 0;
+    if( fromType( type, source, minLevel ) ) {
+        ParseResult expressionResult = parseOperators(source, typeResult.consumed(), Operators::NumLevels, minLevel);
+        if( expressionResult ) {
+            tokensConsumed = expressionResult.consumed();
+            RULE_LEAVE();
+        }
+        FAILURE_CAUGHT(expressionResult);
     }
 
+    value = std::move(type);
+    tokensConsumed = typeResult.consumed();
     RULE_LEAVE();
 }
 
-const Type *Expression::reparseAsType() const {
-    const Type *ret = std::get_if<NonTerminals::Type>( &value );
+bool Expression::fromType(const Type &type, Slice<const Tokenizer::Token> source, size_t &minLevel) {
+    if( const Identifier *identifier = std::get_if<Identifier>( &type.type ) ) {
+        value = *identifier;
+        parsedSlice = identifier->getNTTokens();
+        minLevel = 1;
 
-    if( ret!=nullptr ) {
-        return ret;
+        return true;
     }
 
-    if( !altTypeParse ) {
-        altTypeParse = safenew<NonTerminals::Type>();
+    // Arrays would be subscripts, which expressions do not parse yet
+    const Type::Pointer *pointer = std::get_if<Type::Pointer>( &type.type );
+    if( pointer==nullptr )
+        return false;
 
-        size_t tokensConsumed = altTypeParse->parse( getNTTokens() );
-        if( tokensConsumed != getNTTokens().size() ) {
-            ASSERT( tokensConsumed < getNTTokens().size() ) <<
-                    "Undetected range error during parse: " << tokensConsumed << "<" << getNTTokens().size();
-            const Tokenizer::Token *currentToken = &getNTTokens()[ tokensConsumed ];
-            throw parser_error("Type parsing did not consume entire range", currentToken->location);
-        }
+    UnaryOperator dereference;
+    dereference.op = pointer->token;
+    dereference.operand = newNode<Expression>();
+    if( !dereference.operand->fromType( *pointer->pointed, source, minLevel ) )
+        return false;
+
+    value = std::move(dereference);
+    parsedSlice = source.subslice( 0, pointer->token - source.get() + 1 );
+    minLevel = Operators::bindings( pointer->token->token ).following( minLevel )->level;
+
+    return true;
+}
+
+/*
+ * Precedence climbing. Once the first operand is parsed, each iteration of the loop extends what we have so far with one
+ * more operator.
+ *
+ * minLevel is the level of the loosest operator applied so far. An operator that binds tighter than that cannot be applied
+ * to what we have, only to part of it, and so is not ours to parse. The exception is prefix operators, which are part of
+ * parsing the operand.
+ */
+ParseResult Expression::actualParse(Slice<const Tokenizer::Token> source, size_t level) {
+    using namespace Operators;
+
+    RULE_ENTER(source);
+
+    size_t provisionalTokensConsumed = 0;
+    const Tokenizer::Token *token = nextToken( source, provisionalTokensConsumed );
+    if( token==nullptr && level>=LowestPrefixLevel )
+        RULE_FAIL("End of file while looking for operator", SourceLocation());
+
+    size_t minLevel = 1;
+    const Operator *prefix = token!=nullptr ? bindings( token->token ).prefix( level ) : nullptr;
+    if( prefix!=nullptr ) {
+        RULE_PARSE( parsePrefixOp( source, prefix->level ) );
+        minLevel = prefix->level + 1;
+    } else {
+        RULE_PARSE( basicParse( source ) );
     }
 
-    return altTypeParse.get();
+    ParseResult result = parseOperators( source, tokensConsumed, level, minLevel );
+    if( !result )
+        RULE_FAILED(result);
+    tokensConsumed = result.consumed();
+
+    RULE_LEAVE();
 }
 
-size_t Expression::actualParse(Slice<const Tokenizer::Token> source, size_t level) {
+ParseResult Expression::parseOperators(
+        Slice<const Tokenizer::Token> source, size_t operandTokens, size_t level, size_t minLevel)
+{
     using namespace Operators;
 
     RULE_ENTER(source);
+    tokensConsumed = operandTokens;
 
-    if( level==0 ) {
-        tokensConsumed += basicParse(source);
+    while( true ) {
+        const size_t operandTokens = tokensConsumed;
 
-        RULE_LEAVE();
-    }
+        size_t provisionalTokensConsumed = tokensConsumed;
+        const Tokenizer::Token *op = nextToken( source, provisionalTokensConsumed );
+        if( op==nullptr )
+            break;
 
-    // Operators
-    const OperatorPriority &priority = operators.at( level-1 );
+        const Operator *opInfo = bindings( op->token ).following( minLevel );
+        if( opInfo==nullptr || opInfo->level>level ) {
+            // This is not the operator you're looking for. Just make do with what we have without it
+            break;
+        }
 
-    switch( priority.kind ) {
-    case OperatorPriority::OpKind::Prefix:
-        tokensConsumed += parsePrefixOp( source, level, priority.operators );
-        break;
-    case OperatorPriority::OpKind::Infix:
-        tokensConsumed += parseInfixOp( source, level, priority.operators );
-        break;
-    case OperatorPriority::OpKind::InfixRight2Left:
-        tokensConsumed += parseInfixR2LOp( source, level, priority.operators );
-        break;
-    case OperatorPriority::OpKind::Postfix:
-        tokensConsumed += parsePostfixOp( source, level, priority.operators );
-        break;
+        tokensConsumed = provisionalTokensConsumed;
+        minLevel = opInfo->level;
+
+        // What we have so far becomes the operator's (first) operand
+        auto operand = newNode< Expression >( std::move(*this) );
+        operand->parsedSlice = source.subslice( 0, operandTokens );
+
+        switch( opInfo->kind ) {
+        case OpKind::Infix:
+        case OpKind::InfixRight2Left:
+            {
+                ASSERT( opInfo->type==OperatorType::Regular );
+
+                BinaryOperator binary;
+                binary.op = op;
+                binary.operands[0] = std::move(operand);
+                binary.operands[1] = newNode< Expression >();
+
+                // A left to right operator's second operand stops short of operators of its own level, so the next
+                // one applies to the result. A right to left operator's second operand takes them, and so applies them
+                // first.
+                size_t operandLevel = opInfo->kind==OpKind::Infix ? opInfo->level-1 : opInfo->level;
+                RULE_PARSE( binary.operands[1]->actualParse( source.subslice(tokensConsumed), operandLevel ) );
+
+                value = std::move(binary);
+            }
+            break;
+        case OpKind::Postfix:
+            switch( opInfo->type ) {
+            case OperatorType::Regular:
+                {
+                    UnaryOperator unary;
+                    unary.op = op;
+                    unary.operand = std::move(operand);
+
+                    value = std::move(unary);
+                }
+                break;
+            case OperatorType::Function:
+                {
+                    FunctionCall funcCall;
+                    funcCall.op = op;
+                    funcCall.expression = std::move(operand);
+                    RULE_PARSE( funcCall.arguments.tryParse( source.subslice(tokensConsumed) ) );
+
+                    value = std::move( funcCall );
+                }
+                break;
+            case OperatorType::SliceSubscript:
+                ABORT() << "TODO implement";
+            case OperatorType::Cast:
+                ABORT() << "Cast is not a postfix operator";
+            }
+            break;
+        case OpKind::Prefix:
+            ABORT() << "Prefix operator following an operand";
+        }
     }
 
     RULE_LEAVE();
 }
 
-size_t Expression::basicParse(Slice<const Tokenizer::Token> source) {
+ParseResult Expression::basicParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
     // Parenthesis around expression?
     if( wishForToken( Tokenizer::Tokens::BRACKET_ROUND_OPEN, source, tokensConsumed ) ) {
-        tokensConsumed += parse( source.subslice(tokensConsumed) );
-        expectToken( Tokenizer::Tokens::BRACKET_ROUND_CLOSE, source, tokensConsumed, "Unmatched (", "EOF searching for )" );
+        RULE_PARSE( tryParse( source.subslice(tokensConsumed) ) );
+        RULE_CHECK( expectToken(
+                Tokenizer::Tokens::BRACKET_ROUND_CLOSE, source, tokensConsumed, "Unmatched (", "EOF searching for )" ) );
 
         RULE_LEAVE();
     }
 
-    try {
-        // Maybe an identifier
-        tokensConsumed += value.emplace<Identifier>().parse(source);
+    // Maybe an identifier
+    ParseResult identifierResult = value.emplace<Identifier>().tryParse(source);
+    if( identifierResult ) {
+        tokensConsumed += identifierResult.consumed();
 
         RULE_LEAVE();
-    } catch( parser_error &err ) {
-        EXCEPTION_CAUGHT(err);
     }
+    FAILURE_CAUGHT(identifierResult);
 
     // Or maybe a Literal
-    tokensConsumed = value.emplace<Literal>().parse(source);
+    RULE_PARSE( value.emplace<Literal>().tryParse(source) );
 
     RULE_LEAVE();
 }
 
-size_t Expression::parsePrefixOp(
-        Slice<const Tokenizer::Token> source, size_t level, const Operators::OperatorPriority::OperatorsMap &operators)
-{
+ParseResult Expression::parsePrefixOp(Slice<const Tokenizer::Token> source, size_t level) {
     RULE_ENTER(source);
 
-    const Tokenizer::Token *op =nextToken( source, tokensConsumed, "End of file while looking for operator" );
+    const Tokenizer::Token *op =nextToken( source, tokensConsumed );
+    if( op==nullptr )
+        RULE_FAIL("End of file while looking for operator", SourceLocation());
 
-    auto operatorInfo = operators.find( op->token );
+    const Operators::Operator *operatorInfo = Operators::bindings( op->token ).prefix( level );
 
-    if( operatorInfo!=operators.end() ) {
-        switch( operatorInfo->second ) {
+    if( operatorInfo!=nullptr && operatorInfo->level==level ) {
+        switch( operatorInfo->type ) {
         case Operators::OperatorType::Regular:
             {
                 UnaryOperator &op1 = value.emplace< UnaryOperator >();
                 op1.op = op;
                 // The operator we found is a valid prefix operator for this level
-                op1.operand = safenew< Expression >();
-                tokensConsumed += op1.operand->parsePrefixOp( source.subslice(tokensConsumed), level, operators );
+                op1.operand = newNode< Expression >();
+                RULE_PARSE( op1.operand->parsePrefixOp( source.subslice(tokensConsumed), level ) );
             }
             RULE_LEAVE();
         case Operators::OperatorType::Cast:
             {
                 CastOperator &cast = value.emplace< CastOperator >();
                 cast.op = op;
-                expectToken(
+                RULE_CHECK( expectToken(
                         Tokenizer::Tokens::OP_TEMPLATE_EXPAND,
                         source,
                         tokensConsumed,
                         "Cast operator must be followed by `!`",
                         "End of file looking for cast expression"
-                );
-                tokensConsumed += cast.destType.parse( source.subslice(tokensConsumed) );
-                expectToken(
+                ) );
+                RULE_PARSE( cast.destType.tryParse( source.subslice(tokensConsumed) ) );
+                RULE_CHECK( expectToken(
                         Tokenizer::Tokens::BRACKET_ROUND_OPEN,
                         source,
                         tokensConsumed,
                         "Expected `(` after cast type",
                         "End of file looking for cast expression"
-                );
-                cast.expression = safenew< Expression >();
-                tokensConsumed += cast.expression->parse( source.subslice( tokensConsumed ) );
-                expectToken(
+                ) );
+                cast.expression = newNode< Expression >();
+                RULE_PARSE( cast.expression->tryParse( source.subslice( tokensConsumed ) ) );
+                RULE_CHECK( expectToken(
                         Tokenizer::Tokens::BRACKET_ROUND_CLOSE,
                         source,
                         tokensConsumed,
                         "Expected ')'",
                         "End of file looking for terminating ')'"
-                );
+                ) );
             }
             RULE_LEAVE();
         default:
@@ -296,168 +406,42 @@ size_t Expression::parsePrefixOp(
         }
     }
 
-    // The use of = instead of += undoes the call to "nextToken" above, as does the use of "source" with no subslicing
-    tokensConsumed = actualParse( source, level-1 );
+    // Resetting tokensConsumed undoes the call to "nextToken" above, as does the use of "source" with no subslicing
+    tokensConsumed = 0;
+    RULE_PARSE( actualParse( source, level-1 ) );
 
     RULE_LEAVE();
 }
 
-size_t Expression::parseInfixOp(
-        Slice<const Tokenizer::Token> source, size_t level, const Operators::OperatorPriority::OperatorsMap &operators)
-{
+ParseResult Statement::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    /*
-     * In regular grammer, this rule should say ExpressionN (where N is the level) -> ExpressionN OP ExpressionN-1
-     * The direct translation to code of the above is to start by calling op.operands[0]->actualParse( source, level )
-     * Doing this will result in an unterminated recursion (calling ourselves with the precise same arguments).
-     *
-     * Instead, We're parsing ExpressionN -> ExpressionN-1 OP ExpressionN-1, and if the next token after we're done is an operator
-     * of our level, we incorporate that entire previous expression as the right hand side of the higher expression.
-     *
-     * Rinse, repeat, and we've translated the recursive definition into a loop.
-     *
-     * One side effect is that the same operator cannot be used as binary operator in different levels. THAT IS A GOOD THING!
-     */
-
-    BinaryOperator op;
-    op.operands[0] = safenew<Expression>();
-    tokensConsumed = op.operands[0]->actualParse( source, level-1 );
-
-    size_t provisionalTokensConsumed = tokensConsumed;
-    op.op = nextToken( source, provisionalTokensConsumed );
-    if( op.op==nullptr ) {
-        *this = std::move(* op.operands[0]);
-        RULE_LEAVE();
-    }
-
-    auto opInfo = operators.find(op.op->token);
-    if( opInfo==operators.end() ) {
-        // This is not the operator you're looking for. Just make do with what we have without it
-        *this = std::move(* op.operands[0]);
-        RULE_LEAVE();
-    }
-
-    ASSERT( opInfo->second==Operators::OperatorType::Regular );
-    tokensConsumed = provisionalTokensConsumed;
-
-    op.operands[1] = safenew< Expression >();
-    tokensConsumed += op.operands[1]->actualParse( source.subslice(tokensConsumed), level-1 );
-
-    while( true ) {
-        BinaryOperator op2;
-
-        // If the next token is an operator of this level, we need to extend our parse tree to cover it as well
-        provisionalTokensConsumed = tokensConsumed;
-        op2.op = nextToken( source, provisionalTokensConsumed );
-        if( op2.op==nullptr || operators.find( op2.op->token ) == operators.end() ) {
-            break;
-        }
-
-        // Commit to extending
-        tokensConsumed = provisionalTokensConsumed;
-        op2.operands[0] = safenew< Expression >();
-        op2.operands[0]->value = std::move( op );
-        op = std::move( op2 );
-
-        op.operands[1] = safenew< Expression >();
-        tokensConsumed += op.operands[1]->actualParse( source.subslice( tokensConsumed ), level-1 );
-    }
-
-    value = std::move(op);
+    RULE_PARSE( ParseMemo::parse(
+            ParseMemo::Rule::Statement, *this, source, [&]() { return parseFresh(source); } ) );
 
     RULE_LEAVE();
 }
 
-size_t Expression::parseInfixR2LOp(
-        Slice<const Tokenizer::Token> source, size_t level, const Operators::OperatorPriority::OperatorsMap &operators)
-{
-    RULE_ENTER(source);
-
-    BinaryOperator op;
-    op.operands[0] = safenew< Expression >();
-    tokensConsumed += op.operands[0]->actualParse( source, level-1 );
+// A statement that turned out to be an expression with no semicolon after it is most likely the value of the enclosing
+// compound expression, which is about to parse the same expression again
+static ParseResult expectSemicolon(Slice<const Tokenizer::Token> source, size_t &tokensConsumed, Expression &expression) {
+    const size_t expressionTokens = tokensConsumed;
 
-    size_t provisionalTokensConsumed = tokensConsumed;
-    op.op = nextToken( source, provisionalTokensConsumed );
-    if( op.op==nullptr ) {
-        *this = std::move(* op.operands[0]);
-        RULE_LEAVE();
-    }
-
-    auto opInfo = operators.find(op.op->token);
-    if( opInfo==operators.end() ) {
-        // This is not the operator you're looking for. Just make do with what we have without it
-        *this = std::move(* op.operands[0]);
-        RULE_LEAVE();
-    }
-    ASSERT( opInfo->second==Operators::OperatorType::Regular );
-
-    tokensConsumed = provisionalTokensConsumed;
-
-    op.operands[1] = safenew< Expression >();
-    tokensConsumed += op.operands[1]->actualParse( source.subslice(tokensConsumed), level );
-
-    value = std::move( op );
-
-    RULE_LEAVE();
-}
-
-size_t Expression::parsePostfixOp(
-        Slice<const Tokenizer::Token> source, size_t level, const Operators::OperatorPriority::OperatorsMap &operators)
-{
-    RULE_ENTER(source);
-
-    tokensConsumed = actualParse( source, level-1 );
-
-    UnaryOperator op;
-    size_t provisionalTokensConsumed = tokensConsumed;
-    op.op = nextToken( source, provisionalTokensConsumed );
-    if( op.op==nullptr ) {
-        RULE_LEAVE();
-    }
-
-    auto opInfo = operators.find( op.op->token );
-    while( opInfo!=operators.end() ) {
-        tokensConsumed = provisionalTokensConsumed;
-
-        switch( opInfo->second ) {
-        case Operators::OperatorType::Regular:
-            op.operand = safenew< Expression >( std::move( *this ) );
-            value = std::move( op );
-            ASSERT( ! op.operand );
-            break;
-        case Operators::OperatorType::Function:
-            {
-                FunctionCall funcCall;
-                funcCall.op = op.op;
-                funcCall.expression = safenew< Expression >( std::move( *this ) );
-                tokensConsumed += funcCall.arguments.parse( source.subslice(tokensConsumed) );
-                value = std::move( funcCall );
-            }
-            break;
-        case Operators::OperatorType::SliceSubscript:
-            ABORT() << "TODO implement";
-        case Operators::OperatorType::Cast:
-            ABORT() << "Cast is not a postfix operator";
-        }
-
-        provisionalTokensConsumed = tokensConsumed;
-        op.op = nextToken( source, provisionalTokensConsumed );
-        if( op.op==nullptr )
-            break;
-        opInfo = operators.find( op.op->token );
-    }
+    ParseResult result = expectToken(
+            Tokenizer::Tokens::SEMICOLON, source, tokensConsumed, "Statement does not end with a semicolon",
+            "Unexpected EOF" );
+    if( !result )
+        ParseMemo::keep( ParseMemo::Rule::Expression, source, expressionTokens, std::move(expression) );
 
-    RULE_LEAVE();
+    return result;
 }
 
-size_t Statement::parse(Slice<const Tokenizer::Token> source) {
+ParseResult Statement::parseFresh(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
     ConditionalExpressionOrStatement condition;
-    if( wishForToken(Tokenizer::Tokens::RESERVED_IF, source, tokensConsumed) ) {
-        tokensConsumed = condition.parse(source);
+    if( wishForToken(Tokenizer::Tokens::RESERVED_IF, source, tokensConsumed, false) ) {
+        RULE_PARSE( condition.tryParse(source) );
         if( condition.isStatement() ) {
             content = condition.removeStatement();
         } else {
@@ -465,8 +449,7 @@ size_t Statement::parse(Slice<const Tokenizer::Token> source) {
             // XXX Don't handle conditional expression that is part of a larger expression
             //tokensConsumed += expression.continueParse( source.subslice(tokensConsumed) );
 
-            expectToken( Tokenizer::Tokens::SEMICOLON, source, tokensConsumed, "Statement does not end with a semicolon",
-                    "Unexpected EOF" );
+            RULE_CHECK( expectSemicolon( source, tokensConsumed, expression ) );
 
             content = std::move(expression);
         }
@@ -474,119 +457,124 @@ size_t Statement::parse(Slice<const Tokenizer::Token> source) {
         RULE_LEAVE();
     }
 
-    tokensConsumed=0;
-    if( wishForToken(Tokenizer::Tokens::BRACKET_CURLY_OPEN, source, tokensConsumed) ) {
+    if( wishForToken(Tokenizer::Tokens::BRACKET_CURLY_OPEN, source, tokensConsumed, false) ) {
         CompoundStatement compound;
-        tokensConsumed=compound.parse(source);
+        RULE_PARSE( compound.tryParse(source) );
 
-        content = safenew<CompoundStatement>( std::move(compound) );
+        content = newNode<CompoundStatement>( std::move(compound) );
 
         RULE_LEAVE();
     }
 
-    try {
+    {
         Expression expression;
 
-        tokensConsumed = expression.parse(source);
+        ParseResult result = expression.tryParse(source);
+        if( result ) {
+            tokensConsumed = result.consumed();
+            result = expectSemicolon( source, tokensConsumed, expression );
+        }
 
-        expectToken( Tokenizer::Tokens::SEMICOLON, source, tokensConsumed, "Statement does not end with a semicolon",
-                "Unexpected EOF" );
+        if( result ) {
+            content = std::move(expression);
 
-        content = std::move(expression);
+            RULE_LEAVE();
+        }
 
-        RULE_LEAVE();
-    } catch( parser_error &err ) {
-        EXCEPTION_CAUGHT(err);
+        FAILURE_CAUGHT(result);
     }
 
     VariableDefinition def;
 
-    tokensConsumed += def.parse(source);
-    expectToken( Tokenizer::Tokens::SEMICOLON, source, tokensConsumed, "Statement does not end with a semicolon",
-            "Unexpected EOF" );
+    RULE_PARSE( def.tryParse(source) );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::SEMICOLON, source, tokensConsumed,
+            "Statement does not end with a semicolon", "Unexpected EOF" ) );
 
     content = std::move(def);
     RULE_LEAVE();
 }
 
-size_t StatementList::parse(Slice<const Tokenizer::Token> source) {
+ParseResult StatementList::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    try {
-        // One of the disadvantages of using exceptions for signalling expected errors is "infinite" loops
-        while( true ) {
-            Statement statement;
-            tokensConsumed += statement.parse(source.subslice(tokensConsumed));
-
-            statements.emplace_back( std::move(statement) );
+    // The list ends with the first thing that isn't a statement
+    while( true ) {
+        Statement statement;
+        ParseResult result = statement.tryParse(source.subslice(tokensConsumed));
+        if( !result ) {
+            FAILURE_CAUGHT(result);
+            break;
         }
-    } catch( parser_error &err ) {
-        EXCEPTION_CAUGHT(err);
+
+        tokensConsumed += result.consumed();
+        statements.emplace_back( std::move(statement) );
     }
 
     RULE_LEAVE();
 }
 
-size_t CompoundExpression::parse(Slice<const Tokenizer::Token> source) {
+ParseResult CompoundExpression::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
     CompoundExpressionOrStatement compound;
-    tokensConsumed = compound.parseExpression(source);
+    RULE_PARSE( compound.parseExpression(source) );
 
     *this = compound.removeExpression();
 
     RULE_LEAVE();
 }
 
-size_t CompoundStatement::parse(Slice<const Tokenizer::Token> source) {
+ParseResult CompoundStatement::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
     CompoundExpressionOrStatement compound;
-    tokensConsumed = compound.parseStatement(source);
+    RULE_PARSE( compound.parseStatement(source) );
 
     *this = compound.removeStatement();
 
     RULE_LEAVE();
 }
 
-size_t FuncDeclRet::parse(Slice<const Tokenizer::Token> source) {
+ParseResult FuncDeclRet::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    try {
-        expectToken(
-                Tokenizer::Tokens::OP_ARROW, source, tokensConsumed, "Expected ->",
-                "EOF while parsing function return type" );
-        // TODO If we found an arrow, probably best to fail if the rest doesn't match
+    ParseResult result = expectToken(
+            Tokenizer::Tokens::OP_ARROW, source, tokensConsumed, "Expected ->",
+            "EOF while parsing function return type" );
+    // TODO If we found an arrow, probably best to fail if the rest doesn't match
+    if( result )
+        result = type.tryParse(source.subslice(tokensConsumed));
 
-        tokensConsumed += type.parse(source.subslice(tokensConsumed));
-    } catch( parser_error &err ) {
-        EXCEPTION_CAUGHT(err);
+    if( !result ) {
+        FAILURE_CAUGHT(result);
         // Match ϵ
-        return 0;
+        return ParseResult::success(0);
     }
 
+    tokensConsumed += result.consumed();
+
     RULE_LEAVE();
 }
 
-size_t FuncDeclArg::parse(Slice<const Tokenizer::Token> source) {
+ParseResult FuncDeclArg::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    tokensConsumed += name.parse( source.subslice(tokensConsumed) );
-    expectToken(
+    RULE_PARSE( name.tryParse( source.subslice(tokensConsumed) ) );
+    RULE_CHECK( expectToken(
             Tokenizer::Tokens::OP_COLON, source, tokensConsumed, "Expected colon in argument declaration",
-            "EOF while parsing function declaration" );
-    tokensConsumed += type.parse( source.subslice(tokensConsumed) );
+            "EOF while parsing function declaration" ) );
+    RULE_PARSE( type.tryParse( source.subslice(tokensConsumed) ) );
 
     RULE_LEAVE();
 }
 
-size_t FuncDeclArgsNonEmpty::parse(Slice<const Tokenizer::Token> source) {
+ParseResult FuncDeclArgsNonEmpty::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
     bool more = false;
     do {
         FuncDeclArg arg;
-        tokensConsumed += arg.parse(source.subslice(tokensConsumed));
+        RULE_PARSE( arg.tryParse(source.subslice(tokensConsumed)) );
         arguments.emplace_back( std::move(arg) );
 
         more = wishForToken( Tokenizer::Tokens::COMMA, source, tokensConsumed, true );
@@ -595,74 +583,176 @@ size_t FuncDeclArgsNonEmpty::parse(Slice<const Tokenizer::Token> source) {
     RULE_LEAVE();
 }
 
-size_t FuncDeclArgs::parse(Slice<const Tokenizer::Token> source) {
+ParseResult FuncDeclArgs::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    try {
-        FuncDeclArgsNonEmpty args;
-        tokensConsumed += args.parse(source);
+    FuncDeclArgsNonEmpty args;
+    ParseResult result = args.tryParse(source);
+    if( result ) {
+        tokensConsumed += result.consumed();
         arguments = std::move(args.arguments);
-    } catch( parser_error &err ) {
-        EXCEPTION_CAUGHT(err);
+    } else {
+        FAILURE_CAUGHT(result);
         // That didn't match - use the empty match rule
     }
 
     RULE_LEAVE();
 }
 
-size_t FuncDeclBody::parse(Slice<const Tokenizer::Token> source) {
+ParseResult FuncDeclBody::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    tokensConsumed += name.parse( source  );
+    RULE_PARSE( name.tryParse( source  ) );
 
-    expectToken( Tokenizer::Tokens::BRACKET_ROUND_OPEN, source, tokensConsumed, "Expected '('",
-            "EOF while parsing function declaration" );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::BRACKET_ROUND_OPEN, source, tokensConsumed, "Expected '('",
+            "EOF while parsing function declaration" ) );
 
-    tokensConsumed += arguments.parse( source.subslice(tokensConsumed) );
+    RULE_PARSE( arguments.tryParse( source.subslice(tokensConsumed) ) );
 
-    expectToken( Tokenizer::Tokens::BRACKET_ROUND_CLOSE, source, tokensConsumed, "Expected ')'",
-            "EOF while parsing function declaration" );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::BRACKET_ROUND_CLOSE, source, tokensConsumed, "Expected ')'",
+            "EOF while parsing function declaration" ) );
 
-    tokensConsumed += returnType.parse( source.subslice(tokensConsumed) );
+    RULE_PARSE( returnType.tryParse( source.subslice(tokensConsumed) ) );
 
     RULE_LEAVE();
 }
 
-size_t FuncDef::parse(Slice<const Tokenizer::Token> source) {
+ParseResult FuncDef::tryParse(Slice<const Tokenizer::Token> source) {
+    return parseInternal(source, false);
+}
+
+ParseResult FuncDef::tryParseDeclaration(Slice<const Tokenizer::Token> source) {
+    return parseInternal(source, true);
+}
+
+// Out of line, so that users of FuncDef need not see FlatTree
+FuncDef::FuncDef() : body{} {
+}
+
+FuncDef::FuncDef( FuncDef &&that ) :
+    NonTerminal( that ),
+    decl( std::move(that.decl) ),
+    body( std::move(that.body) ),
+    flatBody( std::move(that.flatBody) ),
+    unparsedBody( that.unparsedBody ),
+    bodyArena( that.bodyArena )
+{}
+
+FuncDef::~FuncDef() {
+}
+
+const FuncDef::Body &FuncDef::getBody() const {
+    if( bodyArena!=nullptr ) {
+        ParseMemo memo;
+        ArenaScope scope( *bodyArena );
+
+        ParseResult result = parseBody( unparsedBody );
+        if( !result )
+            result.raise();
+        ASSERT( result.consumed()==unparsedBody.size() ) << "Function body parse does not match its brackets";
+
+        bodyArena = nullptr;
+    }
+
+    return body;
+}
+
+const FlatTree &FuncDef::getFlatBody() const {
+    if( !flatBody ) {
+        const Body &parsed = getBody();
+        flatBody = safenew<FlatTree>( parsed, getNTTokens() );
+    }
+
+    return *flatBody;
+}
+
+// Length of the curly brackets enclosed range source starts with. 0 if it does not start with one, or it is not closed
+static size_t bracketedLength(Slice<const Tokenizer::Token> source) {
+    size_t index = 0;
+    skipWS(source, index);
+    if( index==source.size() || source[index].token!=Tokenizer::Tokens::BRACKET_CURLY_OPEN )
+        return 0;
+
+    size_t depth = 0;
+    for( ; index<source.size(); ++index ) {
+        switch( source[index].token ) {
+        case Tokenizer::Tokens::BRACKET_CURLY_OPEN:
+            depth++;
+            break;
+        case Tokenizer::Tokens::BRACKET_CURLY_CLOSE:
+            if( --depth==0 )
+                return index+1;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return 0;
+}
+
+ParseResult FuncDef::parseInternal(Slice<const Tokenizer::Token> source, bool lazyBody) {
     RULE_ENTER(source);
 
-    const Tokenizer::Token *currentToken = nextToken(source, tokensConsumed, "EOF while looking for function definition");
+    const Tokenizer::Token *currentToken = nextToken(source, tokensConsumed);
+    if( currentToken==nullptr )
+        RULE_FAIL("EOF while looking for function definition", SourceLocation());
     if( currentToken->token!=Tokenizer::Tokens::RESERVED_DEF ) {
-        throw parser_error("Function definition should start with \"def\"", currentToken->location);
+        RULE_FAIL("Function definition should start with \"def\"", currentToken->location);
     }
 
-    tokensConsumed += decl.parse( source.subslice(tokensConsumed) );
-    CompoundExpressionOrStatement body;
-    tokensConsumed += body.parse( source.subslice(tokensConsumed) );
-    if( body.isStatement() )
-        this->body = body.removeStatement();
-    else
-        this->body = body.removeExpression();
+    RULE_PARSE( decl.tryParse( source.subslice(tokensConsumed) ) );
+
+    if( lazyBody ) {
+        size_t bodyLength = bracketedLength( source.subslice(tokensConsumed) );
+
+        // Unbalanced brackets are left for the full parse to report
+        if( bodyLength>0 ) {
+            unparsedBody = source.subslice(tokensConsumed, tokensConsumed + bodyLength);
+            bodyArena = ArenaScope::currentArena();
+            ASSERT( bodyArena!=nullptr ) << "Function body deferred with no arena in effect";
+            tokensConsumed += bodyLength;
+
+            RULE_LEAVE();
+        }
+    }
+
+    RULE_PARSE( parseBody( source.subslice(tokensConsumed) ) );
 
     RULE_LEAVE();
 }
 
-size_t FuncDecl::parse(Slice<const Tokenizer::Token> source) {
+ParseResult FuncDef::parseBody(Slice<const Tokenizer::Token> source) const {
+    CompoundExpressionOrStatement parsed;
+    ParseResult result = parsed.tryParse(source);
+    if( !result )
+        return result;
+
+    if( parsed.isStatement() )
+        body = parsed.removeStatement();
+    else
+        body = parsed.removeExpression();
+
+    return result;
+}
+
+ParseResult FuncDecl::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    expectToken( Tokenizer::Tokens::RESERVED_DECL, source, tokensConsumed, "Expected `decl` keyword" );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::RESERVED_DECL, source, tokensConsumed, "Expected `decl` keyword" ) );
 
     const Tokenizer::Token *currentToken = wishForToken(
             Tokenizer::Tokens::BRACKET_ROUND_OPEN, source, tokensConsumed, true );
     if( currentToken!=nullptr ) {
         // Declaration has qualifiers
-        tokensConsumed += abiSpecifier.parse( source.subslice(tokensConsumed) );
-        expectToken( Tokenizer::Tokens::BRACKET_ROUND_CLOSE, source, tokensConsumed, "Unmatched `(`" );
+        RULE_PARSE( abiSpecifier.tryParse( source.subslice(tokensConsumed) ) );
+        RULE_CHECK( expectToken( Tokenizer::Tokens::BRACKET_ROUND_CLOSE, source, tokensConsumed, "Unmatched `(`" ) );
     }
 
-    tokensConsumed += decl.parse( source.subslice(tokensConsumed) );
+    RULE_PARSE( decl.tryParse( source.subslice(tokensConsumed) ) );
 
-    expectToken( Tokenizer::Tokens::SEMICOLON, source, tokensConsumed, "Function declaration must end with `;`" );
+    RULE_CHECK( expectToken(
+            Tokenizer::Tokens::SEMICOLON, source, tokensConsumed, "Function declaration must end with `;`" ) );
 
     RULE_LEAVE();
 }
@@ -34,19 +34,19 @@ namespace NonTerminals {
         Type type;
         const Tokenizer::Token *ref = nullptr;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct LiteralPointer : public NonTerminal {
         const Tokenizer::Token *token = nullptr;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct Literal : public NonTerminal {
         std::variant<LiteralInt, LiteralBool, LiteralPointer, LiteralString> literal;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 
         SourceLocation getLocation() const;
     };
@@ -55,7 +55,7 @@ namespace NonTerminals {
     struct FunctionArguments : public NonTerminal {
         std::vector<Expression> arguments;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct CompoundExpression;
@@ -64,73 +64,64 @@ namespace NonTerminals {
     struct Expression : public NonTerminal {
         struct UnaryOperator {
             const Tokenizer::Token *op;
-            std::unique_ptr<Expression> operand;
+            NodePtr<Expression> operand;
         };
 
         struct BinaryOperator {
             const Tokenizer::Token *op;
-            std::array< std::unique_ptr<Expression>, 2 > operands;
+            std::array< NodePtr<Expression>, 2 > operands;
         };
 
         struct CastOperator {
             const Tokenizer::Token *op;
             Type destType;
-            std::unique_ptr<Expression> expression;
+            NodePtr<Expression> expression;
         };
 
         struct FunctionCall {
             const Tokenizer::Token *op;
-            std::unique_ptr<Expression> expression;
+            NodePtr<Expression> expression;
             FunctionArguments arguments;
         };
 
         std::variant<
-                std::unique_ptr<::NonTerminals::CompoundExpression>,
+                NodePtr<::NonTerminals::CompoundExpression>,
                 ::NonTerminals::Literal,
                 Identifier,
                 UnaryOperator,
                 BinaryOperator,
                 CastOperator,
                 FunctionCall,
-                std::unique_ptr<ConditionalExpression>,
+                NodePtr<ConditionalExpression>,
                 Type
             > value;
-    private:
-        mutable std::unique_ptr<Type> altTypeParse;
 
-    public:
         Expression() {}
         explicit Expression( ConditionalExpression &&condition ) :
-            value( safenew<ConditionalExpression>( std::move(condition) ) )
-        {}
-        Expression( Expression &&that ) : value( std::move(that.value) ), altTypeParse( std::move(that.altTypeParse) )
+            value( newNode<ConditionalExpression>( std::move(condition) ) )
         {}
-        Expression &operator=( Expression &&that ) {
-            value = std::move( that.value );
-            altTypeParse = std::move( that.altTypeParse );
-
-            return *this;
-        }
+        Expression( Expression &&that ) = default;
+        Expression &operator=( Expression &&that ) = default;
 
-        explicit Expression( std::unique_ptr<CompoundExpression> &&compoundExpression ) :
+        explicit Expression( NodePtr<CompoundExpression> &&compoundExpression ) :
             value( std::move(compoundExpression) )
         {}
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
-        const Type *reparseAsType() const;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 
     private:
-        size_t actualParse(Slice<const Tokenizer::Token> source, size_t level);
-        size_t basicParse(Slice<const Tokenizer::Token> source);
-
-        size_t parsePrefixOp(
-                Slice<const Tokenizer::Token> source, size_t level, const Operators::OperatorPriority::OperatorsMap &operators);
-        size_t parseInfixOp(
-                Slice<const Tokenizer::Token> source, size_t level, const Operators::OperatorPriority::OperatorsMap &operators);
-        size_t parseInfixR2LOp(
-                Slice<const Tokenizer::Token> source, size_t level, const Operators::OperatorPriority::OperatorsMap &operators);
-        size_t parsePostfixOp(
-                Slice<const Tokenizer::Token> source, size_t level, const Operators::OperatorPriority::OperatorsMap &operators);
+        ParseResult parseFresh(Slice<const Tokenizer::Token> source);
+        // Take on the meaning of a type that also reads as an expression. Returns false if it does not. minLevel is set
+        // to the level of the loosest operator applied
+        bool fromType(const Type &type, Slice<const Tokenizer::Token> source, size_t &minLevel);
+        // Expression using only operators of `level` and below
+        ParseResult actualParse(Slice<const Tokenizer::Token> source, size_t level);
+        // Apply the operators that follow the operand we have, which was parsed from the first operandTokens tokens
+        ParseResult parseOperators(
+                Slice<const Tokenizer::Token> source, size_t operandTokens, size_t level, size_t minLevel);
+        ParseResult basicParse(Slice<const Tokenizer::Token> source);
+        // Prefix operators of `level`, and the operand they apply to
+        ParseResult parsePrefixOp(Slice<const Tokenizer::Token> source, size_t level);
     };
 
     struct ConditionalExpression {
@@ -143,11 +134,11 @@ namespace NonTerminals {
     struct Statement : public NonTerminal {
         struct ConditionalStatement {
             Expression condition;
-            std::unique_ptr<Statement> ifClause, elseClause;
+            NodePtr<Statement> ifClause, elseClause;
         };
 
         Statement() {}
-        explicit Statement( std::unique_ptr<CompoundStatement> &&compoundStatement ) :
+        explicit Statement( NodePtr<CompoundStatement> &&compoundStatement ) :
             content( std::move(compoundStatement) )
         {}
         explicit Statement( Expression &&expression ) : content( std::move(expression) ) {}
@@ -157,16 +148,19 @@ namespace NonTerminals {
                 Expression,
                 VariableDefinition,
                 ConditionalStatement,
-                std::unique_ptr<CompoundStatement>
+                NodePtr<CompoundStatement>
             > content;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
+
+    private:
+        ParseResult parseFresh(Slice<const Tokenizer::Token> source);
     };
 
     struct StatementList : public NonTerminal {
         std::vector<Statement> statements;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct CompoundExpression : public NonTerminal {
@@ -180,18 +174,20 @@ namespace NonTerminals {
             expression( std::move(expression) )
         {}
         CompoundExpression( CompoundExpression &&that ) :
+            NonTerminal( that ),
             statementList( std::move(that.statementList) ),
             expression( std::move(that.expression) )
         {}
 
         CompoundExpression &operator=( CompoundExpression &&that ) {
+            parsedSlice = that.parsedSlice;
             statementList = std::move( that.statementList );
             expression = std::move( that.expression );
 
             return *this;
         }
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct CompoundStatement : public NonTerminal {
@@ -200,32 +196,32 @@ namespace NonTerminals {
         CompoundStatement() {}
         CompoundStatement( StatementList &&statements ) : statements( std::move(statements) ) {}
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct FuncDeclRet : public NonTerminal {
         TransientType type;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct FuncDeclArg : public NonTerminal {
         Identifier name;
         TransientType type;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct FuncDeclArgsNonEmpty : public NonTerminal {
         std::vector<FuncDeclArg> arguments;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct FuncDeclArgs : public NonTerminal {
         std::vector<FuncDeclArg> arguments;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
     struct FuncDeclBody : public NonTerminal {
@@ -233,22 +229,45 @@ namespace NonTerminals {
         FuncDeclArgs arguments;
         FuncDeclRet returnType;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     };
 
+    class FlatTree;
+
     struct FuncDef : public NonTerminal {
+        using Body = std::variant<std::monostate, CompoundExpression, CompoundStatement>;
+
         FuncDeclBody decl;
-        std::variant<std::monostate, CompoundExpression, CompoundStatement> body;
 
-        FuncDef() : body{} {
-        }
-        FuncDef( FuncDef &&that ) : decl( std::move(that.decl) ), body( std::move(that.body) ) {}
+        FuncDef();
+        FuncDef( FuncDef &&that );
+        ~FuncDef();
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
+        // Parse just the declaration, and find where the body ends by matching brackets. The body is parsed, into the
+        // arena in effect now, the first time it is asked for
+        ParseResult tryParseDeclaration(Slice<const Tokenizer::Token> source);
+
+        // Throws parser_error if a body that was not parsed yet fails to parse. Not thread safe
+        const Body &getBody() const;
+        // Same as getBody. The body is flattened the first time it is asked for, and kept. Not thread safe
+        const FlatTree &getFlatBody() const;
 
         String getName() const {
             return decl.name.getName();
         }
+
+    private:
+        friend class ModuleCache;
+
+        mutable Body body;
+        mutable std::unique_ptr<FlatTree> flatBody;
+        Slice<const Tokenizer::Token> unparsedBody;
+        // Not nullptr while the body is yet to be parsed
+        mutable Arena *bodyArena = nullptr;
+
+        ParseResult parseInternal(Slice<const Tokenizer::Token> source, bool lazyBody);
+        ParseResult parseBody(Slice<const Tokenizer::Token> source) const;
     };
 
     struct FuncDecl : public NonTerminal {
@@ -258,7 +277,7 @@ namespace NonTerminals {
         FuncDecl() {}
         FuncDecl( FuncDecl &&that ) = default;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 
         String getName() const {
             return decl.name.getName();
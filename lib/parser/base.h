@@ -9,19 +9,117 @@
 #ifndef PARSER_BASE_H
 #define PARSER_BASE_H
 
+#include "arena.h"
 #include "tokenizer.h"
 
 namespace NonTerminals {
 
+// Parse tree nodes are allocated from the arena of the module they belong to, and are released all at once with it
+template<typename T>
+using NodePtr = Arena::Ptr<T>;
+
+// Makes an arena the one new nodes are allocated from, for as long as the scope exists
+class ArenaScope : private NoCopy {
+    Arena *previous;
+
+    static thread_local Arena *current;
+
+public:
+    explicit ArenaScope(Arena &arena) : previous(current) {
+        current = &arena;
+    }
+
+    ~ArenaScope() {
+        current = previous;
+    }
+
+    // nullptr if there is no arena in effect
+    static Arena *currentArena() {
+        return current;
+    }
+};
+
+template<typename T, typename... Args>
+NodePtr<T> newNode(Args&&... args) {
+    Arena *arena = ArenaScope::currentArena();
+    ASSERT( arena!=nullptr ) << "Parse tree node allocated with no arena in effect";
+
+    return arena->make<T>( std::forward<Args>(args)... );
+}
+
+// Outcome of parsing a non terminal. Backtracking means most failures are routine, so they are reported by value, and
+// only turned into a parser_error once it is clear nothing else is going to match.
+class ParseResult {
+    size_t tokensConsumed = 0;
+    // nullptr if parsing succeeded
+    const char *message = nullptr;
+    SourceLocation location;
+
+    ParseResult() = default;
+
+public:
+    static ParseResult success(size_t tokensConsumed) {
+        ParseResult ret;
+        ret.tokensConsumed = tokensConsumed;
+
+        return ret;
+    }
+
+    // message must be a string literal. It is kept by pointer
+    static ParseResult failure(const char *message, const SourceLocation &location) {
+        ASSERT( message!=nullptr );
+
+        ParseResult ret;
+        ret.message = message;
+        ret.location = location;
+
+        return ret;
+    }
+
+    explicit operator bool() const {
+        return message==nullptr;
+    }
+
+    size_t consumed() const {
+        ASSERT( *this ) << "Asked for the length of a failed parse";
+        return tokensConsumed;
+    }
+
+    const char *getMessage() const {
+        return message;
+    }
+
+    SourceLocation getLocation() const {
+        return location;
+    }
+
+    // Throw the parser_error this failure stands for
+    [[noreturn]] void raise() const;
+};
+
+class ModuleCache;
+
 struct NonTerminal {
 protected:
     Slice<const Tokenizer::Token> parsedSlice;
 
+    friend ModuleCache;
+
 public:
-    // This function is not really virtual. It's used this way to force all children to have the same signature
     // Returns how many tokens were consumed
     // Throws parser_error if fails to parse
-    virtual size_t parse(Slice<const Tokenizer::Token> source) = 0;
+    size_t parse(Slice<const Tokenizer::Token> source) {
+        ParseResult result = tryParse(source);
+        if( !result )
+            result.raise();
+
+        return result.consumed();
+    }
+
+    // This function is not really virtual. It's used this way to force all children to have the same signature
+    // Failing to match is reported in the result. Only errors no other parse could fix, such as an integer literal
+    // that is too big, are thrown
+    virtual ParseResult tryParse(Slice<const Tokenizer::Token> source) = 0;
 
     virtual ~NonTerminal() {}
 
@@ -0,0 +1,909 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "parser/cache.h"
+
+#include "mmap.h"
+#include "nocopy.h"
+#include "tokenizer/symbols.h"
+
+#include <practical/errors.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <unistd.h>
+
+// Image layout, all in native endian 32 bit words:
+// header:  Magic, FormatVersion, source hash (2 words), source size (2 words)
+// tokens:  count, then per token its type, offset and length in the source, line, column, whether it has a symbol,
+//          and its value
+// tree:    the module, in pre order. Every node starts with its parsed slice. Token pointers are stored as indices
+//          into the token array, variants as the index of the alternative followed by it, and nullable pointers as a
+//          flag followed by what they point to
+// trailer: checksum of everything before it (2 words), and Magic again, so that truncated images are caught.
+
+namespace NonTerminals {
+
+namespace {
+
+static constexpr uint32_t Magic = 0x43525050; // "PPRC"
+// Bump when changing the layout by hand
+static constexpr uint32_t LayoutRevision = 2;
+
+// Images store token kinds and variant alternatives as numbers, and follow the nodes' members. Changing those changes
+// the meaning of existing images even if this file is not touched, so they are part of the version
+constexpr uint32_t formatVersion() {
+    uint32_t version = LayoutRevision;
+    for( size_t part : {
+            static_cast<size_t>( Tokenizer::Tokens::RESERVED_STRUCT ),
+            std::variant_size_v< decltype(Type::type) >,
+            std::variant_size_v< decltype(Literal::literal) >,
+            std::variant_size_v< decltype(Expression::value) >,
+            std::variant_size_v< decltype(Statement::content) >,
+            std::variant_size_v< FuncDef::Body >,
+            sizeof(Tokenizer::Token), sizeof(Identifier), sizeof(Type), sizeof(Literal), sizeof(Expression),
+            sizeof(ConditionalExpression), sizeof(Statement), sizeof(StatementList), sizeof(CompoundExpression),
+            sizeof(CompoundStatement), sizeof(VariableDefinition), sizeof(FuncDef), sizeof(FuncDecl),
+            sizeof(StructDef) } )
+    {
+        version = version*31 + part;
+    }
+
+    return version;
+}
+static constexpr uint32_t FormatVersion = formatVersion();
+// Index of a token pointer that is nullptr, and offset of a token text that is empty
+static constexpr uint32_t None = ~uint32_t(0);
+
+enum class ValueKind : uint32_t { None, SignedInt, UnsignedInt, Double };
+
+// FNV-1a
+uint64_t fnv(const unsigned char *data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325;
+    for( size_t i=0; i<size; ++i ) {
+        hash ^= data[i];
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+uint64_t sourceHash(String source) {
+    return fnv( reinterpret_cast<const unsigned char *>( source.get() ), source.size() );
+}
+
+uint64_t checksum(const uint32_t *words, size_t numWords) {
+    return fnv( reinterpret_cast<const unsigned char *>( words ), numWords*sizeof(uint32_t) );
+}
+
+// Thrown when the module holds something an image cannot express
+struct Unrepresentable {};
+// Thrown when an image does not hold a valid module
+struct Corrupt {};
+
+} // anonymous namespace
+
+class ModuleCache::Writer {
+    String source;
+    // The arrays the module's tokens live in, ordered by address
+    struct Run {
+        const Tokenizer::Token *begin;
+        size_t size;
+        // Where in the image's token array the run starts
+        uint32_t base;
+    };
+    std::vector<Run> runs;
+
+public:
+    std::vector<uint32_t> words;
+
+    Writer(const Module &module, String source) : source(source) {
+        u32( Magic );
+        u32( FormatVersion );
+        u64( sourceHash(source) );
+        u64( source.size() );
+
+        std::vector< Slice<const Tokenizer::Token> > arrays;
+        arrays.emplace_back( module.tokens );
+        if( module.tokenStream ) {
+            for( const auto &segment : module.tokenStream->pinnedSegments() )
+                arrays.emplace_back( segment );
+        }
+
+        size_t numTokens = 0;
+        for( auto array : arrays ) {
+            if( array.size()==0 )
+                continue;
+
+            runs.emplace_back( Run{ array.get(), array.size(), static_cast<uint32_t>(numTokens) } );
+            numTokens += array.size();
+        }
+        if( numTokens >= None )
+            throw Unrepresentable();
+        std::sort( runs.begin(), runs.end(), []( const Run &a, const Run &b ) { return a.begin < b.begin; } );
+
+        u32( numTokens );
+        for( auto array : arrays ) {
+            for( const auto &token : array )
+                write( token );
+        }
+
+        write( module );
+        u64( checksum( words.data(), words.size() ) );
+        u32( Magic );
+    }
+
+private:
+    void u32(uint64_t word) {
+        ASSERT( word <= std::numeric_limits<uint32_t>::max() );
+        words.push_back( word );
+    }
+
+    void u64(uint64_t word) {
+        words.push_back( word );
+        words.push_back( word>>32 );
+    }
+
+    void u128(unsigned __int128 word) {
+        u64( word );
+        u64( word>>64 );
+    }
+
+    uint32_t index(const Tokenizer::Token *token, size_t length = 1) const {
+        auto run = std::upper_bound(
+                runs.begin(), runs.end(), token, []( const Tokenizer::Token *token, const Run &run ) {
+                    return token < run.begin;
+                } );
+        if( run==runs.begin() )
+            throw Unrepresentable();
+        --run;
+
+        size_t offset = token - run->begin;
+        if( offset+length > run->size )
+            throw Unrepresentable();
+
+        return run->base + offset;
+    }
+
+    void token(const Tokenizer::Token *token) {
+        u32( token==nullptr ? None : index(token) );
+    }
+
+    void slice(Slice<const Tokenizer::Token> slice) {
+        u32( slice.size() );
+        if( slice.size()>0 )
+            u32( index( slice.get(), slice.size() ) );
+    }
+
+    void string(const std::string &string) {
+        u32( string.size() );
+        for( size_t i=0; i<string.size(); i+=sizeof(uint32_t) ) {
+            uint32_t word = 0;
+            memcpy( &word, string.data() + i, std::min( sizeof(word), string.size()-i ) );
+            u32( word );
+        }
+    }
+
+    void write(const Tokenizer::Token &token) {
+        u32( static_cast<uint32_t>(token.token) );
+        if( token.text.size()==0 ) {
+            u32( None );
+            u32( 0 );
+        } else {
+            if( token.text.get() < source.get() || token.text.get() + token.text.size() > source.get() + source.size() )
+                throw Unrepresentable();
+
+            u32( token.text.get() - source.get() );
+            u32( token.text.size() );
+        }
+        u32( token.location.line );
+        u32( token.location.col );
+        u32( token.symbol!=Tokenizer::NoSymbol );
+
+        if( std::holds_alternative<ExactInt>( token.value ) ) {
+            const ExactInt &value = std::get<ExactInt>( token.value );
+            if( value.getType()==ExactInt::Type::SIGNED ) {
+                u32( static_cast<uint32_t>(ValueKind::SignedInt) );
+                u128( value.getSigned() );
+            } else {
+                u32( static_cast<uint32_t>(ValueKind::UnsignedInt) );
+                u128( value.getUnsigned() );
+            }
+        } else if( std::holds_alternative<double>( token.value ) ) {
+            double value = std::get<double>( token.value );
+            uint64_t bits;
+            memcpy( &bits, &value, sizeof(bits) );
+            u32( static_cast<uint32_t>(ValueKind::Double) );
+            u64( bits );
+        } else {
+            u32( static_cast<uint32_t>(ValueKind::None) );
+        }
+    }
+
+    template<typename T>
+    void write(const NodePtr<T> &node) {
+        u32( node!=nullptr );
+        if( node )
+            write( *node );
+    }
+
+    template<typename... Alternatives>
+    void write(const std::variant<Alternatives...> &variant) {
+        u32( variant.index() );
+        std::visit( [this]( const auto &alternative ) { write( alternative ); }, variant );
+    }
+
+    template<typename T>
+    void write(const std::vector<T> &vector) {
+        u32( vector.size() );
+        for( const T &element : vector )
+            write( element );
+    }
+
+    void write(std::monostate) {
+    }
+
+    void write(const Identifier &identifier) {
+        slice( identifier.parsedSlice );
+        token( identifier.identifier );
+    }
+
+    void write(const Type::Array &array) {
+        token( array.token );
+        write( array.elementType );
+        write( array.dimension );
+    }
+
+    void write(const Type::Pointer &pointer) {
+        token( pointer.token );
+        write( pointer.pointed );
+    }
+
+    void write(const Type &type) {
+        slice( type.parsedSlice );
+        write( type.type );
+    }
+
+    void write(const LiteralInt &literal) {
+        slice( literal.parsedSlice );
+        token( literal.token );
+        u64( literal.value );
+    }
+
+    void write(const LiteralBool &literal) {
+        slice( literal.parsedSlice );
+        token( literal.token );
+        u32( literal.value );
+    }
+
+    void write(const LiteralPointer &literal) {
+        slice( literal.parsedSlice );
+        token( literal.token );
+    }
+
+    void write(const LiteralString &literal) {
+        slice( literal.parsedSlice );
+        token( literal.token );
+        string( literal.value );
+    }
+
+    void write(const Literal &literal) {
+        slice( literal.parsedSlice );
+        write( literal.literal );
+    }
+
+    void write(const FunctionArguments &arguments) {
+        slice( arguments.parsedSlice );
+        write( arguments.arguments );
+    }
+
+    void write(const Expression::UnaryOperator &op) {
+        token( op.op );
+        write( op.operand );
+    }
+
+    void write(const Expression::BinaryOperator &op) {
+        token( op.op );
+        write( op.operands[0] );
+        write( op.operands[1] );
+    }
+
+    void write(const Expression::CastOperator &op) {
+        token( op.op );
+        write( op.destType );
+        write( op.expression );
+    }
+
+    void write(const Expression::FunctionCall &call) {
+        token( call.op );
+        write( call.expression );
+        write( call.arguments );
+    }
+
+    void write(const ConditionalExpression &conditional) {
+        write( conditional.condition );
+        write( conditional.ifClause );
+        write( conditional.elseClause );
+    }
+
+    void write(const Expression &expression) {
+        slice( expression.parsedSlice );
+        write( expression.value );
+    }
+
+    void write(const Statement::ConditionalStatement &conditional) {
+        write( conditional.condition );
+        write( conditional.ifClause );
+        write( conditional.elseClause );
+    }
+
+    void write(const Statement &statement) {
+        slice( statement.parsedSlice );
+        write( statement.content );
+    }
+
+    void write(const StatementList &list) {
+        slice( list.parsedSlice );
+        write( list.statements );
+    }
+
+    void write(const CompoundExpression &compound) {
+        slice( compound.parsedSlice );
+        write( compound.statementList );
+        write( compound.expression );
+    }
+
+    void write(const CompoundStatement &compound) {
+        slice( compound.parsedSlice );
+        write( compound.statements );
+    }
+
+    void write(const VariableDeclBody &body) {
+        slice( body.parsedSlice );
+        write( body.name );
+        write( body.type );
+    }
+
+    void write(const VariableDefinition &definition) {
+        slice( definition.parsedSlice );
+        write( definition.body );
+        write( definition.initValue );
+    }
+
+    void write(const TransientType &type) {
+        slice( type.parsedSlice );
+        write( type.type );
+        token( type.ref );
+    }
+
+    void write(const FuncDeclRet &ret) {
+        slice( ret.parsedSlice );
+        write( ret.type );
+    }
+
+    void write(const FuncDeclArg &argument) {
+        slice( argument.parsedSlice );
+        write( argument.name );
+        write( argument.type );
+    }
+
+    void write(const FuncDeclArgs &arguments) {
+        slice( arguments.parsedSlice );
+        write( arguments.arguments );
+    }
+
+    void write(const FuncDeclBody &decl) {
+        slice( decl.parsedSlice );
+        write( decl.name );
+        write( decl.arguments );
+        write( decl.returnType );
+    }
+
+    void write(const FuncDef &function) {
+        slice( function.parsedSlice );
+        write( function.decl );
+        // Bodies that were left for later are parsed now
+        write( function.getBody() );
+    }
+
+    void write(const FuncDecl &function) {
+        slice( function.parsedSlice );
+        write( function.decl );
+        write( function.abiSpecifier );
+    }
+
+    void write(const StructDef &structure) {
+        slice( structure.parsedSlice );
+        token( structure.keyword );
+        write( structure.identifier );
+        write( structure.definitions );
+    }
+
+    void write(const Module &module) {
+        slice( module.parsedSlice );
+        write( module.functionDefinitions );
+        write( module.functionDeclarations );
+        write( module.structureDefinitions );
+    }
+};
+
+class ModuleCache::Reader {
+    const uint32_t *words;
+    size_t numWords;
+    size_t position = 0;
+
+    String source;
+    const std::vector<Tokenizer::Token> &tokens;
+    // Parsed slice of the innermost node being read that has one. Everything a node refers to must be inside it
+    Slice<const Tokenizer::Token> enclosing;
+
+    // Reads a node's parsed slice, and holds it as the enclosing one until the node is read
+    class NodeSlice : private NoCopy {
+        Reader &reader;
+        Slice<const Tokenizer::Token> saved;
+
+    public:
+        NodeSlice(Reader &reader, Slice<const Tokenizer::Token> &parsedSlice) : reader(reader), saved(reader.enclosing) {
+            parsedSlice = reader.slice();
+            if( parsedSlice.size()>0 )
+                reader.enclosing = parsedSlice;
+        }
+
+        ~NodeSlice() {
+            reader.enclosing = saved;
+        }
+    };
+
+public:
+    Reader(Module &module, String source, Slice<const char> image) :
+        words( reinterpret_cast<const uint32_t *>( image.get() ) ),
+        numWords( image.size() / sizeof(uint32_t) ),
+        source(source),
+        tokens(module.tokens)
+    {
+        if( image.size() % sizeof(uint32_t) != 0 )
+            throw Corrupt();
+
+        // Nothing is believed before the checksum is
+        static constexpr size_t TrailerWords = 3;
+        if( numWords<TrailerWords )
+            throw Corrupt();
+        uint64_t expectedChecksum = words[numWords-3] | uint64_t( words[numWords-2] )<<32;
+        if( checksum( words, numWords-TrailerWords )!=expectedChecksum )
+            throw Corrupt();
+
+        if( u32()!=Magic || u32()!=FormatVersion || u64()!=sourceHash(source) || u64()!=source.size() )
+            throw Corrupt();
+
+        size_t numTokens = count();
+        module.tokens.resize( numTokens );
+        for( auto &token : module.tokens )
+            read( token );
+
+        ArenaScope scope( module.arena );
+        read( module );
+
+        u64();
+        if( u32()!=Magic || position!=numWords )
+            throw Corrupt();
+    }
+
+private:
+    uint32_t u32() {
+        if( position>=numWords )
+            throw Corrupt();
+
+        return words[position++];
+    }
+
+    uint64_t u64() {
+        uint64_t low = u32();
+        return low | uint64_t( u32() )<<32;
+    }
+
+    unsigned __int128 u128() {
+        unsigned __int128 low = u64();
+        return low | static_cast<unsigned __int128>( u64() )<<64;
+    }
+
+    bool flag() {
+        uint32_t word = u32();
+        if( word>1 )
+            throw Corrupt();
+
+        return word;
+    }
+
+    // Number of elements to follow. Each takes at least one word, which caps how much a corrupt count can allocate
+    size_t count() {
+        size_t ret = u32();
+        if( ret > numWords-position )
+            throw Corrupt();
+
+        return ret;
+    }
+
+    const Tokenizer::Token *token() {
+        uint32_t index = u32();
+        if( index==None )
+            return nullptr;
+        if( index>=tokens.size() || !inside( &tokens[index], 1 ) )
+            throw Corrupt();
+
+        return &tokens[index];
+    }
+
+    Slice<const Tokenizer::Token> slice() {
+        size_t size = u32();
+        if( size==0 )
+            return Slice<const Tokenizer::Token>();
+
+        size_t index = u32();
+        if( index>tokens.size() || size>tokens.size()-index || !inside( &tokens[index], size ) )
+            throw Corrupt();
+
+        return Slice<const Tokenizer::Token>( tokens.data() + index, size );
+    }
+
+    bool inside(const Tokenizer::Token *first, size_t size) const {
+        if( enclosing.size()==0 )
+            return true;
+
+        return first>=enclosing.get() && first+size<=enclosing.get()+enclosing.size();
+    }
+
+    std::string string() {
+        size_t size = u32();
+        if( size > (numWords-position)*sizeof(uint32_t) )
+            throw Corrupt();
+
+        std::string ret( size, '\0' );
+        for( size_t i=0; i<size; i+=sizeof(uint32_t) ) {
+            uint32_t word = u32();
+            memcpy( &ret[i], &word, std::min( sizeof(word), size-i ) );
+        }
+
+        return ret;
+    }
+
+    void read(Tokenizer::Token &token) {
+        uint32_t type = u32();
+        if( type > static_cast<uint32_t>(Tokenizer::Tokens::RESERVED_STRUCT) )
+            throw Corrupt();
+        token.token = static_cast<Tokenizer::Tokens>(type);
+
+        size_t offset = u32(), length = u32();
+        if( offset!=None ) {
+            if( offset>source.size() || length>source.size()-offset )
+                throw Corrupt();
+
+            token.text = String( source.get() + offset, length );
+        }
+
+        token.location.line = u32();
+        token.location.col = u32();
+        if( flag() )
+            token.symbol = Tokenizer::Symbols::intern( token.text );
+
+        switch( static_cast<ValueKind>( u32() ) ) {
+        case ValueKind::None:
+            break;
+        case ValueKind::SignedInt:
+            token.value = ExactInt( static_cast<signed __int128>( u128() ) );
+            break;
+        case ValueKind::UnsignedInt:
+            token.value = ExactInt( u128() );
+            break;
+        case ValueKind::Double:
+            {
+                uint64_t bits = u64();
+                double value;
+                memcpy( &value, &bits, sizeof(value) );
+                token.value = value;
+            }
+            break;
+        default:
+            throw Corrupt();
+        }
+    }
+
+    template<typename T>
+    void read(NodePtr<T> &node) {
+        if( flag() ) {
+            auto newborn = newNode< std::remove_const_t<T> >();
+            read( *newborn );
+            node = std::move( newborn );
+        }
+    }
+
+    template<size_t Index = 0, typename... Alternatives>
+    void readAlternative(std::variant<Alternatives...> &variant, size_t index) {
+        if constexpr( Index < sizeof...(Alternatives) ) {
+            if( index==Index )
+                read( variant.template emplace<Index>() );
+            else
+                readAlternative<Index+1>( variant, index );
+        } else {
+            throw Corrupt();
+        }
+    }
+
+    template<typename... Alternatives>
+    void read(std::variant<Alternatives...> &variant) {
+        readAlternative( variant, u32() );
+    }
+
+    template<typename T>
+    void read(std::vector<T> &vector) {
+        vector.resize( count() );
+        for( T &element : vector )
+            read( element );
+    }
+
+    void read(std::monostate &) {
+    }
+
+    void read(Identifier &identifier) {
+        NodeSlice nodeSlice( *this, identifier.parsedSlice );
+        identifier.identifier = token();
+    }
+
+    void read(Type &type) {
+        NodeSlice nodeSlice( *this, type.parsedSlice );
+
+        // Arrays and pointers cannot be default constructed, so they do not go through read(variant)
+        switch( u32() ) {
+        case 0:
+            type.type.emplace<std::monostate>();
+            break;
+        case 1:
+            read( type.type.emplace<Identifier>() );
+            break;
+        case 2:
+            {
+                const Tokenizer::Token *token = this->token();
+                NodePtr<const Type> elementType;
+                read( elementType );
+                auto &array = type.type.emplace<Type::Array>( std::move(elementType), token );
+                read( array.dimension );
+            }
+            break;
+        case 3:
+            {
+                const Tokenizer::Token *token = this->token();
+                NodePtr<const Type> pointed;
+                read( pointed );
+                type.type.emplace<Type::Pointer>( std::move(pointed), token );
+            }
+            break;
+        default:
+            throw Corrupt();
+        }
+    }
+
+    void read(LiteralInt &literal) {
+        NodeSlice nodeSlice( *this, literal.parsedSlice );
+        literal.token = token();
+        literal.value = u64();
+    }
+
+    void read(LiteralBool &literal) {
+        NodeSlice nodeSlice( *this, literal.parsedSlice );
+        literal.token = token();
+        literal.value = flag();
+    }
+
+    void read(LiteralPointer &literal) {
+        NodeSlice nodeSlice( *this, literal.parsedSlice );
+        literal.token = token();
+    }
+
+    void read(LiteralString &literal) {
+        NodeSlice nodeSlice( *this, literal.parsedSlice );
+        literal.token = token();
+        literal.value = string();
+    }
+
+    void read(Literal &literal) {
+        NodeSlice nodeSlice( *this, literal.parsedSlice );
+        read( literal.literal );
+    }
+
+    void read(FunctionArguments &arguments) {
+        NodeSlice nodeSlice( *this, arguments.parsedSlice );
+        read( arguments.arguments );
+    }
+
+    void read(Expression::UnaryOperator &op) {
+        op.op = token();
+        read( op.operand );
+    }
+
+    void read(Expression::BinaryOperator &op) {
+        op.op = token();
+        read( op.operands[0] );
+        read( op.operands[1] );
+    }
+
+    void read(Expression::CastOperator &op) {
+        op.op = token();
+        read( op.destType );
+        read( op.expression );
+    }
+
+    void read(Expression::FunctionCall &call) {
+        call.op = token();
+        read( call.expression );
+        read( call.arguments );
+    }
+
+    void read(ConditionalExpression &conditional) {
+        read( conditional.condition );
+        read( conditional.ifClause );
+        read( conditional.elseClause );
+    }
+
+    void read(Expression &expression) {
+        NodeSlice nodeSlice( *this, expression.parsedSlice );
+        read( expression.value );
+    }
+
+    void read(Statement::ConditionalStatement &conditional) {
+        read( conditional.condition );
+        read( conditional.ifClause );
+        read( conditional.elseClause );
+    }
+
+    void read(Statement &statement) {
+        NodeSlice nodeSlice( *this, statement.parsedSlice );
+        read( statement.content );
+    }
+
+    void read(StatementList &list) {
+        NodeSlice nodeSlice( *this, list.parsedSlice );
+        read( list.statements );
+    }
+
+    void read(CompoundExpression &compound) {
+        NodeSlice nodeSlice( *this, compound.parsedSlice );
+        read( compound.statementList );
+        read( compound.expression );
+    }
+
+    void read(CompoundStatement &compound) {
+        NodeSlice nodeSlice( *this, compound.parsedSlice );
+        read( compound.statements );
+    }
+
+    void read(VariableDeclBody &body) {
+        NodeSlice nodeSlice( *this, body.parsedSlice );
+        read( body.name );
+        read( body.type );
+    }
+
+    void read(VariableDefinition &definition) {
+        NodeSlice nodeSlice( *this, definition.parsedSlice );
+        read( definition.body );
+        read( definition.initValue );
+    }
+
+    void read(TransientType &type) {
+        NodeSlice nodeSlice( *this, type.parsedSlice );
+        read( type.type );
+        type.ref = token();
+    }
+
+    void read(FuncDeclRet &ret) {
+        NodeSlice nodeSlice( *this, ret.parsedSlice );
+        read( ret.type );
+    }
+
+    void read(FuncDeclArg &argument) {
+        NodeSlice nodeSlice( *this, argument.parsedSlice );
+        read( argument.name );
+        read( argument.type );
+    }
+
+    void read(FuncDeclArgs &arguments) {
+        NodeSlice nodeSlice( *this, arguments.parsedSlice );
+        read( arguments.arguments );
+    }
+
+    void read(FuncDeclBody &decl) {
+        NodeSlice nodeSlice( *this, decl.parsedSlice );
+        read( decl.name );
+        read( decl.arguments );
+        read( decl.returnType );
+    }
+
+    void read(FuncDef &function) {
+        NodeSlice nodeSlice( *this, function.parsedSlice );
+        read( function.decl );
+        read( function.body );
+    }
+
+    void read(FuncDecl &function) {
+        NodeSlice nodeSlice( *this, function.parsedSlice );
+        read( function.decl );
+        read( function.abiSpecifier );
+    }
+
+    void read(StructDef &structure) {
+        NodeSlice nodeSlice( *this, structure.parsedSlice );
+        structure.keyword = token();
+        read( structure.identifier );
+        read( structure.definitions );
+    }
+
+    void read(Module &module) {
+        NodeSlice nodeSlice( *this, module.parsedSlice );
+        read( module.functionDefinitions );
+        read( module.functionDeclarations );
+        read( module.structureDefinitions );
+    }
+};
+
+std::string ModuleCache::imagePath(const std::string &directory, String source) {
+    std::ostringstream path;
+    path << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << sourceHash(source) << ".prc";
+
+    return path.str();
+}
+
+bool ModuleCache::save(const Module &module, String source, const std::string &path) {
+    std::vector<uint32_t> image;
+    try {
+        image = std::move( Writer( module, source ).words );
+    } catch( Unrepresentable & ) {
+        return false;
+    } catch( PracticalSemanticAnalyzer::compile_error & ) {
+        // A lazily parsed body failed to parse
+        return false;
+    }
+
+    std::string temporary = path + "." + std::to_string( getpid() ) + ".tmp";
+    {
+        std::ofstream file( temporary, std::ios::binary | std::ios::trunc );
+        file.write( reinterpret_cast<const char *>( image.data() ), image.size() * sizeof(uint32_t) );
+        file.close();
+
+        if( !file ) {
+            std::remove( temporary.c_str() );
+            return false;
+        }
+    }
+
+    if( std::rename( temporary.c_str(), path.c_str() )!=0 ) {
+        std::remove( temporary.c_str() );
+        return false;
+    }
+
+    return true;
+}
+
+bool ModuleCache::load(Module &module, String source, const std::string &path) {
+    try {
+        Mmap<MapMode::ReadOnly> image( path );
+        Reader reader( module, source, image.getSlice<const char>() );
+    } catch( std::runtime_error & ) {
+        // No image
+        return false;
+    } catch( Corrupt & ) {
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace NonTerminals
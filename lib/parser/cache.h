@@ -0,0 +1,43 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef PARSER_CACHE_H
+#define PARSER_CACHE_H
+
+#include "parser/module.h"
+
+#include <string>
+
+namespace NonTerminals {
+
+// Binary images of parsed modules: their tokens and parse tree. Compiling a source that did not change since its image
+// was made loads the image, instead of lexing and parsing it again.
+//
+// Images hold no pointers. Tokens refer to the source by offset, and nodes refer to tokens by index. An image is only
+// valid for the exact source it was made from, which is why images are named after a hash of the source's content.
+class ModuleCache {
+public:
+    // Where the image of `source` goes in `directory`
+    static std::string imagePath(const std::string &directory, String source);
+
+    // The image is written under a temporary name and then renamed, so concurrent compilations never see a partial one.
+    // Returns false if writing failed, which leaves the cache as it was.
+    static bool save(const Module &module, String source, const std::string &path);
+
+    // Rebuild a newly constructed module from the image at path. Returns false if there is no usable image, in which case
+    // the module should be discarded.
+    static bool load(Module &module, String source, const std::string &path);
+
+private:
+    class Writer;
+    class Reader;
+};
+
+} // namespace NonTerminals
+
+#endif // PARSER_CACHE_H
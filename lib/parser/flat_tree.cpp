@@ -0,0 +1,265 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "parser/flat_tree.h"
+
+namespace NonTerminals {
+
+FlatTree::FlatTree( const FuncDef::Body &body, Slice<const Tokenizer::Token> tokens ) : tokens(tokens) {
+    // Most nodes take about one token
+    nodes.reserve( tokens.size() );
+
+    if( std::holds_alternative<CompoundExpression>( body ) )
+        add( std::get<CompoundExpression>( body ) );
+    else if( std::holds_alternative<CompoundStatement>( body ) )
+        add( std::get<CompoundStatement>( body ) );
+    else
+        ABORT()<<"Flattening a function body that was not parsed";
+}
+
+FlatTree::Cursor FlatTree::root() const {
+    ASSERT( !nodes.empty() );
+    return Cursor( this, 0 );
+}
+
+size_t FlatTree::Cursor::numChildren() const {
+    size_t ret = 0;
+    for( Cursor child : children() ) {
+        static_cast<void>(child);
+        ++ret;
+    }
+
+    return ret;
+}
+
+FlatTree::Cursor FlatTree::Cursor::child(size_t n) const {
+    for( Cursor child : children() ) {
+        if( n==0 )
+            return child;
+
+        --n;
+    }
+
+    ABORT()<<"Parse tree node has no child "<<n;
+}
+
+// Private
+uint32_t FlatTree::tokenIndex(const Tokenizer::Token *token) const {
+    if( token==nullptr )
+        return NoToken;
+
+    ASSERT( token>=tokens.get() && token<tokens.get()+tokens.size() )<<"Token outside of the flattened range";
+    return token - tokens.get();
+}
+
+uint32_t FlatTree::open(
+        Kind kind, const Tokenizer::Token *token, Slice<const Tokenizer::Token> parsed, uint32_t value )
+{
+    uint32_t index = nodes.size();
+    Node &node = nodes.emplace_back();
+
+    node.kind = kind;
+    node.end = index+1;
+    node.token = tokenIndex( token );
+    if( parsed.size()>0 ) {
+        node.firstToken = tokenIndex( parsed.get() );
+        node.lastToken = node.firstToken + parsed.size();
+    } else {
+        node.firstToken = node.lastToken = 0;
+    }
+    node.value = value;
+
+    return index;
+}
+
+void FlatTree::close(uint32_t node) {
+    nodes[node].end = nodes.size();
+}
+
+void FlatTree::add(const Expression &expression) {
+    struct Visitor {
+        FlatTree *_this;
+        Slice<const Tokenizer::Token> parsed;
+
+        void operator()( const NodePtr<CompoundExpression> &compound ) {
+            _this->add( *compound );
+        }
+
+        void operator()( const Literal &literal ) {
+            struct LiteralVisitor {
+                FlatTree *_this;
+                Slice<const Tokenizer::Token> parsed;
+
+                void operator()( const LiteralInt &literal ) {
+                    _this->integers.emplace_back( literal.value );
+                    _this->open( Kind::LiteralInt, literal.token, parsed, _this->integers.size()-1 );
+                }
+
+                void operator()( const LiteralBool &literal ) {
+                    _this->open( Kind::LiteralBool, literal.token, parsed, literal.value );
+                }
+
+                void operator()( const LiteralPointer &literal ) {
+                    _this->open( Kind::LiteralPointer, literal.token, parsed );
+                }
+
+                void operator()( const LiteralString &literal ) {
+                    _this->strings.emplace_back( literal.value );
+                    _this->open( Kind::LiteralString, literal.token, parsed, _this->strings.size()-1 );
+                }
+            };
+
+            std::visit( LiteralVisitor{ ._this = _this, .parsed = parsed }, literal.literal );
+        }
+
+        void operator()( const Identifier &identifier ) {
+            _this->open( Kind::Identifier, identifier.identifier, parsed );
+        }
+
+        void operator()( const Expression::UnaryOperator &op ) {
+            uint32_t node = _this->open( Kind::UnaryOperator, op.op, parsed );
+            _this->add( *op.operand );
+            _this->close( node );
+        }
+
+        void operator()( const Expression::BinaryOperator &op ) {
+            uint32_t node = _this->open( Kind::BinaryOperator, op.op, parsed );
+            _this->add( *op.operands[0] );
+            _this->add( *op.operands[1] );
+            _this->close( node );
+        }
+
+        void operator()( const Expression::CastOperator &op ) {
+            uint32_t node = _this->open( Kind::CastOperator, op.op, parsed );
+            _this->add( op.destType );
+            _this->add( *op.expression );
+            _this->close( node );
+        }
+
+        void operator()( const Expression::FunctionCall &call ) {
+            uint32_t node = _this->open( Kind::FunctionCall, call.op, parsed );
+            _this->add( *call.expression );
+            for( const Expression &argument : call.arguments.arguments )
+                _this->add( argument );
+            _this->close( node );
+        }
+
+        void operator()( const NodePtr<ConditionalExpression> &condition ) {
+            uint32_t node = _this->open(
+                    Kind::ConditionalExpression, parsed.size()>0 ? parsed.get() : nullptr, parsed );
+            _this->add( condition->condition );
+            _this->add( condition->ifClause );
+            _this->add( condition->elseClause );
+            _this->close( node );
+        }
+
+        void operator()( const Type &type ) {
+            _this->add( type );
+        }
+    };
+
+    std::visit( Visitor{ ._this = this, .parsed = expression.getNTTokens() }, expression.value );
+}
+
+void FlatTree::add(const Type &type) {
+    struct Visitor {
+        FlatTree *_this;
+        Slice<const Tokenizer::Token> parsed;
+
+        void operator()( std::monostate ) {
+            ABORT()<<"Flattening a type that was not parsed";
+        }
+
+        void operator()( const Identifier &identifier ) {
+            _this->open( Kind::TypeIdentifier, identifier.identifier, parsed );
+        }
+
+        void operator()( const Type::Array &array ) {
+            _this->integers.emplace_back( array.dimension.value );
+            uint32_t node = _this->open( Kind::TypeArray, array.token, parsed, _this->integers.size()-1 );
+            _this->add( *array.elementType );
+            _this->close( node );
+        }
+
+        void operator()( const Type::Pointer &pointer ) {
+            uint32_t node = _this->open( Kind::TypePointer, pointer.token, parsed );
+            _this->add( *pointer.pointed );
+            _this->close( node );
+        }
+    };
+
+    std::visit( Visitor{ ._this = this, .parsed = type.getNTTokens() }, type.type );
+}
+
+void FlatTree::add(const Statement &statement) {
+    struct Visitor {
+        FlatTree *_this;
+        Slice<const Tokenizer::Token> parsed;
+
+        void operator()( std::monostate ) {
+            _this->open( Kind::EmptyStatement, parsed.size()>0 ? parsed.get() : nullptr, parsed );
+        }
+
+        void operator()( const Expression &expression ) {
+            _this->add( expression );
+        }
+
+        void operator()( const VariableDefinition &definition ) {
+            _this->add( definition );
+        }
+
+        void operator()( const Statement::ConditionalStatement &condition ) {
+            uint32_t node = _this->open(
+                    Kind::ConditionalStatement, parsed.size()>0 ? parsed.get() : nullptr, parsed );
+            _this->add( condition.condition );
+            _this->add( *condition.ifClause );
+            if( condition.elseClause )
+                _this->add( *condition.elseClause );
+            _this->close( node );
+        }
+
+        void operator()( const NodePtr<CompoundStatement> &compound ) {
+            _this->add( *compound );
+        }
+    };
+
+    std::visit( Visitor{ ._this = this, .parsed = statement.getNTTokens() }, statement.content );
+}
+
+void FlatTree::add(const StatementList &statementList) {
+    Slice<const Tokenizer::Token> parsed = statementList.getNTTokens();
+    uint32_t node = open( Kind::StatementList, parsed.size()>0 ? parsed.get() : nullptr, parsed );
+    for( const Statement &statement : statementList.statements )
+        add( statement );
+    close( node );
+}
+
+void FlatTree::add(const CompoundExpression &compound) {
+    Slice<const Tokenizer::Token> parsed = compound.getNTTokens();
+    uint32_t node = open( Kind::CompoundExpression, parsed.size()>0 ? parsed.get() : nullptr, parsed );
+    add( compound.statementList );
+    add( compound.expression );
+    close( node );
+}
+
+void FlatTree::add(const CompoundStatement &compound) {
+    Slice<const Tokenizer::Token> parsed = compound.getNTTokens();
+    uint32_t node = open( Kind::CompoundStatement, parsed.size()>0 ? parsed.get() : nullptr, parsed );
+    add( compound.statements );
+    close( node );
+}
+
+void FlatTree::add(const VariableDefinition &definition) {
+    uint32_t node = open( Kind::VariableDefinition, definition.body.name.identifier, definition.getNTTokens() );
+    add( definition.body.type );
+    if( definition.initValue )
+        add( *definition.initValue );
+    close( node );
+}
+
+} // namespace NonTerminals
@@ -0,0 +1,206 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef PARSER_FLAT_TREE_H
+#define PARSER_FLAT_TREE_H
+
+#include "parser.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace NonTerminals {
+
+// Read only copy of a function body's parse tree, laid out for walking.
+//
+// Nodes live in a single array, in pre order. A node's children are the subtrees directly following it, so walking a
+// body is a linear scan of the array. Nodes hold no pointers: tokens are referred to by index into the range the tree
+// was built over, and nodes by index into the array.
+class FlatTree : private NoCopy {
+public:
+    enum class Kind : uint8_t {
+        // Expressions
+        CompoundExpression,     // Children: statement list, value
+        LiteralInt,
+        LiteralBool,
+        LiteralPointer,
+        LiteralString,
+        Identifier,
+        UnaryOperator,          // Children: operand
+        BinaryOperator,         // Children: left operand, right operand
+        CastOperator,           // Children: type, operand
+        FunctionCall,           // Children: function, arguments
+        ConditionalExpression,  // Children: condition, if clause, else clause
+
+        // Types. These may also stand where an expression is expected
+        TypeIdentifier,
+        TypeArray,              // Children: element type
+        TypePointer,            // Children: pointed type
+
+        // Statements. An expression statement is just the expression
+        EmptyStatement,
+        VariableDefinition,     // Children: type, initial value (optional)
+        ConditionalStatement,   // Children: condition, if clause, else clause (optional)
+        CompoundStatement,      // Children: statement list
+        StatementList,          // Children: statements
+    };
+
+    class Cursor;
+    class Children;
+
+    // tokens must hold all tokens the body refers to. Usually the function definition's
+    FlatTree( const FuncDef::Body &body, Slice<const Tokenizer::Token> tokens );
+
+    Cursor root() const;
+
+    size_t size() const {
+        return nodes.size();
+    }
+
+private:
+    static constexpr uint32_t NoToken = ~uint32_t(0);
+
+    struct Node {
+        Kind kind;
+        // Index of the first node after this one's subtree
+        uint32_t end;
+        // The node's operator, identifier or keyword. Where it is reported to be in the source
+        uint32_t token;
+        // Tokens the node was parsed from, [firstToken, lastToken)
+        uint32_t firstToken, lastToken;
+        // Kind specific. Boolean literals keep their value here. Integer literals and array dimensions keep an index
+        // into integers, and string literals one into strings
+        uint32_t value;
+    };
+
+    Slice<const Tokenizer::Token> tokens;
+    std::vector<Node> nodes;
+    std::vector<LongEnoughInt> integers;
+    std::vector<std::string> strings;
+
+    uint32_t tokenIndex(const Tokenizer::Token *token) const;
+    // Add a node with no children yet. Returns its index
+    uint32_t open(Kind kind, const Tokenizer::Token *token, Slice<const Tokenizer::Token> parsed, uint32_t value = 0);
+    void close(uint32_t node);
+
+    void add(const Expression &expression);
+    void add(const Type &type);
+    void add(const Statement &statement);
+    void add(const StatementList &statementList);
+    void add(const CompoundExpression &compound);
+    void add(const CompoundStatement &compound);
+    void add(const VariableDefinition &definition);
+};
+
+// A node in a FlatTree. Cheap to copy, and only valid for as long as the tree is
+class FlatTree::Cursor {
+    const FlatTree *tree = nullptr;
+    uint32_t index = 0;
+
+    friend FlatTree;
+    friend Children;
+
+    Cursor( const FlatTree *tree, uint32_t index ) : tree(tree), index(index) {}
+
+    const Node &node() const {
+        return tree->nodes[index];
+    }
+
+public:
+    Cursor() = default;
+
+    Kind kind() const {
+        return node().kind;
+    }
+
+    const Tokenizer::Token *token() const {
+        ASSERT( node().token!=NoToken )<<"Parse tree node has no token";
+        return &tree->tokens[ node().token ];
+    }
+
+    SourceLocation getLocation() const {
+        return token()->location;
+    }
+
+    Slice<const Tokenizer::Token> tokens() const {
+        return tree->tokens.subslice( node().firstToken, node().lastToken );
+    }
+
+    LongEnoughInt intValue() const {
+        ASSERT( kind()==Kind::LiteralInt || kind()==Kind::TypeArray );
+        return tree->integers[ node().value ];
+    }
+
+    bool boolValue() const {
+        ASSERT( kind()==Kind::LiteralBool );
+        return node().value;
+    }
+
+    const std::string &stringValue() const {
+        ASSERT( kind()==Kind::LiteralString );
+        return tree->strings[ node().value ];
+    }
+
+    inline Children children() const;
+    size_t numChildren() const;
+    // Finding a child is linear in n
+    Cursor child(size_t n) const;
+};
+
+// The children of a node, in order
+class FlatTree::Children {
+    const FlatTree *tree;
+    uint32_t first, past;
+
+public:
+    class Iterator {
+        const FlatTree *tree;
+        uint32_t index;
+
+    public:
+        Iterator( const FlatTree *tree, uint32_t index ) : tree(tree), index(index) {}
+
+        Cursor operator*() const {
+            return Cursor( tree, index );
+        }
+
+        Iterator &operator++() {
+            index = tree->nodes[index].end;
+            return *this;
+        }
+
+        bool operator==( const Iterator &rhs ) const {
+            return index==rhs.index;
+        }
+
+        bool operator!=( const Iterator &rhs ) const {
+            return index!=rhs.index;
+        }
+    };
+
+    explicit Children( Cursor parent ) :
+        tree( parent.tree ), first( parent.index+1 ), past( parent.node().end )
+    {}
+
+    Iterator begin() const {
+        return Iterator( tree, first );
+    }
+
+    Iterator end() const {
+        return Iterator( tree, past );
+    }
+};
+
+inline FlatTree::Children FlatTree::Cursor::children() const {
+    return Children( *this );
+}
+
+} // namespace NonTerminals
+
+#endif // PARSER_FLAT_TREE_H
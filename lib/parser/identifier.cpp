@@ -14,11 +14,12 @@ namespace NonTerminals {
 
 using namespace InternalNonTerminals;
 
-size_t Identifier::parse(Slice<const Tokenizer::Token> source) {
+ParseResult Identifier::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    identifier = &expectToken(Tokenizer::Tokens::IDENTIFIER, source, tokensConsumed, "Expected an identifier",
-            "EOF while parsing an identifier" );
+    RULE_CHECK( expectToken(Tokenizer::Tokens::IDENTIFIER, source, tokensConsumed, "Expected an identifier",
+            "EOF while parsing an identifier" ) );
+    identifier = &source[tokensConsumed-1];
 
     RULE_LEAVE();
 }
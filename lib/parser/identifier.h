@@ -18,7 +18,7 @@ namespace NonTerminals {
 struct Identifier : public NonTerminal {
     const Tokenizer::Token *identifier = nullptr;
 
-    size_t parse(Slice<const Tokenizer::Token> source) override final;
+    ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 
     String getName() const {
         return identifier->text;
@@ -16,10 +16,12 @@ namespace NonTerminals {
 
 using namespace InternalNonTerminals;
 
-size_t LiteralBool::parse(Slice<const Tokenizer::Token> source) {
+ParseResult LiteralBool::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    const Tokenizer::Token *currentToken = nextToken(source, tokensConsumed, "EOF while parsing literal");
+    const Tokenizer::Token *currentToken = nextToken(source, tokensConsumed);
+    if( currentToken==nullptr )
+        RULE_FAIL("EOF while parsing literal", SourceLocation());
 
     switch( currentToken->token ) {
     case Tokenizer::Tokens::RESERVED_FALSE:
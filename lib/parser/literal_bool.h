@@ -17,7 +17,7 @@ struct LiteralBool : public NonTerminal {
     const Tokenizer::Token *token = nullptr;
     bool value = 0;
 
-    size_t parse(Slice<const Tokenizer::Token> source) override final;
+    ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 };
 
 } // namespace NonTerminals
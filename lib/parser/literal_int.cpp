@@ -12,74 +12,39 @@
 
 #include <practical/errors.h>
 
+#include <limits>
+
 namespace NonTerminals {
 
 using namespace InternalNonTerminals;
 
-size_t LiteralInt::parse(Slice<const Tokenizer::Token> source) {
+ParseResult LiteralInt::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    const Tokenizer::Token *currentToken = nextToken(source, tokensConsumed, "EOF while parsing literal");
+    const Tokenizer::Token *currentToken = nextToken(source, tokensConsumed);
+    if( currentToken==nullptr )
+        RULE_FAIL("EOF while parsing literal", SourceLocation());
 
     switch( currentToken->token ) {
     case Tokenizer::Tokens::LITERAL_INT_2:
-        token = currentToken;
-        parseBinary();
-        break;
     case Tokenizer::Tokens::LITERAL_INT_8:
-        token = currentToken;
-        parseOctal();
-        break;
     case Tokenizer::Tokens::LITERAL_INT_10:
-        token = currentToken;
-        parseDecimal();
-        break;
     case Tokenizer::Tokens::LITERAL_INT_16:
         token = currentToken;
-        parseHexadecimal();
         break;
     default:
-        throw parser_error("Invalid integer literal", currentToken->location);
+        RULE_FAIL("Invalid integer literal", currentToken->location);
     }
 
-    RULE_LEAVE();
-}
-
-void LiteralInt::parseBinary() {
-    ABORT()<<"TODO implement binary literals";
-}
-
-void LiteralInt::parseOctal() {
-    ABORT()<<"TODO implement octal literals";
-}
-
-void LiteralInt::parseDecimal() {
-    value = 0;
-
-    for( char c: token->text ) {
-        static constexpr LongEnoughInt
-                LimitDivided = std::numeric_limits<LongEnoughInt>::max() / 10,
-                LimitTruncated = LimitDivided * 10,
-                LimitLastDigit = std::numeric_limits<LongEnoughInt>::max() % 10;
-
-        if( c=='_' )
-            continue;
-
-        if( value > LimitDivided )
-            throw IllegalLiteral( "Literal integer too big", token->location );
+    // The tokenizer already decoded the value
+    const ExactInt *decoded = std::get_if<ExactInt>( &token->value );
+    ASSERT( decoded!=nullptr ) << "Integer literal token " << *token << " has no decoded value";
+    if( *decoded > ExactInt( std::numeric_limits<LongEnoughInt>::max() ) )
+        throw IllegalLiteral( "Literal integer too big", token->location );
 
-        ASSERT( c>='0' && c<='9' ) << "Decimal literal has character '"<<c<<"' out of allowed range";
-        value *= 10;
-        if( value == LimitTruncated && c-'0'>LimitLastDigit )
-            throw IllegalLiteral( "Literal integer too big", token->location );
+    value = decoded->getUnsigned();
 
-        value += c-'0';
-    }
-
-}
-
-void LiteralInt::parseHexadecimal() {
-    ABORT()<<"TODO implement hexadecimal literals";
+    RULE_LEAVE();
 }
 
 } // namespace NonTerminals
@@ -17,13 +17,7 @@ struct LiteralInt : public NonTerminal {
     const Tokenizer::Token *token = nullptr;
     LongEnoughInt value = 0;
 
-    size_t parse(Slice<const Tokenizer::Token> source) override final;
-
-private:
-    void parseBinary();
-    void parseOctal();
-    void parseDecimal();
-    void parseHexadecimal();
+    ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 };
 
 } // namespace NonTerminals
@@ -17,12 +17,13 @@ namespace NonTerminals {
 
 using namespace InternalNonTerminals;
 
-size_t LiteralString::parse(Slice<const Tokenizer::Token> source) {
+ParseResult LiteralString::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    token = &expectToken(
+    RULE_CHECK( expectToken(
             Tokenizer::Tokens::LITERAL_STRING, source, tokensConsumed,
-            "Expected null literal", "EOF while parsing literal");
+            "Expected null literal", "EOF while parsing literal") );
+    token = &source[tokensConsumed-1];
 
     static const std::unordered_map<
             State,
@@ -15,7 +15,7 @@ namespace NonTerminals {
 
 struct LiteralString : public NonTerminal {
 public:
-    size_t parse(Slice<const Tokenizer::Token> source) override final;
+    ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 
 private:
     enum class State {
@@ -12,66 +12,292 @@
 
 #include <practical/errors.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
 namespace NonTerminals {
 
 using namespace InternalNonTerminals;
 
 void Module::parse(String source) {
-    tokens = Tokenizer::Tokenizer::tokenize(source);
+    tokens = Tokenizer::Tokenizer::tokenizeSignificant(source);
     parse(tokens);
 }
 
-size_t Module::parse(Slice<const Tokenizer::Token> source) {
-    RULE_ENTER(source);
+void Module::parseStreaming(String source) {
+    tokenStream = std::make_unique<Tokenizer::StreamingTokenizer>(source);
+    ArenaScope scope(arena);
 
-    skipWS(source, tokensConsumed);
-    while( tokensConsumed<source.size() ) {
-        const Tokenizer::Token *currentToken = wishForToken(
-                Tokenizer::Tokens::RESERVED_DEF,
-                source, tokensConsumed,
-                false);
-        if( currentToken != nullptr ) {
-            FuncDef func;
+    for(
+            Slice<const Tokenizer::Token> definition = tokenStream->nextDefinition();
+            definition.size()>0;
+            definition = tokenStream->nextDefinition() )
+    {
+        size_t consumed = 0;
+        skipWS(definition, consumed);
+        while( consumed<definition.size() ) {
+            bool failed = false;
+            try {
+                ParseResult result = parseDefinition( definition.subslice(consumed) );
+                if( result )
+                    consumed += result.consumed();
+                else if( tokenStream->exhausted() )
+                    result.raise();
+                else
+                    failed = true;
+            } catch( PracticalSemanticAnalyzer::compile_error & ) {
+                if( tokenStream->exhausted() )
+                    throw;
 
-            tokensConsumed += func.parse( source.subslice(tokensConsumed) );
-            functionDefinitions.emplace_back( std::move(func) );
+                failed = true;
+            }
 
-            skipWS(source, tokensConsumed);
-            continue;
+            if( failed ) {
+                // The definition may extend past where its brackets ended. Retry with everything that's left, which
+                // also reports the same error the non-streaming parse would.
+                definition = tokenStream->pinRemaining( definition.subslice(consumed) );
+                consumed = 0;
+            }
         }
+    }
+}
 
-        currentToken = wishForToken(
-                Tokenizer::Tokens::RESERVED_DECL,
-                source, tokensConsumed,
-                false);
-        if( currentToken != nullptr ) {
-            FuncDecl func;
+// Parallel parsing
+//
+// Top level definitions are found the same way the streaming tokenizer finds them: they end with a `;` or a `}` outside
+// of any brackets. Each is parsed on its own, by whichever worker thread gets to it first, into that worker's arena.
+//
+// The results are added to the module in order. A definition is taken as is only if it starts where the previous one
+// ended, and its parse used up all of its tokens. Otherwise, definitions are parsed sequentially until they line up with
+// the pre-scan again. Errors are thus always the ones the sequential parse would report.
+void Module::parseParallel(String source, unsigned threads) {
+    if( threads==0 )
+        threads = std::max( std::thread::hardware_concurrency(), 1u );
+    if( threads==1 ) {
+        parse(source);
+        return;
+    }
 
-            tokensConsumed += func.parse( source.subslice(tokensConsumed) );
-            functionDeclarations.emplace_back( std::move(func) );
+    tokens = Tokenizer::Tokenizer::tokenizeParallel(source, threads);
+    tokens.erase(
+            std::remove_if(
+                tokens.begin(), tokens.end(),
+                []( const Tokenizer::Token &token ) { return Tokenizer::Tokenizer::isTrivia(token.token); } ),
+            tokens.end() );
+    Slice<const Tokenizer::Token> allTokens( tokens );
 
-            skipWS(source, tokensConsumed);
-            continue;
+    struct Chunk {
+        size_t begin, end;
+        bool complete = false;
+        Definition definition;
+        // Anything but a syntax error, to be rethrown on the calling thread
+        std::exception_ptr error;
+    };
+
+    std::vector<Chunk> chunks;
+    unsigned depth = 0;
+    for( size_t i=0, begin=0; i<allTokens.size(); ++i ) {
+        bool done = false;
+
+        switch( allTokens[i].token ) {
+        case Tokenizer::Tokens::BRACKET_ROUND_OPEN:
+        case Tokenizer::Tokens::BRACKET_SQUARE_OPEN:
+        case Tokenizer::Tokens::BRACKET_CURLY_OPEN:
+            depth++;
+            break;
+        case Tokenizer::Tokens::BRACKET_ROUND_CLOSE:
+        case Tokenizer::Tokens::BRACKET_SQUARE_CLOSE:
+            if( depth>0 )
+                depth--;
+            break;
+        case Tokenizer::Tokens::BRACKET_CURLY_CLOSE:
+            if( depth>0 )
+                depth--;
+            done = depth==0;
+            break;
+        case Tokenizer::Tokens::SEMICOLON:
+            done = depth==0;
+            break;
+        default:
+            break;
+        }
+
+        if( done || i+1==allTokens.size() ) {
+            chunks.emplace_back( Chunk{ .begin=begin, .end=i+1, .complete=false, .definition={}, .error={} } );
+            begin = i+1;
         }
+    }
+
+    size_t numWorkers = std::min<size_t>( threads, chunks.size() );
+    if( numWorkers<=1 ) {
+        parse(allTokens);
+        return;
+    }
 
-        currentToken = wishForToken(
-                Tokenizer::Tokens::RESERVED_STRUCT,
-                source, tokensConsumed,
-                false);
-        if( currentToken != nullptr ) {
-            StructDef strct;
+    std::atomic<size_t> nextChunk = 0;
+    auto work = [&]( Arena &workerArena ) {
+        ArenaScope scope(workerArena);
 
-            tokensConsumed += strct.parse( source.subslice(tokensConsumed) );
-            structureDefinitions.emplace_back( std::move(strct) );
+        for( size_t i = nextChunk++; i<chunks.size(); i = nextChunk++ ) {
+            Chunk &chunk = chunks[i];
+            Slice<const Tokenizer::Token> definition = allTokens.subslice(chunk.begin, chunk.end);
+
+            try {
+                ParseResult result = parseDefinition( definition, chunk.definition );
+                chunk.complete = result && result.consumed()==definition.size();
+            } catch( PracticalSemanticAnalyzer::compile_error & ) {
+                // If the error is real, the sequential parse will report it
+            } catch( ... ) {
+                chunk.error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for( size_t i=1; i<numWorkers; ++i ) {
+        Arena &workerArena = *workerArenas.emplace_back( safenew<Arena>() );
+        workers.emplace_back( work, std::ref(workerArena) );
+    }
+    work( arena );
+    for( auto &worker : workers )
+        worker.join();
+
+    for( const Chunk &chunk : chunks ) {
+        if( chunk.error )
+            std::rethrow_exception( chunk.error );
+    }
+
+    ArenaScope scope(arena);
+    size_t position = 0;
+    auto chunk = chunks.begin();
+    while( position<allTokens.size() ) {
+        while( chunk!=chunks.end() && chunk->begin<position )
+            ++chunk;
+
+        if( chunk!=chunks.end() && chunk->begin==position && chunk->complete ) {
+            addDefinition( std::move(chunk->definition) );
+            position = chunk->end;
 
-            skipWS(source, tokensConsumed);
             continue;
         }
 
-        throw parser_error("Unidentified statement in global context", source[tokensConsumed].location );
+        ParseResult result = parseDefinition( allTokens.subslice(position) );
+        if( !result )
+            result.raise();
+
+        position += result.consumed();
+    }
+
+    parsedSlice = allTokens;
+}
+
+ParseResult Module::tryParse(Slice<const Tokenizer::Token> source) {
+    RULE_ENTER(source);
+    ArenaScope scope(arena);
+
+    skipWS(source, tokensConsumed);
+    while( tokensConsumed<source.size() ) {
+        RULE_PARSE( parseDefinition( source.subslice(tokensConsumed) ) );
     }
 
     RULE_LEAVE();
 }
 
+// Parse a single top level definition, along with the white space that follows it
+ParseResult Module::parseDefinition(Slice<const Tokenizer::Token> source, Definition &definition) const {
+    ParseMemo memo;
+    size_t tokensConsumed = 0;
+
+    const Tokenizer::Token *currentToken = wishForToken(
+            Tokenizer::Tokens::RESERVED_DEF,
+            source, tokensConsumed,
+            false);
+    if( currentToken != nullptr ) {
+        FuncDef &func = definition.emplace<FuncDef>();
+
+        ParseResult result = lazyFunctionBodies ?
+                func.tryParseDeclaration( source.subslice(tokensConsumed) ) :
+                func.tryParse( source.subslice(tokensConsumed) );
+        if( !result )
+            return result;
+
+        tokensConsumed += result.consumed();
+
+        skipWS(source, tokensConsumed);
+        return ParseResult::success(tokensConsumed);
+    }
+
+    currentToken = wishForToken(
+            Tokenizer::Tokens::RESERVED_DECL,
+            source, tokensConsumed,
+            false);
+    if( currentToken != nullptr ) {
+        FuncDecl &func = definition.emplace<FuncDecl>();
+
+        ParseResult result = func.tryParse( source.subslice(tokensConsumed) );
+        if( !result )
+            return result;
+
+        tokensConsumed += result.consumed();
+
+        skipWS(source, tokensConsumed);
+        return ParseResult::success(tokensConsumed);
+    }
+
+    currentToken = wishForToken(
+            Tokenizer::Tokens::RESERVED_STRUCT,
+            source, tokensConsumed,
+            false);
+    if( currentToken != nullptr ) {
+        StructDef &strct = definition.emplace<StructDef>();
+
+        ParseResult result = strct.tryParse( source.subslice(tokensConsumed) );
+        if( !result )
+            return result;
+
+        tokensConsumed += result.consumed();
+
+        skipWS(source, tokensConsumed);
+        return ParseResult::success(tokensConsumed);
+    }
+
+    return ParseResult::failure("Unidentified statement in global context", source[tokensConsumed].location );
+}
+
+ParseResult Module::parseDefinition(Slice<const Tokenizer::Token> source) {
+    Definition definition;
+
+    ParseResult result = parseDefinition(source, definition);
+    if( result )
+        addDefinition( std::move(definition) );
+
+    return result;
+}
+
+void Module::addDefinition(Definition &&definition) {
+    struct Visitor {
+        Module *_this;
+
+        void operator()( std::monostate ) {
+            ABORT()<<"Adding an unparsed definition";
+        }
+
+        void operator()( FuncDef &func ) {
+            _this->functionDefinitions.emplace_back( std::move(func) );
+        }
+
+        void operator()( FuncDecl &func ) {
+            _this->functionDeclarations.emplace_back( std::move(func) );
+        }
+
+        void operator()( StructDef &strct ) {
+            _this->structureDefinitions.emplace_back( std::move(strct) );
+        }
+    };
+
+    std::visit( Visitor{ ._this = this }, definition );
+}
+
 } // namespace NonTerminals
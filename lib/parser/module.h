@@ -12,19 +12,44 @@
 #include "parser/base.h"
 #include "parser/struct.h"
 #include "parser.h"
+#include "tokenizer/streaming.h"
+
+#include <memory>
 
 namespace NonTerminals {
     struct Module : public NonTerminal {
+        // Everything below may point into the arenas, so they go first
+        Arena arena;
+        // Used by the worker threads of parseParallel
+        std::vector< std::unique_ptr<Arena> > workerArenas;
         std::vector< FuncDef > functionDefinitions;
         std::vector< FuncDecl > functionDeclarations;
         std::vector< StructDef > structureDefinitions;
         std::vector< Tokenizer::Token > tokens;
+        // Owns the tokens when parsed with parseStreaming
+        std::unique_ptr< Tokenizer::StreamingTokenizer > tokenStream;
+        // Only find where function bodies end, and parse them when first asked for. For users that only need the
+        // declarations. Syntax errors inside a body are not reported until it is parsed
+        bool lazyFunctionBodies = false;
 
+        using NonTerminal::parse;
         void parse(String source);
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        // Lex and parse one top level definition at a time
+        void parseStreaming(String source);
+        // Same result as parse, but top level definitions are parsed concurrently. threads==0 means one per CPU
+        void parseParallel(String source, unsigned threads = 0);
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
         String getName() const {
             return toSlice("__main");
         }
+
+    private:
+        using Definition = std::variant<std::monostate, FuncDef, FuncDecl, StructDef>;
+
+        ParseResult parseDefinition(Slice<const Tokenizer::Token> source);
+        // Parse a definition without adding it to the module
+        ParseResult parseDefinition(Slice<const Tokenizer::Token> source, Definition &definition) const;
+        void addDefinition(Definition &&definition);
     };
 } // NonTerminals
 
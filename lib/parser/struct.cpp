@@ -14,24 +14,25 @@ namespace NonTerminals {
 
 using namespace InternalNonTerminals;
 
-size_t StructDef::parse(Slice<const Tokenizer::Token> source) {
+ParseResult StructDef::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    keyword = &expectToken( Tokenizer::Tokens::RESERVED_STRUCT, source, tokensConsumed,
-            "Struct definition must start with the keyword `struct`", "EOF looking for struct definition" );
-    tokensConsumed += identifier.parse( source.subslice(tokensConsumed) );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::RESERVED_STRUCT, source, tokensConsumed,
+            "Struct definition must start with the keyword `struct`", "EOF looking for struct definition" ) );
+    keyword = &source[tokensConsumed-1];
+    RULE_PARSE( identifier.tryParse( source.subslice(tokensConsumed) ) );
 
-    expectToken( Tokenizer::Tokens::BRACKET_CURLY_OPEN, source, tokensConsumed,
-            "Struct definition starts with `{`", "EOF looking for `{` in struct definition" );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::BRACKET_CURLY_OPEN, source, tokensConsumed,
+            "Struct definition starts with `{`", "EOF looking for `{` in struct definition" ) );
 
     const Tokenizer::Token *closingBracket =
             wishForToken( Tokenizer::Tokens::BRACKET_CURLY_CLOSE, source, tokensConsumed, true );
 
     while(closingBracket==nullptr) {
         VariableDefinition def;
-        tokensConsumed += def.parse( source.subslice(tokensConsumed) );
-        expectToken( Tokenizer::Tokens::SEMICOLON, source, tokensConsumed,
-                "Struct definitions must end with semicolon", "EOF while defining a struct" );
+        RULE_PARSE( def.tryParse( source.subslice(tokensConsumed) ) );
+        RULE_CHECK( expectToken( Tokenizer::Tokens::SEMICOLON, source, tokensConsumed,
+                "Struct definitions must end with semicolon", "EOF while defining a struct" ) );
 
         definitions.emplace_back( std::move(def) );
 
@@ -19,7 +19,7 @@ struct StructDef : public NonTerminal {
     Identifier identifier;
     std::vector<VariableDefinition> definitions;
 
-    size_t parse(Slice<const Tokenizer::Token> source) override final;
+    ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     SourceLocation getLocation() const {
         ASSERT(keyword != nullptr) << "Dereferencing an unparsed struct";
         return keyword->location;
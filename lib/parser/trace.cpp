@@ -0,0 +1,125 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "parser/trace.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace NonTerminals {
+
+std::atomic<bool> ParseTrace::enabled;
+
+namespace {
+
+std::atomic<size_t> traceCapacity;
+std::atomic<std::ostream *> failureDump;
+
+struct Ring {
+    std::vector<ParseTrace::Record> records;
+    // Records written so far. The ring's size is a power of 2, so the next one goes at `written` modulo the size
+    size_t written = 0;
+};
+
+thread_local Ring ring;
+
+} // anonymous namespace
+
+void ParseTrace::enable(size_t capacity, std::ostream *dumpOnFailure) {
+    size_t rounded = 1;
+    while( rounded<capacity )
+        rounded <<= 1;
+
+    traceCapacity.store( rounded, std::memory_order_relaxed );
+    failureDump.store( dumpOnFailure, std::memory_order_relaxed );
+    enabled.store( true, std::memory_order_release );
+}
+
+void ParseTrace::disable() {
+    enabled.store( false, std::memory_order_release );
+}
+
+void ParseTrace::dump(std::ostream &out) {
+    size_t size = ring.records.size();
+    size_t count = std::min( ring.written, size );
+    size_t depth = 0;
+
+    for( size_t i = ring.written - count; i<ring.written; ++i ) {
+        const Record &record = ring.records[ i & (size-1) ];
+
+        // The ring may have started mid rule, so don't trust depth to get back to 0
+        if( record.event!=Event::Enter && depth>0 )
+            depth--;
+
+        for( size_t j=0; j<depth; ++j )
+            out << "  ";
+
+        switch( record.event ) {
+        case Event::Enter:
+            out << "Enter ";
+            depth++;
+            break;
+        case Event::Success:
+            out << "Leave ";
+            break;
+        case Event::Failure:
+            out << "Fail ";
+            break;
+        }
+
+        out << record.rule << " at ";
+        if( !record.atEof )
+            out << record.location;
+        else
+            out << "EOF";
+
+        if( record.event==Event::Success )
+            out << " consumed " << record.consumed;
+        else if( record.event==Event::Failure )
+            out << ": " << record.message;
+
+        out << "\n";
+    }
+}
+
+void ParseTrace::clear() {
+    ring.written = 0;
+}
+
+void ParseTrace::parseFailed() {
+    if( !isEnabled() )
+        return;
+
+    std::ostream *out = failureDump.load( std::memory_order_relaxed );
+    if( out!=nullptr ) {
+        *out << "Parse failed. Trace of the last parser rules:\n";
+        dump( *out );
+    }
+}
+
+void ParseTrace::record(
+        const char *rule, Slice<const Tokenizer::Token> source, Event event, size_t consumed, const char *message)
+{
+    size_t capacity = traceCapacity.load( std::memory_order_relaxed );
+    if( ring.records.size()!=capacity ) {
+        ring.records.resize( capacity );
+        ring.written = 0;
+    }
+
+    ring.records[ ring.written++ & (capacity-1) ] = Record{
+        .rule = rule,
+        .location = source.size()>0 ? source[0].location : SourceLocation(),
+        .message = message,
+        .consumed = static_cast<uint32_t>( std::min<size_t>( consumed, std::numeric_limits<uint32_t>::max() ) ),
+        .event = event,
+        .atEof = source.size()==0
+    };
+}
+
+} // namespace NonTerminals
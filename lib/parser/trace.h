@@ -0,0 +1,86 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef PARSER_TRACE_H
+#define PARSER_TRACE_H
+
+#include "parser/base.h"
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+namespace NonTerminals {
+
+// Trace of the rules the parser goes through, switched on at run time. While enabled, each thread keeps its most recent
+// records in a ring buffer of its own. Disabled, a rule pays for one relaxed load.
+class ParseTrace {
+public:
+    static constexpr size_t DefaultCapacity = 4096;
+
+    enum class Event : uint8_t { Enter, Success, Failure };
+
+    struct Record {
+        // The rule's function name. A string literal
+        const char *rule;
+        // Where the first token the rule was asked to parse is. Records are kept by value, as the trace may be dumped
+        // after the tokens are gone
+        SourceLocation location;
+        // Failures only. A string literal
+        const char *message;
+        uint32_t consumed;
+        Event event;
+        bool atEof;
+    };
+
+    // capacity is in records, rounded up to a power of 2. If dumpOnFailure is not null, the trace of the thread is written
+    // to it whenever a parse fails. Writing to it is not synchronized between threads.
+    static void enable(size_t capacity = DefaultCapacity, std::ostream *dumpOnFailure = nullptr);
+    static void disable();
+
+    static bool isEnabled() {
+        return enabled.load( std::memory_order_relaxed );
+    }
+
+    // The calling thread's records, oldest first
+    static void dump(std::ostream &out);
+    static void clear();
+
+    // Called by the rule macros
+    static void enter(const char *rule, Slice<const Tokenizer::Token> source) {
+        if( isEnabled() )
+            record( rule, source, Event::Enter, 0, nullptr );
+    }
+
+    static void success(const char *rule, Slice<const Tokenizer::Token> source, size_t consumed) {
+        if( isEnabled() )
+            record( rule, source, Event::Success, consumed, nullptr );
+    }
+
+    static const ParseResult &failure(
+            const char *rule, Slice<const Tokenizer::Token> source, const ParseResult &result)
+    {
+        if( isEnabled() )
+            record( rule, source, Event::Failure, 0, result.getMessage() );
+
+        return result;
+    }
+
+    // A parse failed for good
+    static void parseFailed();
+
+private:
+    static std::atomic<bool> enabled;
+
+    static void record(
+            const char *rule, Slice<const Tokenizer::Token> source, Event event, size_t consumed, const char *message);
+};
+
+} // namespace NonTerminals
+
+#endif // PARSER_TRACE_H
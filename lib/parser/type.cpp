@@ -14,42 +14,44 @@ namespace NonTerminals {
 
 using namespace InternalNonTerminals;
 
-Type::Array::Array( std::unique_ptr< const Type > elementType, const Tokenizer::Token *token ) :
+Type::Array::Array( NodePtr< const Type > elementType, const Tokenizer::Token *token ) :
     elementType( std::move(elementType) ),
     token(token)
 {}
 
-size_t Type::parse(Slice<const Tokenizer::Token> source) {
+ParseResult Type::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
     Identifier &id = type.emplace<Identifier>();
 
-    tokensConsumed = id.parse( source );
+    RULE_PARSE( id.tryParse( source ) );
 
     bool done=false;
 
     do {
         size_t provisionalyConsumed = 0;
-        const Tokenizer::Token *token = nextToken( source.subslice(tokensConsumed), provisionalyConsumed, nullptr );
+        const Tokenizer::Token *token = nextToken( source.subslice(tokensConsumed), provisionalyConsumed );
         if( !token )
             break;
 
         switch( token->token ) {
         case Tokenizer::Tokens::BRACKET_SQUARE_OPEN:
             {
-                auto elementType = std::make_unique<Type>();
+                auto elementType = newNode<Type>();
                 elementType->type = std::move(type);
 
                 Array &array = type.emplace< Array >( std::move(elementType), token );
-                provisionalyConsumed += array.dimension.parse( source.subslice(tokensConsumed + provisionalyConsumed) );
-                expectToken(
+                ParseResult dimension = array.dimension.tryParse( source.subslice(tokensConsumed + provisionalyConsumed) );
+                RULE_CHECK( dimension );
+                provisionalyConsumed += dimension.consumed();
+                RULE_CHECK( expectToken(
                         Tokenizer::Tokens::BRACKET_SQUARE_CLOSE, source.subslice(tokensConsumed), provisionalyConsumed,
-                        "Array type with no closing bracket", "Array type with no closing bracket" );
+                        "Array type with no closing bracket", "Array type with no closing bracket" ) );
             }
             break;
         case Tokenizer::Tokens::OP_PTR:
             {
-                auto pointedType = std::make_unique<Type>();
+                auto pointedType = newNode<Type>();
                 pointedType->type = std::move(type);
 
                 type.emplace< Pointer >( std::move(pointedType), token );
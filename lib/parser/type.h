@@ -16,24 +16,24 @@ namespace NonTerminals {
 
 struct Type : public NonTerminal {
     struct Array {
-        std::unique_ptr< const Type > elementType;
+        NodePtr< const Type > elementType;
         LiteralInt dimension;
         const Tokenizer::Token *token = nullptr;
 
-        Array( std::unique_ptr< const Type > elementType, const Tokenizer::Token *token );
+        Array( NodePtr< const Type > elementType, const Tokenizer::Token *token );
     };
 
     struct Pointer {
-        std::unique_ptr< const Type > pointed;
+        NodePtr< const Type > pointed;
         const Tokenizer::Token *token = nullptr;
 
-        Pointer( std::unique_ptr< const Type > pointed, const Tokenizer::Token *token ) :
+        Pointer( NodePtr< const Type > pointed, const Tokenizer::Token *token ) :
             pointed(std::move(pointed)), token(token)
         {}
     };
     std::variant<std::monostate, Identifier, Array, Pointer> type;
 
-    size_t parse(Slice<const Tokenizer::Token> source) override final;
+    ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
     SourceLocation getLocation() const;
 };
 
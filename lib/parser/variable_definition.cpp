@@ -16,37 +16,35 @@ namespace NonTerminals {
 
 using namespace InternalNonTerminals;
 
-size_t VariableDeclBody::parse(Slice<const Tokenizer::Token> source) {
+ParseResult VariableDeclBody::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    tokensConsumed += name.parse(source);
-    expectToken( Tokenizer::Tokens::OP_COLON, source, tokensConsumed, "Expected \":\" after variable name", "Unexpected EOF" );
-    tokensConsumed += type.parse( source.subslice(tokensConsumed) );
+    RULE_PARSE( name.tryParse(source) );
+    RULE_CHECK( expectToken(
+            Tokenizer::Tokens::OP_COLON, source, tokensConsumed, "Expected \":\" after variable name", "Unexpected EOF" ) );
+    RULE_PARSE( type.tryParse( source.subslice(tokensConsumed) ) );
 
     RULE_LEAVE();
 }
 
-size_t VariableDefinition::parse(Slice<const Tokenizer::Token> source) {
+ParseResult VariableDefinition::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
-    expectToken( Tokenizer::Tokens::RESERVED_DEF, source, tokensConsumed, "Variable definition does not start with def keyword",
-            "Unexpected EOF" );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::RESERVED_DEF, source, tokensConsumed,
+            "Variable definition does not start with def keyword", "Unexpected EOF" ) );
 
-    tokensConsumed += body.parse(source.subslice(tokensConsumed));
+    RULE_PARSE( body.tryParse(source.subslice(tokensConsumed)) );
 
-    try {
-        size_t provisionalConsumed = tokensConsumed;
-
-        expectToken( Tokenizer::Tokens::OP_ASSIGN, source, provisionalConsumed, "", "" );
-
-        // XXX parse outside the catch
+    size_t provisionalConsumed = tokensConsumed;
+    if( wishForToken( Tokenizer::Tokens::OP_ASSIGN, source, provisionalConsumed ) ) {
         Expression initValue;
-        provisionalConsumed += initValue.parse( source.subslice(provisionalConsumed) );
-
-        this->initValue = safenew<Expression>( std::move(initValue) );
-        tokensConsumed = provisionalConsumed;
-    } catch( parser_error &err ) {
-        EXCEPTION_CAUGHT(err);
+        ParseResult result = initValue.tryParse( source.subslice(provisionalConsumed) );
+        if( result ) {
+            this->initValue = newNode<Expression>( std::move(initValue) );
+            tokensConsumed = provisionalConsumed + result.consumed();
+        } else {
+            FAILURE_CAUGHT(result);
+        }
     }
 
     RULE_LEAVE();
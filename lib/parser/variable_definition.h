@@ -22,14 +22,14 @@ struct VariableDeclBody : public NonTerminal {
     Identifier name;
     Type type;
 
-    size_t parse(Slice<const Tokenizer::Token> source) override final;
+    ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 };
 
 struct VariableDefinition : public NonTerminal {
     VariableDeclBody body;
-    std::unique_ptr<Expression> initValue;
+    NodePtr<Expression> initValue;
 
-    size_t parse(Slice<const Tokenizer::Token> source) override final;
+    ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 };
 
 } // NonTerminals
@@ -6,15 +6,40 @@
 size_t PARSER_RECURSION_DEPTH;
 #endif
 
+void NonTerminals::ParseResult::raise() const {
+    ASSERT( message!=nullptr ) << "Tried to raise an error for a successful parse";
+    ParseTrace::parseFailed();
+
+    throw parser_error(message, location);
+}
+
+thread_local Arena *NonTerminals::ArenaScope::current;
+
 namespace InternalNonTerminals {
 
+thread_local ParseMemo *ParseMemo::current;
+
+ParseMemo::ParseMemo() : previous(current) {
+    current = this;
+}
+
+ParseMemo::~ParseMemo() {
+    ASSERT( current==this ) << "Parse memos destroyed out of order";
+    current = previous;
+}
+
+ParseMemo::Entry *ParseMemo::lookup(Rule rule, Slice<const Tokenizer::Token> source) {
+    if( current==nullptr )
+        return nullptr;
+
+    return &current->entries[ Key{ .begin=source.get(), .size=source.size(), .rule=rule } ];
+}
+
+// A no-op on streams from tokenizeSignificant, which is what the parser normally gets
 bool skipWS(Slice<const Tokenizer::Token> source, size_t &index) {
     bool moved = false;
 
-    while( index<source.size() &&
-            (source[index].token == Tokenizer::Tokens::WS || source[index].token == Tokenizer::Tokens::COMMENT_LINE_END ||
-             source[index].token == Tokenizer::Tokens::COMMENT_MULTILINE) )
-    {
+    while( index<source.size() && Tokenizer::Tokenizer::isTrivia( source[index].token ) ) {
         index++;
         moved = true;
     }
@@ -22,36 +47,33 @@ bool skipWS(Slice<const Tokenizer::Token> source, size_t &index) {
     return moved;
 }
 
-// Consumes the next token, optionally reporting EOF
-const Tokenizer::Token *nextToken(Slice<const Tokenizer::Token> source, size_t &index, const char *msg) {
+// Consumes the next token
+const Tokenizer::Token *nextToken(Slice<const Tokenizer::Token> source, size_t &index) {
     skipWS(source, index);
 
-    if( index==source.size() ) {
-        if( msg==nullptr )
-            return nullptr;
-        else
-            throw parser_error(msg, SourceLocation());
-    }
+    if( index==source.size() )
+        return nullptr;
 
     return &source[index++];
 }
 
-const Tokenizer::Token &expectToken(
+ParseResult expectToken(
         Tokenizer::Tokens expected, Slice<const Tokenizer::Token> source, size_t &index, const char *mismatchMsg,
         const char *eofMsg)
 {
     if( eofMsg==nullptr )
         eofMsg=mismatchMsg;
 
-    const Tokenizer::Token *currentToken = nextToken( source, index, eofMsg );
-    ASSERT( currentToken!=nullptr ) << "Unexpected EOF condition when searching for token";
+    const Tokenizer::Token *currentToken = nextToken( source, index );
+    if( currentToken==nullptr )
+        return ParseResult::failure( eofMsg, SourceLocation() );
 
     if( currentToken->token!=expected ) {
         index--;
-        throw parser_error(mismatchMsg, currentToken->location);
+        return ParseResult::failure( mismatchMsg, currentToken->location );
     }
 
-    return *currentToken;
+    return ParseResult::success(1);
 }
 
 const Tokenizer::Token *wishForToken(
@@ -79,23 +101,23 @@ const Tokenizer::Token *wishForToken(
     return nullptr;
 }
 
-size_t ExpressionOrStatement::parse(Slice<const Tokenizer::Token> source) {
+ParseResult ExpressionOrStatement::tryParse(Slice<const Tokenizer::Token> source) {
     RULE_ENTER(source);
 
     if( wishForToken( Tokenizer::Tokens::BRACKET_CURLY_OPEN, source, tokensConsumed, false ) ) {
         CompoundExpressionOrStatement parsed;
-        tokensConsumed = parsed.parse(source);
+        RULE_PARSE( parsed.tryParse(source) );
 
         if( parsed.isStatement() )
-            content.emplace<Statement>( safenew<CompoundStatement>(parsed.removeStatement()) );
+            content.emplace<Statement>( newNode<CompoundStatement>(parsed.removeStatement()) );
         else
-            content.emplace<NonTerminals::Expression>( safenew<CompoundExpression>(parsed.removeExpression()) );
+            content.emplace<NonTerminals::Expression>( newNode<CompoundExpression>(parsed.removeExpression()) );
 
         RULE_LEAVE();
     }
 
     Expression expression;
-    tokensConsumed = expression.parse(source);
+    RULE_PARSE( expression.tryParse(source) );
 
     if( wishForToken( Tokenizer::Tokens::SEMICOLON, source, tokensConsumed ) )
         content.emplace<Statement>( std::move(expression) );
@@ -105,30 +127,43 @@ size_t ExpressionOrStatement::parse(Slice<const Tokenizer::Token> source) {
     RULE_LEAVE();
 }
 
-size_t ConditionalExpressionOrStatement::parse(Slice<const Tokenizer::Token> source ) {
-    return parse( source, ExpectedResult::Unknown );
+ParseResult ConditionalExpressionOrStatement::tryParse(Slice<const Tokenizer::Token> source ) {
+    return tryParse( source, ExpectedResult::Unknown );
+}
+
+ParseResult ConditionalExpressionOrStatement::tryParse(Slice<const Tokenizer::Token> source, ExpectedResult result ) {
+    RULE_ENTER(source);
+
+    ASSERT( result!=ExpectedResult::Statement ) << "Conditional statements are parsed with an unknown expected result";
+    RULE_PARSE( ParseMemo::parse(
+            result==ExpectedResult::Unknown ? ParseMemo::Rule::ConditionalUnknown : ParseMemo::Rule::ConditionalExpression,
+            *this, source, [&]() { return parseFresh(source, result); } ) );
+
+    RULE_LEAVE();
 }
 
-size_t ConditionalExpressionOrStatement::parse(Slice<const Tokenizer::Token> source, ExpectedResult result ) {
+ParseResult ConditionalExpressionOrStatement::parseFresh(Slice<const Tokenizer::Token> source, ExpectedResult result ) {
     RULE_ENTER(source);
 
-    auto ifToken = expectToken(
+    RULE_CHECK( expectToken(
             Tokenizer::Tokens::RESERVED_IF, source, tokensConsumed,
-            "Condition must start with 'if'", "EOF searching for condition" );
+            "Condition must start with 'if'", "EOF searching for condition" ) );
+    const Tokenizer::Token &ifToken = source[tokensConsumed-1];
 
     Expression condition;
 
-    expectToken( Tokenizer::Tokens::BRACKET_ROUND_OPEN, source, tokensConsumed, "Expecting '(' after if" );
-    tokensConsumed += condition.parse( source.subslice(tokensConsumed) );
-    expectToken( Tokenizer::Tokens::BRACKET_ROUND_CLOSE, source, tokensConsumed, "Expecting ')' at end of condition" );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::BRACKET_ROUND_OPEN, source, tokensConsumed, "Expecting '(' after if" ) );
+    RULE_PARSE( condition.tryParse( source.subslice(tokensConsumed) ) );
+    RULE_CHECK( expectToken(
+            Tokenizer::Tokens::BRACKET_ROUND_CLOSE, source, tokensConsumed, "Expecting ')' at end of condition" ) );
 
     ExpressionOrStatement ifClause;
-    tokensConsumed += ifClause.parse( source.subslice(tokensConsumed) );
+    RULE_PARSE( ifClause.tryParse( source.subslice(tokensConsumed) ) );
 
     std::unique_ptr<ExpressionOrStatement> elseClause;
     if( wishForToken(Tokenizer::Tokens::RESERVED_ELSE, source, tokensConsumed) ) {
         elseClause = safenew<ExpressionOrStatement>();
-        tokensConsumed += elseClause->parse( source.subslice(tokensConsumed) );
+        RULE_PARSE( elseClause->tryParse( source.subslice(tokensConsumed) ) );
     }
 
     if( result==ExpectedResult::Unknown )
@@ -139,32 +174,32 @@ size_t ConditionalExpressionOrStatement::parse(Slice<const Tokenizer::Token> sou
     case ExpectedResult::Statement:
         {
             if( ! ifClause.isStatement() )
-                throw parser_error(
+                RULE_FAIL(
                         "condition must have statement (not expression) as \"then\" clause", ifToken.location);
 
             if( elseClause && !elseClause->isStatement() )
-                throw parser_error(
+                RULE_FAIL(
                         "condition must have statement (not expression) as \"else\" clause", ifToken.location);
 
             auto &statement=this->condition.emplace<Statement::ConditionalStatement>();
             statement.condition=std::move(condition);
-            statement.ifClause = safenew<Statement>( ifClause.removeStatement() );
+            statement.ifClause = newNode<Statement>( ifClause.removeStatement() );
             if( elseClause )
-                statement.elseClause = safenew<Statement>( elseClause->removeStatement() );
+                statement.elseClause = newNode<Statement>( elseClause->removeStatement() );
         }
         break;
     case ExpectedResult::Expression:
         {
             if( ifClause.isStatement() )
-                throw parser_error(
+                RULE_FAIL(
                         "condition must have expression (not statement) as \"then\" clause", ifToken.location);
 
             if( !elseClause )
-                throw parser_error(
+                RULE_FAIL(
                         "conditional expression must have an \"else\" clause", ifToken.location);
 
             if( elseClause->isStatement() )
-                throw parser_error(
+                RULE_FAIL(
                         "condition must have expression (not statement) as \"else\" clause", ifToken.location);
 
             auto &expression = this->condition.emplace<ConditionalExpression>();
@@ -173,11 +208,11 @@ size_t ConditionalExpressionOrStatement::parse(Slice<const Tokenizer::Token> sou
             expression.elseClause = elseClause->removeExpression();
 
             if(
-                    ! std::get_if< std::unique_ptr<CompoundExpression> >(& expression.ifClause.value) ||
-                    ! std::get_if< std::unique_ptr<CompoundExpression> >(& expression.elseClause.value)
+                    ! std::get_if< NodePtr<CompoundExpression> >(& expression.ifClause.value) ||
+                    ! std::get_if< NodePtr<CompoundExpression> >(& expression.elseClause.value)
               )
             {
-                throw parser_error(
+                RULE_FAIL(
                         "Conditional expression must use compound expressions for \"then\" and \"else\" clauses",
                         ifToken.location);
             }
@@ -205,31 +240,53 @@ CompoundExpression CompoundExpressionOrStatement::removeExpression() {
     return CompoundExpression( std::move( std::get<CompoundExpression>(content) ) );
 }
 
-size_t CompoundExpressionOrStatement::parseInternal(Slice<const Tokenizer::Token> source, ParseType parseType) {
+ParseResult CompoundExpressionOrStatement::parseInternal(Slice<const Tokenizer::Token> source, ParseType parseType) {
+    RULE_ENTER(source);
+
+    ParseMemo::Rule rule = ParseMemo::Rule::CompoundEither;
+    switch( parseType ) {
+    case ParseType::Either:
+        break;
+    case ParseType::Statement:
+        rule = ParseMemo::Rule::CompoundStatement;
+        break;
+    case ParseType::Expression:
+        rule = ParseMemo::Rule::CompoundExpression;
+        break;
+    }
+
+    RULE_PARSE( ParseMemo::parse( rule, *this, source, [&]() { return parseFresh(source, parseType); } ) );
+
+    RULE_LEAVE();
+}
+
+ParseResult CompoundExpressionOrStatement::parseFresh(Slice<const Tokenizer::Token> source, ParseType parseType) {
     RULE_ENTER(source);
 
-    expectToken( Tokenizer::Tokens::BRACKET_CURLY_OPEN, source, tokensConsumed, "Expected {",
-            "EOF while parsing compound statement" );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::BRACKET_CURLY_OPEN, source, tokensConsumed, "Expected {",
+            "EOF while parsing compound statement" ) );
 
     StatementList statementList;
-    tokensConsumed += statementList.parse(source.subslice(tokensConsumed));
+    RULE_PARSE( statementList.tryParse(source.subslice(tokensConsumed)) );
+
+    if( parseType!=ParseType::Statement ) {
+        Expression expression;
+        ParseResult result = expression.tryParse(source.subslice(tokensConsumed));
 
-    try {
-        if( parseType!=ParseType::Statement ) {
-            Expression expression;
-            tokensConsumed += expression.parse(source.subslice(tokensConsumed));
+        if( result ) {
+            tokensConsumed += result.consumed();
 
             parseType=ParseType::Expression;
 
             content.emplace<CompoundExpression>( std::move(statementList), std::move(expression) );
-        }
-    } catch( parser_error &err ) {
-        if( parseType==ParseType::Expression )
-            throw;
+        } else {
+            if( parseType==ParseType::Expression )
+                RULE_FAILED(result);
 
-        EXCEPTION_CAUGHT(err);
+            FAILURE_CAUGHT(result);
 
-        parseType = ParseType::Statement;
+            parseType = ParseType::Statement;
+        }
     }
 
     ASSERT( parseType!=ParseType::Either );
@@ -237,8 +294,8 @@ size_t CompoundExpressionOrStatement::parseInternal(Slice<const Tokenizer::Token
         content.emplace<CompoundStatement>( std::move(statementList) );
     }
 
-    expectToken( Tokenizer::Tokens::BRACKET_CURLY_CLOSE, source, tokensConsumed, "Expected }",
-            "Unmatched {" );
+    RULE_CHECK( expectToken( Tokenizer::Tokens::BRACKET_CURLY_CLOSE, source, tokensConsumed, "Expected }",
+            "Unmatched {" ) );
 
     RULE_LEAVE();
 }
@@ -10,11 +10,18 @@
 #define PARSER_INTERNAL_H
 
 #include "parser.h"
+#include "parser/trace.h"
+
+#include "nocopy.h"
+
+#include <functional>
+#include <unordered_map>
 
 #if VERBOSE_PARSING
 extern size_t PARSER_RECURSION_DEPTH;
 
 #define RULE_ENTER(source) \
+    ::NonTerminals::ParseTrace::enter(__PRETTY_FUNCTION__, source); \
     size_t RECURSION_CURRENT_DEPTH = PARSER_RECURSION_DEPTH++; \
     for( size_t I=0; I<RECURSION_CURRENT_DEPTH; ++I ) std::cout<<"  "; \
     if( source.size()>0 ) \
@@ -28,23 +35,56 @@ extern size_t PARSER_RECURSION_DEPTH;
     for( size_t I=0; I<RECURSION_CURRENT_DEPTH; ++I ) std::cout<<"  "; \
     std::cout<<"Leaving " << __PRETTY_FUNCTION__ << " consumed " << tokensConsumed << "\n"; \
     this->parsedSlice = source.subslice(0, tokensConsumed); \
-    return tokensConsumed
+    ::NonTerminals::ParseTrace::success(__PRETTY_FUNCTION__, source, tokensConsumed); \
+    return ParseResult::success(tokensConsumed)
 
-#define EXCEPTION_CAUGHT(ex) \
-    PARSER_RECURSION_DEPTH = RECURSION_CURRENT_DEPTH + 1; \
+#define RULE_FAILED(result) \
+    do { \
+        PARSER_RECURSION_DEPTH = RECURSION_CURRENT_DEPTH; \
+        for( size_t I=0; I<RECURSION_CURRENT_DEPTH; ++I ) std::cout<<"  "; \
+        std::cout<<"Failing " << __PRETTY_FUNCTION__ << ": " << (result).getMessage() << "\n"; \
+        return ::NonTerminals::ParseTrace::failure(__PRETTY_FUNCTION__, source, result); \
+    } while(false)
+
+#define FAILURE_CAUGHT(result) \
     for( size_t I=0; I<RECURSION_CURRENT_DEPTH; ++I ) std::cout<<"  "; \
-    std::cout<< __PRETTY_FUNCTION__ << " caught " << ex.what() << "\n"
+    std::cout<< __PRETTY_FUNCTION__ << " caught " << (result).getMessage() << "\n"
 
 #else
 
-#define RULE_ENTER(source) size_t tokensConsumed = 0
+// Tracing through ParseTrace is always available. It is switched on at run time
+#define RULE_ENTER(source) \
+    ::NonTerminals::ParseTrace::enter(__PRETTY_FUNCTION__, source); \
+    size_t tokensConsumed = 0
 #define RULE_LEAVE() \
     this->parsedSlice = source.subslice(0, tokensConsumed); \
-    return tokensConsumed
-#define EXCEPTION_CAUGHT(ex)
+    ::NonTerminals::ParseTrace::success(__PRETTY_FUNCTION__, source, tokensConsumed); \
+    return ParseResult::success(tokensConsumed)
+#define RULE_FAILED(result) return ::NonTerminals::ParseTrace::failure(__PRETTY_FUNCTION__, source, result)
+#define FAILURE_CAUGHT(result)
 
 #endif
 
+// Leave the rule, reporting that it does not match
+#define RULE_FAIL(message, location) RULE_FAILED( ParseResult::failure(message, location) )
+
+// Leave the rule if `result`, of a sub rule or token match, is a failure
+#define RULE_CHECK(result) \
+    do { \
+        ParseResult RULE_RESULT = (result); \
+        if( !RULE_RESULT ) \
+            RULE_FAILED(RULE_RESULT); \
+    } while(false)
+
+// Same as RULE_CHECK, and add what the sub rule consumed to tokensConsumed
+#define RULE_PARSE(result) \
+    do { \
+        ParseResult RULE_RESULT = (result); \
+        if( !RULE_RESULT ) \
+            RULE_FAILED(RULE_RESULT); \
+        tokensConsumed += RULE_RESULT.consumed(); \
+    } while(false)
+
 namespace InternalNonTerminals {
     using namespace NonTerminals;
 
@@ -55,8 +95,10 @@ namespace InternalNonTerminals {
     };
 
     bool skipWS(Slice<const Tokenizer::Token> source, size_t &index);
-    const Tokenizer::Token *nextToken(Slice<const Tokenizer::Token> source, size_t &index, const char *msg = nullptr);
-    const Tokenizer::Token &expectToken(
+    // nullptr at EOF
+    const Tokenizer::Token *nextToken(Slice<const Tokenizer::Token> source, size_t &index);
+    // On success, index is past the matched token, which is source[index-1]
+    ParseResult expectToken(
             Tokenizer::Tokens expected, Slice<const Tokenizer::Token> source, size_t &index, const char *mismatchMsg,
             const char *eofMsg = nullptr);
 
@@ -66,10 +108,112 @@ namespace InternalNonTerminals {
             size_t &index,
             bool consumeTokens = true);
 
+    // Outcomes of the rules the parser backtracks over, so each of them runs at most once at any given position.
+    //
+    // Failures are remembered and reported again. A success is only worth remembering together with its result, so callers
+    // that throw away a successful parse because something after it did not match hand the result over with keep().
+    // Memoization is only in effect while a ParseMemo exists on the thread, which should span one parse of one buffer.
+    class ParseMemo : private NoCopy {
+    public:
+        enum class Rule : uint8_t {
+            Expression,
+            Statement,
+            CompoundEither,
+            CompoundExpression,
+            CompoundStatement,
+            ConditionalUnknown,
+            ConditionalExpression,
+        };
+
+        ParseMemo();
+        ~ParseMemo();
+
+        // Run `parser` to parse `target` from source, unless the rule already ran at the same place
+        template<typename NT, typename Parser>
+        static ParseResult parse(Rule rule, NT &target, Slice<const Tokenizer::Token> source, Parser parser);
+
+        // Remember a successful parse that the caller has no use for after all, for whoever asks for it next
+        template<typename NT>
+        static void keep(Rule rule, Slice<const Tokenizer::Token> source, size_t consumed, NT &&result);
+
+    private:
+        enum class Outcome : uint8_t { Unknown, Succeeded, Kept, Failed };
+
+        struct Key {
+            const Tokenizer::Token *begin;
+            size_t size;
+            Rule rule;
+
+            bool operator==(const Key &that) const {
+                return begin==that.begin && size==that.size && rule==that.rule;
+            }
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key &key) const {
+                return std::hash<const void *>()(key.begin) ^ (key.size << 3) ^ static_cast<size_t>(key.rule);
+            }
+        };
+
+        struct Entry {
+            Outcome outcome = Outcome::Unknown;
+            ParseResult result = ParseResult::success(0);
+            std::unique_ptr<NonTerminal> kept;
+        };
+
+        // Node based, so entries stay put while nested rules add their own
+        std::unordered_map<Key, Entry, KeyHash> entries;
+        ParseMemo *previous;
+
+        static thread_local ParseMemo *current;
+
+        // nullptr if there is no memo in effect
+        static Entry *lookup(Rule rule, Slice<const Tokenizer::Token> source);
+    };
+
+    template<typename NT, typename Parser>
+    ParseResult ParseMemo::parse(Rule rule, NT &target, Slice<const Tokenizer::Token> source, Parser parser) {
+        Entry *entry = lookup(rule, source);
+        if( entry==nullptr )
+            return parser();
+
+        switch( entry->outcome ) {
+        case Outcome::Failed:
+            return entry->result;
+        case Outcome::Kept:
+            target = std::move( static_cast<NT &>( *entry->kept ) );
+            entry->kept.reset();
+            entry->outcome = Outcome::Succeeded;
+
+            return entry->result;
+        case Outcome::Succeeded:
+            // Whoever got the result the last time is still using it
+        case Outcome::Unknown:
+            break;
+        }
+
+        ParseResult result = parser();
+        entry->result = result;
+        entry->outcome = result ? Outcome::Succeeded : Outcome::Failed;
+
+        return result;
+    }
+
+    template<typename NT>
+    void ParseMemo::keep(Rule rule, Slice<const Tokenizer::Token> source, size_t consumed, NT &&result) {
+        Entry *entry = lookup(rule, source);
+        if( entry==nullptr )
+            return;
+
+        entry->outcome = Outcome::Kept;
+        entry->result = ParseResult::success(consumed);
+        entry->kept = safenew<NT>( std::move(result) );
+    }
+
     struct ExpressionOrStatement : public NonTerminal {
         std::variant<std::monostate, Expression, Statement> content;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
 
         bool isStatement() const {
             ASSERT( content.index()!=0 )<<
@@ -96,8 +240,8 @@ namespace InternalNonTerminals {
                 Statement::ConditionalStatement
             > condition;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final;
-        size_t parse(Slice<const Tokenizer::Token> source, ExpectedResult result);
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final;
+        ParseResult tryParse(Slice<const Tokenizer::Token> source, ExpectedResult result);
 
         bool isStatement() const {
             ASSERT( condition.index()!=0 )<<
@@ -111,18 +255,21 @@ namespace InternalNonTerminals {
         Statement::ConditionalStatement removeStatement() {
             return Statement::ConditionalStatement( std::move( std::get<Statement::ConditionalStatement>(condition) ) );
         }
+
+    private:
+        ParseResult parseFresh(Slice<const Tokenizer::Token> source, ExpectedResult result);
     };
 
     struct CompoundExpressionOrStatement : public NonTerminal {
         std::variant<std::monostate, CompoundExpression, CompoundStatement> content;
 
-        size_t parse(Slice<const Tokenizer::Token> source) override final {
+        ParseResult tryParse(Slice<const Tokenizer::Token> source) override final {
             return parseInternal(source, ParseType::Either);
         }
-        size_t parseExpression(Slice<const Tokenizer::Token> source) {
+        ParseResult parseExpression(Slice<const Tokenizer::Token> source) {
             return parseInternal(source, ParseType::Expression);
         }
-        size_t parseStatement(Slice<const Tokenizer::Token> source) {
+        ParseResult parseStatement(Slice<const Tokenizer::Token> source) {
             return parseInternal(source, ParseType::Statement);
         }
 
@@ -132,7 +279,8 @@ namespace InternalNonTerminals {
 
     private:
         enum class ParseType { Either, Statement, Expression };
-        size_t parseInternal(Slice<const Tokenizer::Token> source, ParseType parseType);
+        ParseResult parseInternal(Slice<const Tokenizer::Token> source, ParseType parseType);
+        ParseResult parseFresh(Slice<const Tokenizer::Token> source, ParseType parseType);
     };
 } // InternalNonTerminals
 
@@ -12,6 +12,7 @@
 #include "ast/static_type.h"
 #include "mmap.h"
 #include "parser.h"
+#include "parser/cache.h"
 
 #include <practical/defines.h>
 #include <practical/practical.h>
@@ -66,6 +67,9 @@ bool StaticType::Array::operator==( const Array &rhs ) const {
 }
 
 bool StaticType::operator==( const StaticType &rhs ) const {
+    if( this==&rhs )
+        return true;
+
     auto leftType = getType();
     auto rightType = rhs.getType();
 
@@ -98,6 +102,64 @@ bool StaticType::operator==( const StaticType &rhs ) const {
     return std::visit( Visitor{ .rightTypes = rhs.getType() }, getType() );
 }
 
+size_t StaticType::calculateHash() const {
+    static constexpr size_t PointerModifier = 4;
+    static constexpr size_t ReferenceModifier = 6;
+    static constexpr size_t MutableModifier = 10;
+    static constexpr size_t ArrayModifier = 14;
+
+    auto typeType = getType();
+
+    struct Visitor {
+        static size_t componentHash( const CPtr &type ) {
+            // The generic function type has no return type
+            return type ? type->getHash() : 0;
+        }
+
+        size_t operator()( const Scalar *scalar ) {
+            return std::hash<String>{}( scalar->getName() );
+        }
+
+        size_t operator()( const Function *function ) {
+            size_t result = 0;
+
+            auto numArguments = function->getNumArguments();
+            for( unsigned i=0; i<numArguments; ++i ) {
+                result += componentHash( function->getArgumentType(i) );
+                result *= FibonacciHashMultiplier;
+            }
+
+            result += componentHash( function->getReturnType() );
+
+            return result;
+        }
+
+        size_t operator()( const Pointer *pointer ) {
+            return componentHash( pointer->getPointedType() ) * (FibonacciHashMultiplier - PointerModifier);
+        }
+
+        size_t operator()( const Array *array ) {
+            return componentHash( array->getElementType() ) * (FibonacciHashMultiplier - ArrayModifier) +
+                   array->getNumElements();
+        }
+    };
+
+    size_t retVal = typeType.index() * FibonacciHashMultiplier + std::visit( Visitor{}, typeType );
+
+    size_t asserter = 0;
+    if( (getFlags() & Flags::Reference) != 0 ) {
+        retVal *= FibonacciHashMultiplier-ReferenceModifier;
+        asserter |= Flags::Reference;
+    }
+    if( (getFlags() & Flags::Mutable) != 0 ) {
+        retVal *= FibonacciHashMultiplier-MutableModifier;
+        asserter |= Flags::Mutable;
+    }
+    ASSERT( getFlags() == asserter )<<"Unhandled type flag. Flags "<<getFlags()<<", handled "<<asserter;
+
+    return retVal;
+}
+
 std::ostream &operator<<(std::ostream &out, StaticType::CPtr type) {
     if( !type ) {
         return out<<"Type(nullptr)";
@@ -160,73 +222,25 @@ int compile(std::string path, const CompilerArguments *arguments, ModuleGen *cod
 
     // Parse + symbols lookup
     ASSERT( AST::AST::prepared() )<<"compile called without calling prepare first";
-    auto tokenizedModule = Tokenizer::Tokenizer::tokenize( sourceFile.getSlice<const char>() );
-    NonTerminals::Module module;
-    module.parse( tokenizedModule );
+    String source = sourceFile.getSlice<const char>();
+    std::unique_ptr<NonTerminals::Module> module = safenew<NonTerminals::Module>();
+    if( arguments!=nullptr && !arguments->parseCacheDir.empty() ) {
+        std::string imagePath = NonTerminals::ModuleCache::imagePath( arguments->parseCacheDir, source );
+        if( !NonTerminals::ModuleCache::load( *module, source, imagePath ) ) {
+            // A failed load may leave the module half built
+            module = safenew<NonTerminals::Module>();
+            module->parseStreaming( source );
+            NonTerminals::ModuleCache::save( *module, source, imagePath );
+        }
+    } else {
+        module->parseStreaming( source );
+    }
 
     // And that other thing
-    ast.codeGen( module, codeGen );
+    ast.codeGen( *module, codeGen );
 
     return 0;
 }
 
 } // PracticalSemanticAnalyzer
 
-using namespace PracticalSemanticAnalyzer;
-
-namespace std {
-
-size_t hash< StaticType >::operator()(const StaticType &type) const {
-    static constexpr size_t PointerModifier = 4;
-    static constexpr size_t ReferenceModifier = 6;
-    static constexpr size_t MutableModifier = 10;
-    static constexpr size_t ArrayModifier = 14;
-
-    auto typeType = type.getType();
-
-    struct Visitor {
-        size_t operator()( const StaticType::Scalar *scalar ) {
-            return hash<String>{}( scalar->getName() );
-        }
-
-        size_t operator()( const StaticType::Function *function ) {
-            size_t result = 0;
-
-            auto numArguments = function->getNumArguments();
-            for( unsigned i=0; i<numArguments; ++i ) {
-                result += hash{}( *function->getArgumentType(i) );
-                result *= FibonacciHashMultiplier;
-            }
-
-            result += hash{}( *function->getReturnType() );
-
-            return result;
-        }
-
-        size_t operator()( const StaticType::Pointer *pointer ) {
-            return hash{}( *pointer->getPointedType() ) * (FibonacciHashMultiplier - PointerModifier);
-        }
-
-        size_t operator()( const StaticType::Array *array ) {
-            return hash{}( *array->getElementType() ) * (FibonacciHashMultiplier - ArrayModifier) +
-                   array->getNumElements();
-        }
-    };
-
-    size_t retVal = typeType.index() * FibonacciHashMultiplier + std::visit( Visitor{}, typeType );
-
-    size_t asserter = 0;
-    if( (type.getFlags() & StaticType::Flags::Reference) != 0 ) {
-        retVal *= FibonacciHashMultiplier-ReferenceModifier;
-        asserter |= StaticType::Flags::Reference;
-    }
-    if( (type.getFlags() & StaticType::Flags::Mutable) != 0 ) {
-        retVal *= FibonacciHashMultiplier-MutableModifier;
-        asserter |= StaticType::Flags::Mutable;
-    }
-    ASSERT( type.getFlags() == asserter )<<"Unhandled type flag. Flags "<<type.getFlags()<<", handled "<<asserter;
-
-    return retVal;
-}
-
-} // namespace std
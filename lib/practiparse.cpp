@@ -6,13 +6,24 @@
  * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
  * home directory.
  */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <map>
+#include <string>
 #include <variant>
+#include <vector>
 
+#include <sys/resource.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "parser/module.h"
+#include "parser/trace.h"
 #include "mmap.h"
+#include "ut/dirscan.h"
 
 size_t indentWidth = 3;
 
@@ -58,8 +69,54 @@ void dumpType( const NonTerminals::Type &type, size_t depth ) {
 void dumpParseTree( const NonTerminals::Expression &node, size_t depth=0 );
 void dumpParseTree( const NonTerminals::Statement &statement, size_t depth=0 );
 
+void dumpVariableDefinition( const NonTerminals::VariableDefinition &definition, size_t depth ) {
+    indent( std::cout, depth ) << "Variable definition:\n";
+    dumpIdentifier( definition.body.name, depth+1 );
+    indent( std::cout, depth+1 ) << "Type:\n";
+    dumpType( definition.body.type, depth+2 );
+    if( definition.initValue ) {
+        indent( std::cout, depth+1 ) << "Initial value:\n";
+        dumpParseTree( *definition.initValue, depth+2 );
+    }
+}
+
 void dumpParseTree( const NonTerminals::Statement &statement, size_t depth ) {
-    ABORT()<<"TODO implement";
+    struct Visitor {
+        size_t depth;
+
+        void operator()( std::monostate ) {
+            indent( std::cout, depth ) << "Empty statement\n";
+        }
+
+        void operator()( const NonTerminals::Expression &expression ) {
+            indent( std::cout, depth ) << "Expression statement:\n";
+            dumpParseTree( expression, depth+1 );
+        }
+
+        void operator()( const NonTerminals::VariableDefinition &definition ) {
+            dumpVariableDefinition( definition, depth );
+        }
+
+        void operator()( const NonTerminals::Statement::ConditionalStatement &condition ) {
+            indent( std::cout, depth ) << "Condition statement:\n";
+            dumpParseTree( condition.condition, depth+1 );
+            indent( std::cout, depth ) << "If clause:\n";
+            dumpParseTree( *condition.ifClause, depth+1 );
+            if( condition.elseClause ) {
+                indent( std::cout, depth ) << "Else clause:\n";
+                dumpParseTree( *condition.elseClause, depth+1 );
+            }
+        }
+
+        void operator()( const NonTerminals::NodePtr<NonTerminals::CompoundStatement> &compound ) {
+            indent( std::cout, depth ) << "Compound statement:\n";
+            for( const auto &statement: compound->statements.statements ) {
+                dumpParseTree( statement, depth+1 );
+            }
+        }
+    };
+
+    std::visit( Visitor{ .depth = depth }, statement.content );
 }
 
 void dumpParseTree( const FunctionArguments &args, size_t depth=0 ) {
@@ -75,7 +132,7 @@ void dumpParseTree( const NonTerminals::Expression &node, size_t depth ) {
 
         Visitor( size_t depth, std::ostream &out ) : depth(depth), out(out) {}
 
-        void operator()( const std::unique_ptr<::NonTerminals::CompoundExpression> &compound ) {
+        void operator()( const NonTerminals::NodePtr<::NonTerminals::CompoundExpression> &compound ) {
             indent(out, depth) << "Compound expression Statements:\n";
             for( const auto &statement: compound->statementList.statements ) {
                 dumpParseTree( statement, depth+1 );
@@ -144,7 +201,7 @@ void dumpParseTree( const NonTerminals::Expression &node, size_t depth ) {
             dumpParseTree( func.arguments, depth+1 );
         }
 
-        void operator()( const std::unique_ptr<NonTerminals::ConditionalExpression> &condition ) {
+        void operator()( const NonTerminals::NodePtr<NonTerminals::ConditionalExpression> &condition ) {
             indent(out, depth) << "Condition expression:\n";
             dumpParseTree( condition->condition, depth+1 );
             indent(out, depth) << "If clause:\n";
@@ -162,8 +219,357 @@ void dumpParseTree( const NonTerminals::Expression &node, size_t depth ) {
     std::visit( Visitor( depth, std::cout ), node.value );
 }
 
+void dumpTransientType( const NonTerminals::TransientType &type, size_t depth ) {
+    if( std::holds_alternative<std::monostate>( type.type.type ) ) {
+        indent( std::cout, depth ) << "None\n";
+        return;
+    }
+
+    if( type.ref!=nullptr ) {
+        indent( std::cout, depth ) << "Reference\n";
+        ++depth;
+    }
+
+    dumpType( type.type, depth );
+}
+
+void dumpFunctionDeclaration( const NonTerminals::FuncDeclBody &decl, size_t depth ) {
+    dumpIdentifier( decl.name, depth );
+    indent( std::cout, depth ) << "Arguments:\n";
+    for( const auto &argument : decl.arguments.arguments ) {
+        dumpIdentifier( argument.name, depth+1 );
+        dumpTransientType( argument.type, depth+2 );
+    }
+    indent( std::cout, depth ) << "Return type:\n";
+    dumpTransientType( decl.returnType.type, depth+1 );
+}
+
 void dumpParseTree( const NonTerminals::Module &module, size_t depth=0 ) {
-    ABORT()<<"TODO implement";
+    for( const auto &structure : module.structureDefinitions ) {
+        indent( std::cout, depth ) << "Struct definition:\n";
+        dumpIdentifier( structure.identifier, depth+1 );
+        for( const auto &member : structure.definitions )
+            dumpVariableDefinition( member, depth+1 );
+    }
+
+    for( const auto &function : module.functionDeclarations ) {
+        indent( std::cout, depth ) << "Function declaration:\n";
+        dumpFunctionDeclaration( function.decl, depth+1 );
+        if( function.abiSpecifier.token!=nullptr )
+            indent( std::cout, depth+1 ) << "ABI "<<function.abiSpecifier.token->text<<"\n";
+    }
+
+    for( const auto &function : module.functionDefinitions ) {
+        indent( std::cout, depth ) << "Function definition:\n";
+        dumpFunctionDeclaration( function.decl, depth+1 );
+        indent( std::cout, depth ) << "Body:\n";
+
+        const auto &body = function.getBody();
+        if( std::holds_alternative<NonTerminals::CompoundExpression>( body ) ) {
+            const auto &compound = std::get<NonTerminals::CompoundExpression>( body );
+            for( const auto &statement: compound.statementList.statements ) {
+                dumpParseTree( statement, depth+1 );
+            }
+
+            indent( std::cout, depth ) << "Body value:\n";
+            dumpParseTree( compound.expression, depth+1 );
+        } else {
+            for( const auto &statement: std::get<NonTerminals::CompoundStatement>( body ).statements.statements ) {
+                dumpParseTree( statement, depth+1 );
+            }
+        }
+    }
+}
+
+// Counts parse tree nodes by their NonTerminal type
+class NodeCounter {
+public:
+    std::map<std::string, size_t> counts;
+
+    void count(const NonTerminals::Module &module) {
+        add( "Module" );
+        count( module.functionDefinitions );
+        count( module.functionDeclarations );
+        count( module.structureDefinitions );
+    }
+
+private:
+    void add(const char *name) {
+        ++counts[name];
+    }
+
+    template<typename T>
+    void count(const NonTerminals::NodePtr<T> &node) {
+        if( node )
+            count( *node );
+    }
+
+    template<typename... Alternatives>
+    void count(const std::variant<Alternatives...> &variant) {
+        std::visit( [this]( const auto &alternative ) { count( alternative ); }, variant );
+    }
+
+    template<typename T>
+    void count(const std::vector<T> &vector) {
+        for( const T &element : vector )
+            count( element );
+    }
+
+    void count(std::monostate) {
+    }
+
+    void count(const NonTerminals::Identifier &) {
+        add( "Identifier" );
+    }
+
+    void count(const NonTerminals::Type::Array &array) {
+        count( array.elementType );
+        count( array.dimension );
+    }
+
+    void count(const NonTerminals::Type::Pointer &pointer) {
+        count( pointer.pointed );
+    }
+
+    void count(const NonTerminals::Type &type) {
+        add( "Type" );
+        count( type.type );
+    }
+
+    void count(const NonTerminals::LiteralInt &) {
+        add( "LiteralInt" );
+    }
+
+    void count(const NonTerminals::LiteralBool &) {
+        add( "LiteralBool" );
+    }
+
+    void count(const NonTerminals::LiteralPointer &) {
+        add( "LiteralPointer" );
+    }
+
+    void count(const NonTerminals::LiteralString &) {
+        add( "LiteralString" );
+    }
+
+    void count(const NonTerminals::Literal &literal) {
+        add( "Literal" );
+        count( literal.literal );
+    }
+
+    void count(const NonTerminals::FunctionArguments &arguments) {
+        add( "FunctionArguments" );
+        count( arguments.arguments );
+    }
+
+    void count(const NonTerminals::Expression::UnaryOperator &op) {
+        count( op.operand );
+    }
+
+    void count(const NonTerminals::Expression::BinaryOperator &op) {
+        count( op.operands[0] );
+        count( op.operands[1] );
+    }
+
+    void count(const NonTerminals::Expression::CastOperator &op) {
+        count( op.destType );
+        count( op.expression );
+    }
+
+    void count(const NonTerminals::Expression::FunctionCall &call) {
+        count( call.expression );
+        count( call.arguments );
+    }
+
+    void count(const NonTerminals::ConditionalExpression &condition) {
+        count( condition.condition );
+        count( condition.ifClause );
+        count( condition.elseClause );
+    }
+
+    void count(const NonTerminals::Expression &expression) {
+        add( "Expression" );
+        count( expression.value );
+    }
+
+    void count(const NonTerminals::Statement::ConditionalStatement &condition) {
+        count( condition.condition );
+        count( condition.ifClause );
+        count( condition.elseClause );
+    }
+
+    void count(const NonTerminals::Statement &statement) {
+        add( "Statement" );
+        count( statement.content );
+    }
+
+    void count(const NonTerminals::StatementList &list) {
+        add( "StatementList" );
+        count( list.statements );
+    }
+
+    void count(const NonTerminals::CompoundExpression &compound) {
+        add( "CompoundExpression" );
+        count( compound.statementList );
+        count( compound.expression );
+    }
+
+    void count(const NonTerminals::CompoundStatement &compound) {
+        add( "CompoundStatement" );
+        count( compound.statements );
+    }
+
+    void count(const NonTerminals::VariableDeclBody &body) {
+        add( "VariableDeclBody" );
+        count( body.name );
+        count( body.type );
+    }
+
+    void count(const NonTerminals::VariableDefinition &definition) {
+        add( "VariableDefinition" );
+        count( definition.body );
+        count( definition.initValue );
+    }
+
+    void count(const NonTerminals::TransientType &type) {
+        add( "TransientType" );
+        count( type.type );
+    }
+
+    void count(const NonTerminals::FuncDeclArg &argument) {
+        add( "FuncDeclArg" );
+        count( argument.name );
+        count( argument.type );
+    }
+
+    void count(const NonTerminals::FuncDeclBody &decl) {
+        add( "FuncDeclBody" );
+        count( decl.name );
+        add( "FuncDeclArgs" );
+        count( decl.arguments.arguments );
+        add( "FuncDeclRet" );
+        count( decl.returnType.type );
+    }
+
+    void count(const NonTerminals::FuncDef &function) {
+        add( "FuncDef" );
+        count( function.decl );
+        count( function.getBody() );
+    }
+
+    void count(const NonTerminals::FuncDecl &function) {
+        add( "FuncDecl" );
+        count( function.decl );
+        if( function.abiSpecifier.token!=nullptr )
+            count( function.abiSpecifier );
+    }
+
+    void count(const NonTerminals::StructDef &structure) {
+        add( "StructDef" );
+        count( structure.identifier );
+        count( structure.definitions );
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchmarkSource {
+    std::string path;
+    std::unique_ptr< Mmap<MapMode::ReadOnly> > file;
+};
+
+// Sample at `fraction` of the way through the sorted samples, nearest rank
+double percentile( std::vector<double> samples, double fraction ) {
+    std::sort( samples.begin(), samples.end() );
+    size_t rank = std::ceil( fraction * samples.size() );
+
+    return samples[ std::max( rank, size_t(1) ) - 1 ];
+}
+
+void printTimings( const char *label, const std::vector<double> &samples, size_t tokens ) {
+    double median = percentile( samples, 0.5 );
+    printf( "  %-9s median %9.3f ms  p99 %9.3f ms %9.2f Mtokens/s\n", label, median * 1e3,
+            percentile( samples, 0.99 ) * 1e3, tokens / median / 1e6 );
+}
+
+int runBenchmark( const char *path, unsigned repetitions ) {
+    std::vector<BenchmarkSource> sources;
+
+    struct stat pathStat;
+    if( stat( path, &pathStat )==0 && S_ISDIR( pathStat.st_mode ) ) {
+        for( const dirent &entry : DirScan( path, ".pr" ) ) {
+            sources.emplace_back( BenchmarkSource{ std::string(path) + "/" + entry.d_name, nullptr } );
+        }
+        std::sort( sources.begin(), sources.end(), []( const BenchmarkSource &a, const BenchmarkSource &b ) {
+                    return a.path < b.path;
+                } );
+    } else {
+        sources.emplace_back( BenchmarkSource{ path, nullptr } );
+    }
+
+    // Untimed pass. Loads the sources, leaves out the ones that fail to parse, and counts what the rest produce
+    size_t numBytes = 0, numTokens = 0, treeBytes = 0;
+    NodeCounter counter;
+    for( auto source = sources.begin(); source!=sources.end(); ) {
+        try {
+            source->file = safenew< Mmap<MapMode::ReadOnly> >( source->path );
+            String text = source->file->getSlice<const char>();
+
+            NonTerminals::Module module;
+            module.parse( text );
+
+            numBytes += text.size();
+            numTokens += module.tokens.size();
+            treeBytes += module.arena.bytesAllocated();
+            counter.count( module );
+
+            ++source;
+        } catch( std::exception &error ) {
+            std::cerr << source->path << ": Parsing failed: " << error.what() << "\n";
+            source = sources.erase( source );
+        }
+    }
+
+    if( sources.empty() ) {
+        std::cerr << "Nothing to benchmark\n";
+        return 1;
+    }
+
+    std::vector<double> tokenizeTimes, parseTimes, totalTimes;
+    for( unsigned i=0; i<repetitions; ++i ) {
+        double tokenizeSeconds = 0, parseSeconds = 0;
+
+        for( const auto &source : sources ) {
+            auto start = Clock::now();
+            NonTerminals::Module module;
+            module.tokens = Tokenizer::Tokenizer::tokenizeSignificant( source.file->getSlice<const char>() );
+            auto tokenized = Clock::now();
+            module.parse( module.tokens );
+            auto parsed = Clock::now();
+
+            tokenizeSeconds += std::chrono::duration<double>( tokenized - start ).count();
+            parseSeconds += std::chrono::duration<double>( parsed - tokenized ).count();
+        }
+
+        tokenizeTimes.push_back( tokenizeSeconds );
+        parseTimes.push_back( parseSeconds );
+        totalTimes.push_back( tokenizeSeconds + parseSeconds );
+    }
+
+    printf( "%zu files, %zu bytes, %zu tokens, %u runs\n", sources.size(), numBytes, numTokens, repetitions );
+    printTimings( "tokenize", tokenizeTimes, numTokens );
+    printTimings( "parse", parseTimes, numTokens );
+    printTimings( "total", totalTimes, numTokens );
+
+    printf( "Parse tree nodes, %zu bytes of arena:\n", treeBytes );
+    for( const auto &count : counter.counts )
+        printf( "  %-20s %10zu\n", count.first.c_str(), count.second );
+
+    rusage usage;
+    getrusage( RUSAGE_SELF, &usage );
+    printf( "Peak RSS: %ld KiB\n", usage.ru_maxrss );
+
+    return 0;
 }
 
 void help() {
@@ -173,15 +579,22 @@ void help() {
             "Options:\n"
             "-c\tArgument is the actual program source, instead of the file name\n"
             "-W\tSource is the whole program, rather than a single expression\n"
-            "-i<num>\tSet the per-level indent mount\n";
+            "-i<num>\tSet the per-level indent mount\n"
+            "-t<num>\tTrace the last <num> parser rules, and print them if parsing fails\n"
+            "-b<num>\tBenchmark: tokenize and parse the whole program <num> times, and report timings instead of the\n"
+            "\tparse tree. If the argument is a directory, all .pr files in it are parsed\n"
+            "-p<num>\tParse the whole program with <num> threads, or one per CPU if 0. Implies -W\n";
 }
 
 int main(int argc, char *argv[]) {
     bool singleExpression = true;
     bool argumentSource = false;
+    unsigned benchmarkRepetitions = 0;
+    bool parallel = false;
+    unsigned parseThreads = 0;
     int opt;
 
-    while( (opt=getopt(argc, argv, "Wchi:?")) != -1 ) {
+    while( (opt=getopt(argc, argv, "Wchi:t:b:p:?")) != -1 ) {
         switch( opt ) {
         case 'W':
             singleExpression = false;
@@ -192,6 +605,17 @@ int main(int argc, char *argv[]) {
         case 'i':
             indentWidth = strtoul( optarg, nullptr, 10 );
             break;
+        case 't':
+            NonTerminals::ParseTrace::enable( strtoul( optarg, nullptr, 10 ), &std::cerr );
+            break;
+        case 'b':
+            benchmarkRepetitions = std::max( strtoul( optarg, nullptr, 10 ), 1ul );
+            break;
+        case 'p':
+            parallel = true;
+            singleExpression = false;
+            parseThreads = strtoul( optarg, nullptr, 10 );
+            break;
         case '?':
             help();
             return 0;
@@ -208,6 +632,9 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    if( benchmarkRepetitions>0 )
+        return runBenchmark( argv[optind], benchmarkRepetitions );
+
     try {
         std::unique_ptr< Mmap<MapMode::ReadOnly> > fileSource;
         String textSource;
@@ -219,18 +646,25 @@ int main(int argc, char *argv[]) {
             textSource = fileSource->getSlice<const char>();
         }
 
-        // Tokenize
-        auto tokens = Tokenizer::Tokenizer::tokenize( textSource );
+        // Tokenize. The parallel parse does its own
+        auto tokens = parallel ?
+                std::vector<Tokenizer::Token>() :
+                Tokenizer::Tokenizer::tokenizeSignificant( textSource );
 
         // Parse
         if( singleExpression ) {
+            Arena arena;
+            NonTerminals::ArenaScope scope(arena);
             NonTerminals::Expression exp;
             exp.parse( tokens );
             std::cout<<"Successfully parsed. Dumping parse tree:\n";
             dumpParseTree( exp );
         } else {
             NonTerminals::Module module;
-            module.parse( tokens );
+            if( parallel )
+                module.parseParallel( textSource, parseThreads );
+            else
+                module.parse( tokens );
             std::cout<<"Successfully parsed. Dumping parse tree:\n";
             dumpParseTree( module );
         }
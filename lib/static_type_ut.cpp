@@ -0,0 +1,110 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "ast/static_type.h"
+#include "ast/signed_int_value_range.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace AST;
+using PracticalSemanticAnalyzer::StaticType;
+
+class StaticTypeTest : public CppUnit::TestFixture  {
+    // A function type with no arguments and no return type, implemented outside of the library
+    class GenericFunction final : public StaticType, public StaticType::Function {
+    public:
+        Types getType() const override {
+            return static_cast<const StaticType::Function *>(this);
+        }
+
+        String getMangledName() const override {
+            return "F";
+        }
+
+        Flags::Type getFlags() const override {
+            return 0;
+        }
+
+        CPtr setFlags( Flags::Type flags ) const override {
+            CPPUNIT_ASSERT( flags==0 );
+            return this;
+        }
+
+        CPtr getReturnType() const override {
+            return nullptr;
+        }
+
+        size_t getNumArguments() const override {
+            return 0;
+        }
+
+        CPtr getArgumentType( unsigned ) const override {
+            CPPUNIT_FAIL("Generic function has no arguments");
+        }
+    };
+
+    static StaticTypeImpl::CPtr s32() {
+        return StaticTypeImpl::allocate(
+                ScalarTypeImpl( "S32", "s4", 32, 4, ScalarTypeImpl::Type::SignedInt, { .n=5 }, 5 ),
+                SignedIntValueRange::allocate<int32_t>() );
+    }
+
+    static void checkSame( const StaticType &lhs, const StaticType &rhs ) {
+        CPPUNIT_ASSERT( lhs==rhs );
+        CPPUNIT_ASSERT_EQUAL( std::hash<StaticType>{}( lhs ), std::hash<StaticType>{}( rhs ) );
+    }
+
+    void equalHashes() {
+        // Scalars are not interned, so these are two objects
+        StaticTypeImpl::CPtr first = s32(), second = s32();
+        CPPUNIT_ASSERT( first.get()!=second.get() );
+        checkSame( *first, *second );
+
+        StaticTypeImpl::CPtr firstPointer = StaticTypeImpl::allocate( PointerTypeImpl( first ) );
+        StaticTypeImpl::CPtr secondPointer = StaticTypeImpl::allocate( PointerTypeImpl( second ) );
+        CPPUNIT_ASSERT( firstPointer.get()!=secondPointer.get() );
+        checkSame( *firstPointer, *secondPointer );
+
+        checkSame(
+                *StaticTypeImpl::allocate( ArrayTypeImpl( firstPointer, 3 ) ),
+                *StaticTypeImpl::allocate( ArrayTypeImpl( secondPointer, 3 ) ) );
+
+        checkSame(
+                *StaticTypeImpl::allocate( FunctionTypeImpl( StaticTypeImpl::CPtr( first ), { firstPointer } ) ),
+                *StaticTypeImpl::allocate( FunctionTypeImpl( StaticTypeImpl::CPtr( second ), { secondPointer } ) ) );
+
+        // Flags added and then removed
+        checkSame( *firstPointer->addFlags( StaticType::Flags::Mutable )->removeFlags( StaticType::Flags::Mutable ),
+                *secondPointer );
+        checkSame( *first->addFlags( StaticType::Flags::Reference ), *second->addFlags( StaticType::Flags::Reference ) );
+    }
+
+    void genericFunction() {
+        StaticTypeImpl::CPtr generic = StaticTypeImpl::allocate( FunctionTypeImpl( nullptr, {} ) );
+        boost::intrusive_ptr<GenericFunction> external( new GenericFunction );
+
+        checkSame( *generic, *external );
+        // Asking again gives the same answer
+        CPPUNIT_ASSERT_EQUAL( generic->getHash(), external->getHash() );
+    }
+
+public:
+    static CppUnit::Test *suite()
+    {
+        CppUnit::TestSuite *suiteOfTests = new CppUnit::TestSuite( "StaticTypeTest" );
+        suiteOfTests->addTest( new CppUnit::TestCaller<StaticTypeTest>(
+                    "equalHashes",
+                    &StaticTypeTest::equalHashes ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<StaticTypeTest>(
+                    "genericFunction",
+                    &StaticTypeTest::genericFunction ) );
+        return suiteOfTests;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( StaticTypeTest );
@@ -9,97 +9,35 @@
 #include <tokenizer.h>
 
 #include "asserts.h"
+#include "tokenizer/numeric.h"
+#include "tokenizer/perfect_hash.h"
+#include "tokenizer/spellings.h"
+#include "tokenizer/trivia.h"
 
 #include <practical/errors.h>
 
-#include <regex>
-#include <string>
-#include <unordered_map>
-#include <unordered_set>
-
 using PracticalSemanticAnalyzer::tokenizer_error;
 
 namespace Tokenizer {
 
-static const std::unordered_set<char> operatorChars = {
-    '~', '!', '#', '/', '$', '%', '^', '&', '*', '-', '=', '+', '<', '>', '.', '|', ':', '@' };
-static const std::unordered_map<String, Tokens> operators {
-    // Precedence 1
-    { "::", Tokens::OP_DOUBLE_COLON },
-    // Precedence 2
-    { "++", Tokens::OP_PLUS_PLUS },
-    { "--", Tokens::OP_MINUS_MINUS },
-    { "(", Tokens::BRACKET_ROUND_OPEN },
-    { ")", Tokens::BRACKET_ROUND_CLOSE },
-    { "[", Tokens::BRACKET_SQUARE_OPEN },
-    { "]", Tokens::BRACKET_SQUARE_CLOSE },
-    { ".", Tokens::OP_DOT },
-    { "->", Tokens::OP_ARROW },
-    { "@", Tokens::OP_PTR },
-    // Precedence 3
-    { "+", Tokens::OP_PLUS },
-    { "-", Tokens::OP_MINUS },
-    { "~", Tokens::OP_BIT_NOT },
-    { "!", Tokens::OP_LOGIC_NOT },
-    { "*", Tokens::OP_MULTIPLY },
-    { "&", Tokens::OP_AMPERSAND },
-    // Precedence 5
-    { "/", Tokens::OP_DIVIDE },
-    { "%", Tokens::OP_MODULOUS },
-    // Precedence 6
-    { "|", Tokens::OP_BIT_OR },
-    { "^", Tokens::OP_BIT_XOR },
-    // Precedence 8
-    { "<<", Tokens::OP_SHIFT_LEFT },
-    { ">>", Tokens::OP_SHIFT_RIGHT },
-    // Precedence 9
-    { "<", Tokens::OP_LESS_THAN },
-    { "<=", Tokens::OP_LESS_THAN_EQ },
-    { ">", Tokens::OP_GREATER_THAN },
-    { ">=", Tokens::OP_GREATER_THAN_EQ },
-    // Precedence 10
-    { "==", Tokens::OP_EQUALS },
-    { "!=", Tokens::OP_NOT_EQUALS },
-    // Precedence 11
-    { "&&", Tokens::OP_LOGIC_AND },
-    // Precedence 12
-    { "||", Tokens::OP_LOGIC_OR },
-    // Precedence 13
-    { "=", Tokens::OP_ASSIGN },
-    { "+=", Tokens::OP_ASSIGN_PLUS },
-    { "-=", Tokens::OP_ASSIGN_MINUS },
-    { "*=", Tokens::OP_ASSIGN_MULTIPLY },
-    { "/=", Tokens::OP_ASSIGN_DIVIDE },
-    { "%=", Tokens::OP_ASSIGN_MODULOUS },
-    { "<<=", Tokens::OP_ASSIGN_LEFT_SHIFT },
-    { ">>=", Tokens::OP_ASSIGN_RIGHT_SHIFT },
-    { "&=", Tokens::OP_ASSIGN_BIT_AND },
-    { "^=", Tokens::OP_ASSIGN_BIT_XOR },
-    { "|=", Tokens::OP_ASSIGN_BIT_OR },
-
-    // Miscellany
-    { "+++", Tokens::OP_RUNON_ERROR },
-    { "---", Tokens::OP_RUNON_ERROR },
-    { "&=", Tokens::OP_ASSIGN_BIT_AND },
-    { ":", Tokens::OP_COLON },
-    { "//", Tokens::COMMENT_LINE_END },
-    { "/*", Tokens::COMMENT_MULTILINE },
-};
-static const std::unordered_map<std::string, Tokens> reservedWords {
-    { "def", Tokens::RESERVED_DEF },
-    { "decl", Tokens::RESERVED_DECL },
-    { "expect", Tokens::RESERVED_EXPECT },
-    { "true", Tokens::RESERVED_TRUE },
-    { "false", Tokens::RESERVED_FALSE },
-    { "if", Tokens::RESERVED_IF },
-    { "else", Tokens::RESERVED_ELSE },
-    { "ref", Tokens::RESERVED_REF },
-    { "null", Tokens::RESERVED_NULL },
-    { "struct", Tokens::RESERVED_STRUCT },
-};
-
-
-bool Tokenizer::next() {
+static constexpr std::array<bool, 256> buildOperatorChars() {
+    std::array<bool, 256> ret{};
+
+    for( const char *c = OperatorChars; *c!='\0'; ++c )
+        ret[ static_cast<unsigned char>(*c) ] = true;
+
+    return ret;
+}
+
+static constexpr std::array<bool, 256> operatorChars = buildOperatorChars();
+static constexpr PerfectHash<OperatorSpellings.size(), 256> operators( OperatorSpellings );
+static constexpr PerfectHash<ReservedWordSpellings.size(), 32> reservedWords( ReservedWordSpellings );
+
+static bool isOperatorChar(char c) {
+    return operatorChars[ static_cast<unsigned char>(c) ];
+}
+
+bool Tokenizer::nextLegacy() {
     if( file.size()==position ) {
         // We've reached our EOF
         tokenLocation = location;
@@ -107,6 +45,7 @@ bool Tokenizer::next() {
     }
 
     token = Tokens::ERR;
+    tokenValue = LiteralValue();
 
     SourceLocation startLocation = location;
     size_t tokenStart = position;
@@ -137,7 +76,7 @@ bool Tokenizer::next() {
     } else if(currentChar=='}') {
         nextChar();
         token = Tokens::BRACKET_CURLY_CLOSE;
-    } else if(operatorChars.find(currentChar) != operatorChars.end()) {
+    } else if(isOperatorChar(currentChar)) {
         consumeOp();
     } else if(currentChar=='"') {
         consumeStringLiteral();
@@ -145,6 +84,8 @@ bool Tokenizer::next() {
         consumeNumericLiteral();
     } else if(isIdentifierAlpha(currentChar)) {
         consumeIdentifier();
+    } else if(!isAscii(currentChar) && consumeUnicodeIdentifier(true)) {
+        token = identifierToken( file.subslice(tokenStart, position) );
     } else {
         tokenText = file.subslice(tokenStart, tokenStart+1);
         throw tokenizer_error("Invalid character encountered", startLocation);
@@ -156,10 +97,10 @@ bool Tokenizer::next() {
     return true;
 }
 
-std::vector<Token> Tokenizer::tokenize(String source) {
+std::vector<Token> Tokenizer::tokenize(String source, Engine engine) {
     std::vector<Token> tokens;
 
-    Tokenizer tokenizer(source);
+    Tokenizer tokenizer(source, engine);
 
     while( tokenizer.next() ) {
         tokens.push_back(tokenizer.current());
@@ -168,10 +109,34 @@ std::vector<Token> Tokenizer::tokenize(String source) {
     return tokens;
 }
 
+std::vector<Token> Tokenizer::tokenizeSignificant(String source, TriviaTable *trivia, Engine engine) {
+    std::vector<Token> tokens;
+    if( trivia!=nullptr )
+        trivia->clear();
+
+    Tokenizer tokenizer(source, engine);
+
+    while( tokenizer.next() ) {
+        if( isTrivia( tokenizer.currentToken() ) ) {
+            if( trivia!=nullptr )
+                trivia->add( tokenizer.current() );
+        } else {
+            if( trivia!=nullptr )
+                trivia->significant();
+
+            tokens.push_back( tokenizer.current() );
+        }
+    }
+
+    if( trivia!=nullptr )
+        trivia->finish();
+
+    return tokens;
+}
+
 void Tokenizer::consumeWS() {
     token = Tokens::WS;
-    while( nextChar() && isWS(file[position]) )
-        ;
+    skip( Trivia::activeKernels().skipWhiteSpace( file.get() + position, file.get() + file.size() ) );
 }
 
 void Tokenizer::consumeOp() {
@@ -190,13 +155,13 @@ void Tokenizer::consumeOp() {
 
         auto op = file.subslice(startPosition, position+1);
 
-        auto opIter = operators.find(op);
-        if( opIter != operators.end() ) {
-            token = opIter->second;
+        Tokens opToken = operators.lookup(op, Tokens::ERR);
+        if( opToken != Tokens::ERR ) {
+            token = opToken;
             found = true;
             foundLastRound = true;
         }
-    } while( nextChar() && operatorChars.find(file[position])!=operatorChars.end() );
+    } while( nextChar() && isOperatorChar(file[position]) );
 
     if( foundLastRound ) {
         lastIdentified = savePosition();
@@ -242,7 +207,7 @@ void Tokenizer::consumeStringLiteral() {
         }
     }
 
-    if( file[position]=='"' ) {
+    if( moreData && file[position]=='"' ) {
         // Consume the terminating quote itself
         nextChar();
         token = Tokens::LITERAL_STRING;
@@ -252,73 +217,95 @@ void Tokenizer::consumeStringLiteral() {
 
 void Tokenizer::consumeNumericLiteral() {
     SourceLocation startLocation = location;
-    size_t startPos = position;
-    // Consume all relevant characters, whether legal in an integer literal or not. Sort everything else later.
-    while( nextChar() && (isDigit(file[position]) || isIdentifierAlpha(file[position])) ) {
-    }
+    NumericLiteral literal = scanNumericLiteral( file.subslice(position) );
 
-    static std::regex re10("^([0-9][0-9_]*)");
-    static std::regex reFp("^(\\.[0-9]+)|(([0-9]+)(\\.([0-9]*))?)([eE][-+]?[0-9_]+)?");
-    static std::regex re16("^0[xX]([0-9a-fA-F_]+)");
-    static std::regex re2("^0[bB]([01_]+)");
-    static std::regex re8("^0[o]([01_]+)");
-
-    const char *start = &file[startPos];
-    // The strange math is to avoid violating bounds checks in case this is the last thing in the file
-    const char *end = file.get() + position;
-    if( std::regex_match( start, end, re10 ) ) {
-        token = Tokens::LITERAL_INT_10;
-    } else if( std::regex_match( start, end, reFp ) ) {
-        token = Tokens::LITERAL_FP;
-    } else if( std::regex_match( start, end, re16 ) ) {
-        token = Tokens::LITERAL_INT_16;
-    } else if( std::regex_match( start, end, re2 ) ) {
-        token = Tokens::LITERAL_INT_2;
-    } else if( std::regex_match( start, end, re8 ) ) {
-        token = Tokens::LITERAL_INT_8;
-    } else {
-        throw tokenizer_error("Invalid numeric literal", startLocation);
-    }
+    // Numeric literals never span lines
+    position += literal.length;
+    location.col += literal.length;
+
+    if( literal.error!=nullptr )
+        throw tokenizer_error(literal.error, startLocation);
+
+    token = literal.token;
+    tokenValue = std::move(literal.value);
 }
 
 void Tokenizer::consumeIdentifier() {
-    std::string id;
-
-    id += file[position];
+    size_t startPos = position;
     while( nextChar() && (isIdentifierAlpha(file[position]) || isDigit(file[position])) ) {
-        id += file[position];
     }
 
-    auto tokenIter = reservedWords.find( id );
-    if( tokenIter != reservedWords.end() ) {
-        token = tokenIter->second;
-    } else {
-        token = Tokens::IDENTIFIER;
-    }
+    if( position<file.size() && !isAscii(file[position]) )
+        consumeUnicodeIdentifier(false);
+
+    token = identifierToken( file.subslice(startPos, position) );
+}
+
+bool Tokenizer::consumeUnicodeIdentifier(bool start) {
+    size_t length = Utf8::identifierLength( file.get() + position, file.get() + file.size(), start );
+
+    // Identifiers never span lines
+    position += length;
+    location.col += length;
+
+    return length>0;
 }
 
 void Tokenizer::consumeLineComment() {
-    while( nextChar() && file[position]!='\n' )
-        ;
+    skip( Trivia::activeKernels().findNewLine( file.get() + position, file.get() + file.size() ) );
 }
 
 void Tokenizer::consumeNestableComment(SavedPoint startPoint) {
-    while( nextChar() ) {
+    const Trivia::Kernels &kernels = Trivia::activeKernels();
+
+    while( true ) {
+        skip( kernels.findCommentSpecial( file.get() + position, file.get() + file.size() ) );
+        if( position>=file.size() )
+            break;
+
         SavedPoint recursiveStartPoint = savePosition();
 
-        // Nested comment
-        if( file[position]=='/' && nextChar() && file[position]=='*' ) {
+        if( file[position]=='/' && position+1<file.size() && file[position+1]=='*' ) {
+            // Nested comment
+            nextChar();
+            nextChar();
             consumeNestableComment(recursiveStartPoint);
-        } else if( file[position]=='*' && nextChar() && file[position]=='/' ) {
+        } else if( file[position]=='*' && position+1<file.size() && file[position+1]=='/' ) {
             // Comment end
             nextChar();
+            nextChar();
             return;
+        } else {
+            nextChar();
         }
     }
 
     throw tokenizer_error("Unterminated multi-line comment", startPoint.location);
 }
 
+void Tokenizer::invalidEncoding() {
+    // The bad sequence is somewhere inside the current token
+    SourceLocation errorLocation = tokenLocation;
+    for( const char *c = tokenText.get(); c < file.get() + encoding.firstInvalid; ++c ) {
+        if( *c=='\n' ) {
+            errorLocation.line++;
+            errorLocation.col = 1;
+        } else {
+            errorLocation.col++;
+        }
+    }
+
+    // Report each bad sequence once, should the caller carry on past the error
+    Utf8::Validation rest = Utf8::validate( file.get() + position, file.get() + file.size() );
+    encoding.firstInvalid = position + rest.firstInvalid;
+
+    throw tokenizer_error("Invalid UTF-8 sequence", errorLocation);
+}
+
+Tokens Tokenizer::identifierToken(String text) {
+    return reservedWords.lookup( text, Tokens::IDENTIFIER );
+}
+
 bool Tokenizer::nextChar() {
     // Allow continued calling after EOF already reached
     if( position>=file.size() )
@@ -334,6 +321,19 @@ bool Tokenizer::nextChar() {
     return position<file.size();
 }
 
+void Tokenizer::skip(const Trivia::Scan &scan) {
+    size_t newPosition = scan.stop - file.get();
+
+    if( scan.lastNewLine!=nullptr ) {
+        location.line += scan.newLines;
+        location.col = scan.stop - scan.lastNewLine;
+    } else {
+        location.col += newPosition - position;
+    }
+
+    position = newPosition;
+}
+
 Tokenizer::SavedPoint Tokenizer::savePosition() {
     return SavedPoint{ .location=location, .position=position };
 }
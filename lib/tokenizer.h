@@ -9,6 +9,11 @@
 #ifndef TOKENIZER_H
 #define TOKENIZER_H
 
+#include "asserts.h"
+#include "exact_int.h"
+#include "tokenizer/symbols.h"
+#include "tokenizer/utf8.h"
+
 #include <practical/defines.h>
 #include <practical/practical.h>
 #include <practical/slice.h>
@@ -16,11 +21,18 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <utility>
+#include <variant>
+#include <vector>
 
 using PracticalSemanticAnalyzer::SourceLocation;
 
 namespace Tokenizer {
 
+namespace Trivia {
+    struct Scan;
+}
+
 enum class Tokens {
     ERR, // Error in parsing
     WS, // White space
@@ -101,20 +113,84 @@ enum class Tokens {
     RESERVED_STRUCT,
 };
 
+// Decoded value of numeric literals. Empty for all other tokens
+using LiteralValue = std::variant<std::monostate, ExactInt, double>;
+
 struct Token {
     String text;
     Tokens token = Tokens::ERR;
+    // Interned spelling of identifiers
+    SymbolId symbol = NoSymbol;
     SourceLocation location;
+    LiteralValue value;
+};
+
+// White space and comments taken out of a token stream, filed under the index of the significant token following them
+class TriviaTable {
+    std::vector<Token> trivia;
+    // For each significant token, where in trivia its preceding run starts. Two more entries for the trailing run
+    std::vector<size_t> runStarts;
+    size_t runStart = 0;
+
+public:
+    // Trivia immediately before significant token `index`. Pass the number of significant tokens for trailing trivia
+    Slice<const Token> before(size_t index) const {
+        ASSERT( index+1 < runStarts.size() );
+        return Slice<const Token>( trivia.data() + runStarts[index], runStarts[index+1] - runStarts[index] );
+    }
+
+    size_t size() const {
+        return trivia.size();
+    }
+
+private:
+    friend class Tokenizer;
+
+    void clear() {
+        trivia.clear();
+        runStarts.clear();
+        runStart = 0;
+    }
+
+    void add(const Token &token) {
+        trivia.push_back(token);
+    }
+
+    void significant() {
+        runStarts.push_back(runStart);
+        runStart = trivia.size();
+    }
+
+    void finish() {
+        significant();
+        runStarts.push_back(runStart);
+    }
+};
+
+// A change to a buffer: bytes [begin, end) of the old buffer were replaced with `replacement`
+struct Edit {
+    size_t begin, end;
+    String replacement;
+};
+
+// Which implementation does the actual scanning. Both produce identical token streams.
+enum class Engine {
+    Legacy,     // Character by character, hand written consumers
+    Table,      // Table driven DFA (tokenizer/dfa.h)
 };
 
 class Tokenizer {
 private:
     Slice<const char> file;
+    Engine engine;
     SourceLocation location;
     size_t position=0;
     SourceLocation tokenLocation;
     Tokens token;
     Slice<const char> tokenText;
+    LiteralValue tokenValue;
+    SymbolId tokenSymbol = NoSymbol;
+    Utf8::Validation encoding;
 
     struct SavedPoint {
         SourceLocation location;
@@ -122,10 +198,21 @@ private:
     };
 
 public:
-    Tokenizer(String file) : file(file), location{ .line=1, .col=1 } {
+    Tokenizer(String file, Engine engine = Engine::Table) :
+        Tokenizer( file, engine, Utf8::validate( file.get(), file.get() + file.size() ) )
+    {
     }
 
-    bool next();
+    bool next() {
+        bool ret = engine==Engine::Table ? nextTable() : nextLegacy();
+        // Well formed sequences were lexed like any other character. Only complain once a token covered a bad one
+        if( !encoding.ascii && ret && position>encoding.firstInvalid )
+            invalidEncoding();
+
+        tokenSymbol = ret && token==Tokens::IDENTIFIER ? Symbols::intern(tokenText) : NoSymbol;
+
+        return ret;
+    }
 
     Token current() const {
         Token ret;
@@ -133,6 +220,8 @@ public:
         ret.text = currentTokenText();
         ret.location = currentLocation();
         ret.token = currentToken();
+        ret.value = currentValue();
+        ret.symbol = currentSymbol();
 
         return ret;
     }
@@ -149,10 +238,55 @@ public:
         return tokenText;
     }
 
-    static std::vector<Token> tokenize(String source);
+    const LiteralValue &currentValue() const {
+        return tokenValue;
+    }
+
+    SymbolId currentSymbol() const {
+        return tokenSymbol;
+    }
+
+    // Whether the whole source is ASCII
+    bool isAscii() const {
+        return encoding.ascii;
+    }
+
+    static std::vector<Token> tokenize(String source, Engine engine = Engine::Table);
+    // Only the tokens the parser cares about. Trivia is dropped, or moved into `trivia` if not null
+    static std::vector<Token> tokenizeSignificant(
+            String source, TriviaTable *trivia = nullptr, Engine engine = Engine::Table);
+
+    // Update `tokens`, the complete output of tokenize, to match `source`: the buffer it was lexed from with `edit`
+    // applied. Only the region around the edit is lexed again. Returns the range of token indexes that were replaced.
+    static std::pair<size_t, size_t> relex(
+            std::vector<Token> &tokens, const Edit &edit, String source, Engine engine = Engine::Table);
+
+    static bool isTrivia(Tokens token) {
+        return token==Tokens::WS || token==Tokens::COMMENT_LINE_END || token==Tokens::COMMENT_MULTILINE;
+    }
+
+    // Sources smaller than this per thread are not worth splitting
+    static constexpr size_t DefaultMinParallelChunk = 256*1024;
+
+    // Same result as tokenize, but lexes chunks of the source concurrently. threads==0 means one per CPU
+    static std::vector<Token> tokenizeParallel(
+            String source, unsigned threads, size_t minChunkSize = DefaultMinParallelChunk, Engine engine = Engine::Table);
 
 private:
-    // XXX all of the is* functions here are ASCII
+    // For lexing parts of a buffer whose encoding is already known
+    Tokenizer(String file, Engine engine, const Utf8::Validation &encoding) :
+        file(file), engine(engine), location{ .line=1, .col=1 }, encoding(encoding)
+    {
+    }
+
+    bool nextLegacy();
+    bool nextTable();
+    [[noreturn]] void invalidEncoding();
+
+    // Classification of complete tokens, shared by both engines
+    static Tokens identifierToken(String text);
+
+    // The is* functions are ASCII only. Bytes above 0x7f are left to Utf8
     static bool isWS(char chr) {
         return chr==' ' || chr=='\n' || chr=='\r' || chr=='\t';
     }
@@ -166,16 +300,24 @@ private:
         return (chr>='A' && chr<='Z') || (chr>='a' && chr<='z') || chr=='_';
     }
 
+    static bool isAscii(char chr) {
+        return (chr & 0x80)==0;
+    }
+
     void consumeWS();
     void consumeOp();
     void consumeStringLiteral();
     void consumeNumericLiteral();
     void consumeIdentifier();
+    // Move past the non-ASCII identifier characters at the current position. Returns whether there were any
+    bool consumeUnicodeIdentifier(bool start);
 
     void consumeLineComment();
     void consumeNestableComment(SavedPoint startPoint);
 
     bool nextChar();
+    // Move past a run of characters found by one of the trivia scanners
+    void skip(const Trivia::Scan &scan);
     SavedPoint savePosition();
     void restorePosition(SavedPoint position);
 };
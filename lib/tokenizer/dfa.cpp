@@ -0,0 +1,181 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer/dfa.h"
+
+#include "asserts.h"
+#include "tokenizer/numeric.h"
+#include "tokenizer/trivia.h"
+#include "tokenizer/utf8.h"
+
+#include <practical/errors.h>
+
+#include <vector>
+
+using PracticalSemanticAnalyzer::tokenizer_error;
+
+namespace Tokenizer {
+
+bool Tokenizer::nextTable() {
+    using namespace Dfa;
+
+    if( file.size()==position ) {
+        // We've reached our EOF
+        tokenLocation = location;
+        return false;
+    }
+
+    const char *text = file.get();
+    const size_t end = file.size();
+    const size_t tokenStart = position;
+    const SourceLocation startLocation = location;
+
+    size_t pos = position;
+    unsigned line = location.line;
+    size_t lineStart = position - (location.col - 1);
+    State state = States::Start;
+    // Set when the token ends without waiting for a stop transition
+    bool finished = false;
+    NumericLiteral literal;
+    // Start locations of the currently open multi-line comments
+    std::vector<SourceLocation> commentStarts;
+
+    const Trivia::Kernels &kernels = Trivia::activeKernels();
+    auto skip = [&]( const Trivia::Scan &scan ) {
+        if( scan.lastNewLine!=nullptr ) {
+            line += scan.newLines;
+            lineStart = scan.lastNewLine - text + 1;
+        }
+
+        pos = scan.stop - text;
+    };
+
+    auto syncLocation = [&]() {
+        position = pos;
+        location.line = line;
+        location.col = pos - lineStart + 1;
+    };
+
+    while( pos<end ) {
+        State next = tables.transitions[state][ tables.charClass[ static_cast<unsigned char>(text[pos]) ] ];
+        if( next==States::Stop )
+            break;
+
+        // Set if the action already moved pos past the character
+        bool consumed = false;
+
+        switch( tables.action[next] ) {
+        case Action::None:
+            break;
+        case Action::WhiteSpace:
+            skip( kernels.skipWhiteSpace( text + pos, text + end ) );
+            consumed = finished = true;
+            break;
+        case Action::LineComment:
+            skip( kernels.findNewLine( text + pos + 1, text + end ) );
+            consumed = finished = true;
+            break;
+        case Action::CommentBody:
+            skip( kernels.findCommentSpecial( text + pos, text + end ) );
+            consumed = true;
+            break;
+        case Action::Number:
+            literal = scanNumericLiteral( file.subslice(pos) );
+            pos += literal.length;
+            consumed = finished = true;
+            break;
+        case Action::OpenComment:
+            commentStarts.push_back( startLocation );
+            break;
+        case Action::NestComment:
+            // The nested comment started on the previous character
+            commentStarts.push_back( SourceLocation{ .line=line, .col=static_cast<unsigned>(pos - lineStart) } );
+            break;
+        case Action::CloseComment:
+            commentStarts.pop_back();
+            finished = commentStarts.empty();
+            break;
+        case Action::InvalidChar:
+            tokenText = file.subslice(tokenStart, tokenStart+1);
+            throw tokenizer_error("Invalid character encountered", startLocation);
+        case Action::NakedNewLine:
+            syncLocation();
+            throw tokenizer_error("Naked new line in string literal", location);
+        case Action::UnicodeIdentifier: {
+            size_t length = Utf8::identifierLength( text + pos, text + end, state==States::Start );
+            if( length==0 && state==States::Start ) {
+                tokenText = file.subslice(tokenStart, tokenStart+1);
+                throw tokenizer_error("Invalid character encountered", startLocation);
+            }
+
+            // Takes the rest of the identifier, ASCII included
+            pos += length;
+            next = States::Identifier;
+            consumed = finished = true;
+            break;
+        }
+        }
+
+        if( !consumed ) {
+            if( text[pos]=='\n' ) {
+                line++;
+                lineStart = pos+1;
+            }
+
+            pos++;
+        }
+
+        state = next;
+
+        if( finished )
+            break;
+    }
+
+    syncLocation();
+
+    switch( tables.failure[state] ) {
+    case Failure::None:
+        break;
+    case Failure::WeirdOperator:
+        throw tokenizer_error("Practical does not support inventing weird operators", startLocation);
+    case Failure::UnterminatedString:
+        throw tokenizer_error("Unterminated string", location);
+    case Failure::UnterminatedComment:
+        if( !finished )
+            throw tokenizer_error("Unterminated multi-line comment", commentStarts.back());
+        break;
+    }
+
+    tokenText = file.subslice(tokenStart, position);
+    tokenLocation = startLocation;
+    tokenValue = LiteralValue();
+
+    if( state==States::Number ) {
+        if( literal.error!=nullptr )
+            throw tokenizer_error(literal.error, startLocation);
+
+        token = literal.token;
+        tokenValue = std::move(literal.value);
+    } else if( state==States::Identifier ) {
+        token = identifierToken( tokenText );
+    } else {
+        token = tables.accept[state];
+    }
+
+    if( token==Tokens::OP_RUNON_ERROR ) {
+        throw tokenizer_error(
+                "The compiler refuses to guess which combination of operators you meant. Disambiguate the code with spaces",
+                startLocation);
+    }
+
+    ASSERT( token!=Tokens::ERR );
+
+    return true;
+}
+
+} // namespace Tokenizer
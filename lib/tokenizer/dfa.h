@@ -0,0 +1,249 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2018-2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_DFA_H
+#define TOKENIZER_DFA_H
+
+#include "tokenizer/spellings.h"
+
+#include <array>
+#include <cstdint>
+
+// Tables for the table driven tokenizer engine.
+//
+// Each input byte is mapped to a character class, and the current state and the class select the next state. A token
+// ends when the transition leads to States::Stop, or on EOF. Everything, including the operator trie, is generated at
+// compile time from the spelling lists.
+namespace Tokenizer::Dfa {
+
+using CharClass = uint8_t;
+using State = uint8_t;
+
+namespace Classes {
+    static constexpr CharClass
+            Invalid = 0,
+            WhiteSpace = 1,
+            NewLine = 2,
+            Digit = 3,
+            Alpha = 4,
+            Quote = 5,
+            Backslash = 6,
+            // Any byte with the high bit set. Never seen in ASCII sources
+            NonAscii = 7,
+            FirstPunctuation = 8,
+            FirstOperator = FirstPunctuation + PunctuationSpellings.size(),
+            NumClasses = FirstOperator + sizeof(OperatorChars) - 1;
+}
+
+namespace States {
+    static constexpr State
+            Stop = 0,
+            Start = 1,
+            WhiteSpace = 2,
+            Identifier = 3,
+            Number = 4,
+            BadOperator = 5,
+            String = 6,
+            StringEscape = 7,
+            StringDone = 8,
+            BlockComment = 9,
+            BlockCommentStar = 10,
+            BlockCommentSlash = 11,
+            BlockCommentOpen = 12,
+            BlockCommentClose = 13,
+            InvalidChar = 14,
+            NakedNewLine = 15,
+            UnicodeIdentifier = 16,
+            FirstPunctuation = 17,
+            FirstOperator = FirstPunctuation + PunctuationSpellings.size();
+}
+
+// Things the driver needs to do when entering a state, beyond consuming the character
+enum class Action : uint8_t {
+    None,
+    // Hand the rest of the token over to a dedicated scanner
+    WhiteSpace, LineComment, CommentBody, Number,
+    OpenComment, NestComment, CloseComment, InvalidChar, NakedNewLine,
+    // Identifier characters beyond ASCII, looked up in the XID tables
+    UnicodeIdentifier
+};
+
+// What went wrong if the token ends while in a given state
+enum class Failure : uint8_t { None, WeirdOperator, UnterminatedString, UnterminatedComment };
+
+// Upper bound on the number of trie states the operators need
+constexpr size_t operatorStatesBound() {
+    size_t ret = 0;
+    for( const Spelling &spelling : OperatorSpellings ) {
+        for( const char *c = spelling.text; *c!='\0'; ++c )
+            ++ret;
+    }
+
+    return ret;
+}
+
+static constexpr size_t NumStates = States::FirstOperator + operatorStatesBound();
+static_assert( NumStates<256, "State must fit in a byte" );
+
+struct Tables {
+    std::array<CharClass, 256> charClass{};
+    std::array< std::array<State, Classes::NumClasses>, NumStates > transitions{};
+    std::array<Tokens, NumStates> accept{};
+    std::array<Failure, NumStates> failure{};
+    std::array<Action, NumStates> action{};
+    State lineComment = States::Stop, blockComment = States::Stop;
+};
+
+constexpr CharClass operatorClass( char c ) {
+    for( size_t i=0; OperatorChars[i]!='\0'; ++i ) {
+        if( OperatorChars[i]==c )
+            return Classes::FirstOperator + i;
+    }
+
+    return Classes::Invalid;
+}
+
+constexpr void setBlockCommentBody( Tables &tables, State state ) {
+    for( CharClass cls=0; cls<Classes::NumClasses; ++cls )
+        tables.transitions[state][cls] = States::BlockComment;
+
+    tables.transitions[state][ operatorClass('*') ] = States::BlockCommentStar;
+    tables.transitions[state][ operatorClass('/') ] = States::BlockCommentSlash;
+    tables.failure[state] = Failure::UnterminatedComment;
+}
+
+constexpr Tables buildTables() {
+    Tables tables;
+
+    // Character classes
+    for( auto &cls : tables.charClass )
+        cls = Classes::Invalid;
+    tables.charClass[' '] = tables.charClass['\t'] = tables.charClass['\r'] = Classes::WhiteSpace;
+    tables.charClass['\n'] = Classes::NewLine;
+    for( char c='0'; c<='9'; ++c )
+        tables.charClass[ static_cast<unsigned char>(c) ] = Classes::Digit;
+    for( char c='a'; c<='z'; ++c )
+        tables.charClass[ static_cast<unsigned char>(c) ] = Classes::Alpha;
+    for( char c='A'; c<='Z'; ++c )
+        tables.charClass[ static_cast<unsigned char>(c) ] = Classes::Alpha;
+    tables.charClass['_'] = Classes::Alpha;
+    for( unsigned c=0x80; c<256; ++c )
+        tables.charClass[c] = Classes::NonAscii;
+    tables.charClass['"'] = Classes::Quote;
+    tables.charClass['\\'] = Classes::Backslash;
+    for( size_t i=0; i<PunctuationSpellings.size(); ++i )
+        tables.charClass[ static_cast<unsigned char>(PunctuationSpellings[i].text[0]) ] = Classes::FirstPunctuation + i;
+    for( size_t i=0; OperatorChars[i]!='\0'; ++i )
+        tables.charClass[ static_cast<unsigned char>(OperatorChars[i]) ] = Classes::FirstOperator + i;
+
+    for( auto &token : tables.accept )
+        token = Tokens::ERR;
+
+    auto &start = tables.transitions[States::Start];
+    for( auto &next : start )
+        next = States::InvalidChar;
+    tables.action[States::InvalidChar] = Action::InvalidChar;
+
+    // White space
+    start[Classes::WhiteSpace] = start[Classes::NewLine] = States::WhiteSpace;
+    tables.transitions[States::WhiteSpace][Classes::WhiteSpace] = States::WhiteSpace;
+    tables.transitions[States::WhiteSpace][Classes::NewLine] = States::WhiteSpace;
+    tables.accept[States::WhiteSpace] = Tokens::WS;
+    tables.action[States::WhiteSpace] = Action::WhiteSpace;
+
+    // Identifiers. Reserved words are sorted out once the token is complete
+    start[Classes::Alpha] = States::Identifier;
+    tables.transitions[States::Identifier][Classes::Alpha] = States::Identifier;
+    tables.transitions[States::Identifier][Classes::Digit] = States::Identifier;
+    tables.accept[States::Identifier] = Tokens::IDENTIFIER;
+    start[Classes::NonAscii] = States::UnicodeIdentifier;
+    tables.transitions[States::Identifier][Classes::NonAscii] = States::UnicodeIdentifier;
+    tables.action[States::UnicodeIdentifier] = Action::UnicodeIdentifier;
+
+    // Numbers are handed over to the numeric literal scanner, which also decodes them
+    start[Classes::Digit] = States::Number;
+    tables.action[States::Number] = Action::Number;
+
+    // Strings
+    start[Classes::Quote] = States::String;
+    for( CharClass cls=0; cls<Classes::NumClasses; ++cls ) {
+        tables.transitions[States::String][cls] = States::String;
+        tables.transitions[States::StringEscape][cls] = States::String;
+    }
+    tables.transitions[States::String][Classes::Backslash] = States::StringEscape;
+    tables.transitions[States::String][Classes::NewLine] = States::NakedNewLine;
+    tables.action[States::NakedNewLine] = Action::NakedNewLine;
+    tables.transitions[States::String][Classes::Quote] = States::StringDone;
+    tables.failure[States::String] = tables.failure[States::StringEscape] = Failure::UnterminatedString;
+    tables.accept[States::StringDone] = Tokens::LITERAL_STRING;
+
+    // Punctuation
+    for( size_t i=0; i<PunctuationSpellings.size(); ++i ) {
+        start[Classes::FirstPunctuation + i] = States::FirstPunctuation + i;
+        tables.accept[States::FirstPunctuation + i] = PunctuationSpellings[i].token;
+    }
+
+    // Operators. Any run of operator characters that does not start a known operator is an error
+    for( size_t i=0; OperatorChars[i]!='\0'; ++i ) {
+        start[Classes::FirstOperator + i] = States::BadOperator;
+        tables.transitions[States::BadOperator][Classes::FirstOperator + i] = States::BadOperator;
+    }
+    tables.failure[States::BadOperator] = Failure::WeirdOperator;
+
+    State nextFreeState = States::FirstOperator;
+    for( const Spelling &spelling : OperatorSpellings ) {
+        State state = States::Start;
+        for( const char *c = spelling.text; *c!='\0'; ++c ) {
+            State &next = tables.transitions[state][ operatorClass(*c) ];
+            if( next==States::Stop || next==States::BadOperator )
+                next = nextFreeState++;
+
+            state = next;
+        }
+
+        tables.accept[state] = spelling.token;
+
+        if( spelling.token==Tokens::COMMENT_LINE_END )
+            tables.lineComment = state;
+        else if( spelling.token==Tokens::COMMENT_MULTILINE )
+            tables.blockComment = state;
+    }
+
+    // Comments. The "//" and "/*" trie nodes are where the comment bodies are consumed
+    for( CharClass cls=0; cls<Classes::NumClasses; ++cls )
+        tables.transitions[tables.lineComment][cls] = tables.lineComment;
+    tables.transitions[tables.lineComment][Classes::NewLine] = States::Stop;
+    tables.action[tables.lineComment] = Action::LineComment;
+
+    tables.accept[tables.blockComment] = Tokens::ERR;
+    tables.action[tables.blockComment] = Action::OpenComment;
+    tables.action[States::BlockComment] = Action::CommentBody;
+    tables.action[States::BlockCommentOpen] = Action::NestComment;
+    tables.action[States::BlockCommentClose] = Action::CloseComment;
+    // Only reached at the end of a token when the outermost comment closes
+    tables.accept[States::BlockCommentClose] = Tokens::COMMENT_MULTILINE;
+    setBlockCommentBody( tables, tables.blockComment );
+    setBlockCommentBody( tables, States::BlockComment );
+    setBlockCommentBody( tables, States::BlockCommentStar );
+    setBlockCommentBody( tables, States::BlockCommentSlash );
+    setBlockCommentBody( tables, States::BlockCommentOpen );
+    setBlockCommentBody( tables, States::BlockCommentClose );
+    tables.transitions[States::BlockCommentStar][ operatorClass('/') ] = States::BlockCommentClose;
+    tables.transitions[States::BlockCommentSlash][ operatorClass('*') ] = States::BlockCommentOpen;
+
+    return tables;
+}
+
+static constexpr Tables tables = buildTables();
+
+static_assert( tables.lineComment!=States::Stop && tables.blockComment!=States::Stop,
+        "Comment operators missing from the operators list" );
+
+} // namespace Tokenizer::Dfa
+
+#endif // TOKENIZER_DFA_H
@@ -0,0 +1,117 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer.h"
+
+#include "asserts.h"
+
+// Incremental re-lexing
+//
+// No state carries over from one token to the next, so lexing from any token boundary of an unchanged stretch of text
+// produces the tokens the old stream has there. We lex from a boundary safely before the edit, until a token starts
+// after the edit at an offset where the old stream also had one. Everything from there on is the old stream, moved.
+namespace Tokenizer {
+
+std::pair<size_t, size_t> Tokenizer::relex(std::vector<Token> &tokens, const Edit &edit, String source, Engine engine) {
+    if( tokens.empty() ) {
+        tokens = tokenize(source, engine);
+        return std::make_pair( size_t(0), tokens.size() );
+    }
+
+    ASSERT( edit.begin<=edit.end );
+    // Only used for offset calculations. The old buffer may well be gone by now
+    const char *oldBase = tokens[0].text.get();
+    auto oldOffset = [oldBase]( const Token &token ) -> size_t {
+        return token.text.get() - oldBase;
+    };
+
+    ASSERT( source.size() + (edit.end - edit.begin) ==
+            oldOffset( tokens.back() ) + tokens.back().text.size() + edit.replacement.size() ) <<
+            "Edit does not match the buffers";
+
+    // The last token starting before the edit might grow into it. Tokens not separated by trivia may have looked past
+    // their own end (e.g. "1." before a digit), so back up to the start of the whole run.
+    size_t restart = 0;
+    while( restart+1<tokens.size() && oldOffset( tokens[restart+1] ) < edit.begin )
+        restart++;
+    while( restart>0 && !isTrivia( tokens[restart-1].token ) && !isTrivia( tokens[restart].token ) )
+        restart--;
+
+    // Offsets in the new buffer from this point on are shifted by the edit
+    const size_t editEnd = edit.begin + edit.replacement.size();
+
+    // The text around the edit was valid UTF-8 when it was first lexed. Only check from the restart token, which
+    // starts on a character boundary, to the end of the last character the replacement touches
+    const size_t checkBegin = oldOffset( tokens[restart] );
+    size_t checkEnd = editEnd;
+    while( checkEnd<source.size() && (source[checkEnd] & 0xc0)==0x80 )
+        checkEnd++;
+    Utf8::Validation encoding = Utf8::validate( source.get() + checkBegin, source.get() + checkEnd );
+    if( encoding.firstInvalid < checkEnd - checkBegin )
+        encoding.firstInvalid += checkBegin;
+    else
+        encoding.firstInvalid = source.size();
+
+    Tokenizer tokenizer(source, engine, encoding);
+    tokenizer.position = checkBegin;
+    tokenizer.location = tokens[restart].location;
+    std::vector<Token> fresh;
+    size_t resync = restart;
+
+    while( true ) {
+        if( tokenizer.position>=editEnd ) {
+            size_t oldPosition = tokenizer.position - editEnd + edit.end;
+            while( resync<tokens.size() && oldOffset( tokens[resync] ) < oldPosition )
+                resync++;
+
+            if( resync<tokens.size() && oldOffset( tokens[resync] )==oldPosition )
+                break;
+        }
+
+        if( !tokenizer.next() ) {
+            resync = tokens.size();
+            break;
+        }
+
+        fresh.emplace_back( tokenizer.current() );
+    }
+
+    // Move the untouched tail to its new place
+    if( resync<tokens.size() ) {
+        const SourceLocation oldLocation = tokens[resync].location;
+        const SourceLocation newLocation = tokenizer.location;
+
+        for( size_t i=resync; i<tokens.size(); ++i ) {
+            Token &token = tokens[i];
+            token.text = String( source.get() + oldOffset(token) - edit.end + editEnd, token.text.size() );
+
+            // Only the rest of the resync line moves sideways
+            if( token.location.line==oldLocation.line )
+                token.location.col = token.location.col - oldLocation.col + newLocation.col;
+            token.location.line = token.location.line - oldLocation.line + newLocation.line;
+        }
+    }
+
+    for( size_t i=0; i<restart; ++i )
+        tokens[i].text = String( source.get() + oldOffset(tokens[i]), tokens[i].text.size() );
+
+    // Splice in the freshly lexed tokens
+    size_t replaced = resync - restart;
+    size_t common = std::min( replaced, fresh.size() );
+    std::move( fresh.begin(), fresh.begin() + common, tokens.begin() + restart );
+    if( fresh.size()>replaced ) {
+        tokens.insert( tokens.begin() + resync,
+                std::make_move_iterator( fresh.begin() + common ), std::make_move_iterator( fresh.end() ) );
+    } else {
+        tokens.erase( tokens.begin() + restart + common, tokens.begin() + resync );
+    }
+
+    return std::make_pair( restart, restart + fresh.size() );
+}
+
+} // namespace Tokenizer
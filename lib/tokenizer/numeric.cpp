@@ -0,0 +1,146 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer/numeric.h"
+
+#include "asserts.h"
+
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+namespace Tokenizer {
+
+static constexpr unsigned NotADigit = 255;
+
+static unsigned digitValue(char c) {
+    if( c>='0' && c<='9' )
+        return c-'0';
+    if( c>='a' && c<='f' )
+        return c-'a'+10;
+    if( c>='A' && c<='F' )
+        return c-'A'+10;
+
+    return NotADigit;
+}
+
+static bool isDecimal(char c) {
+    return c>='0' && c<='9';
+}
+
+// Characters that, if glued to the end of a literal, make it malformed. Anything beyond ASCII would either be an
+// identifier character or an invalid one
+static bool isLiteralTail(char c) {
+    return isDecimal(c) || (c>='a' && c<='z') || (c>='A' && c<='Z') || c=='_' || (c & 0x80)!=0;
+}
+
+static size_t skipDecimalDigits(String text, size_t pos) {
+    while( pos<text.size() && (isDecimal(text[pos]) || text[pos]=='_') )
+        ++pos;
+
+    return pos;
+}
+
+NumericLiteral scanNumericLiteral(String text) {
+    using Unsigned = unsigned __int128;
+    static constexpr Unsigned Max = std::numeric_limits<Unsigned>::max();
+
+    ASSERT( text.size()>0 && isDecimal(text[0]) ) << "Numeric literal scan must start at a digit";
+
+    NumericLiteral ret;
+    unsigned base = 10;
+    ret.token = Tokens::LITERAL_INT_10;
+
+    size_t pos = 0;
+    if( text.size()>=2 && text[0]=='0' ) {
+        switch( text[1] ) {
+        case 'x':
+        case 'X':
+            base = 16;
+            ret.token = Tokens::LITERAL_INT_16;
+            pos = 2;
+            break;
+        case 'b':
+        case 'B':
+            base = 2;
+            ret.token = Tokens::LITERAL_INT_2;
+            pos = 2;
+            break;
+        case 'o':
+            base = 8;
+            ret.token = Tokens::LITERAL_INT_8;
+            pos = 2;
+            break;
+        }
+    }
+
+    Unsigned value = 0;
+    size_t numDigits = 0;
+    bool overflow = false;
+    for( ; pos<text.size(); ++pos ) {
+        if( text[pos]=='_' )
+            continue;
+
+        unsigned digit = digitValue( text[pos] );
+        if( digit>=base )
+            break;
+
+        if( value > (Max - digit) / base )
+            overflow = true;
+        value = value*base + digit;
+        ++numDigits;
+    }
+
+    bool floatingPoint = false;
+    if( base==10 ) {
+        // A dot is only part of the literal if a digit follows it. Otherwise it's a member access
+        if( pos+1<text.size() && text[pos]=='.' && isDecimal(text[pos+1]) ) {
+            floatingPoint = true;
+            pos = skipDecimalDigits(text, pos+1);
+        }
+
+        if( pos<text.size() && (text[pos]=='e' || text[pos]=='E') ) {
+            size_t exponent = pos+1;
+            if( exponent<text.size() && (text[exponent]=='+' || text[exponent]=='-') )
+                ++exponent;
+
+            if( exponent<text.size() && isDecimal(text[exponent]) ) {
+                floatingPoint = true;
+                pos = skipDecimalDigits(text, exponent);
+            }
+        }
+    }
+
+    ret.length = pos;
+    if( (pos<text.size() && isLiteralTail(text[pos])) || numDigits==0 ) {
+        while( ret.length<text.size() && isLiteralTail(text[ret.length]) )
+            ++ret.length;
+
+        ret.token = Tokens::ERR;
+        ret.error = "Invalid numeric literal";
+    } else if( floatingPoint ) {
+        std::string digits;
+        digits.reserve( pos );
+        for( char c : text.subslice(0, pos) ) {
+            if( c!='_' )
+                digits += c;
+        }
+
+        ret.token = Tokens::LITERAL_FP;
+        ret.value = std::strtod( digits.c_str(), nullptr );
+    } else if( overflow ) {
+        ret.token = Tokens::ERR;
+        ret.error = "Literal integer too big";
+    } else {
+        ret.value = ExactInt( value );
+    }
+
+    return ret;
+}
+
+} // namespace Tokenizer
@@ -0,0 +1,32 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_NUMERIC_H
+#define TOKENIZER_NUMERIC_H
+
+#include "tokenizer.h"
+
+namespace Tokenizer {
+
+struct NumericLiteral {
+    size_t length = 0;
+    Tokens token = Tokens::ERR;
+    LiteralValue value;
+    // Set if the literal is malformed. length still covers the whole offending text
+    const char *error = nullptr;
+};
+
+// Scan and decode the numeric literal at the start of text, which must start with a digit.
+//
+// Supported forms are decimal, 0x hexadecimal, 0b binary and 0o octal integers, as well as decimal floating point
+// with a fraction and/or an exponent. Digits may be separated by '_'.
+NumericLiteral scanNumericLiteral(String text);
+
+} // namespace Tokenizer
+
+#endif // TOKENIZER_NUMERIC_H
@@ -0,0 +1,146 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer.h"
+
+#include "asserts.h"
+
+#include <practical/errors.h>
+
+#include <cstring>
+#include <thread>
+
+// Parallel tokenization
+//
+// The source is split into chunks that start at the beginning of a line. Each chunk is lexed on its own thread on the
+// guess that a token starts there. Line numbers are counted from the chunk's start, and fixed up later. Columns need no
+// fixing, as chunks start at a line's beginning.
+//
+// The results are then stitched together in order. Whenever the sequential position coincides with the start of a
+// speculatively lexed token, everything the speculation lexed from that point on is exactly what the sequential scan
+// would have produced. Where it does not (the chunk started inside a comment or a string, or the speculation hit an
+// error), tokens are lexed sequentially until the two align again.
+namespace Tokenizer {
+
+namespace {
+
+struct Speculation {
+    size_t begin, end;
+    std::vector<Token> tokens;
+    // Position and location just past the last token lexed
+    size_t endPosition;
+    SourceLocation endLocation{ .line=1, .col=1 };
+};
+
+} // anonymous namespace
+
+std::vector<Token> Tokenizer::tokenizeParallel(String source, unsigned threads, size_t minChunkSize, Engine engine) {
+    if( threads==0 )
+        threads = std::max( std::thread::hardware_concurrency(), 1u );
+    if( minChunkSize==0 )
+        minChunkSize = 1;
+
+    size_t numChunks = std::min<size_t>( threads, source.size() / minChunkSize );
+    if( numChunks<=1 )
+        return tokenize(source, engine);
+
+    // One encoding check for everyone
+    const Utf8::Validation encoding = Utf8::validate( source.get(), source.get() + source.size() );
+
+    // Place chunk boundaries just after a new line
+    std::vector<Speculation> speculations;
+    size_t previousBegin = 0;
+    speculations.emplace_back();
+    speculations.back().begin = 0;
+    for( size_t i=1; i<numChunks; ++i ) {
+        size_t nominal = source.size() * i / numChunks;
+        if( nominal<=previousBegin )
+            continue;
+
+        const char *newLine = static_cast<const char *>(
+                memchr( source.get() + nominal, '\n', source.size() - nominal ) );
+        if( newLine==nullptr )
+            break;
+
+        size_t begin = newLine - source.get() + 1;
+        if( begin>=source.size() )
+            break;
+
+        speculations.back().end = begin;
+        speculations.emplace_back();
+        speculations.back().begin = previousBegin = begin;
+    }
+    speculations.back().end = source.size();
+
+    auto speculate = [source, engine, &encoding]( Speculation &speculation ) {
+        Tokenizer tokenizer(source, engine, encoding);
+        tokenizer.position = speculation.endPosition = speculation.begin;
+
+        try {
+            while( tokenizer.position < speculation.end && tokenizer.next() ) {
+                speculation.tokens.emplace_back( tokenizer.current() );
+                speculation.endPosition = tokenizer.position;
+                speculation.endLocation = tokenizer.location;
+            }
+        } catch( PracticalSemanticAnalyzer::tokenizer_error & ) {
+            // Either a real error or a bad guess. Either way, the sequential pass will lex from here on
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for( size_t i=1; i<speculations.size(); ++i )
+        workers.emplace_back( speculate, std::ref(speculations[i]) );
+    speculate( speculations[0] );
+    for( auto &worker : workers )
+        worker.join();
+
+    // Stitch
+    auto offsetOf = [source]( const Token &token ) -> size_t {
+        return token.text.get() - source.get();
+    };
+
+    std::vector<Token> tokens;
+    Tokenizer tokenizer(source, engine, encoding);
+    size_t chunk = 0, speculated = 0;
+    while( true ) {
+        while( chunk+1 < speculations.size() && tokenizer.position >= speculations[chunk+1].begin ) {
+            chunk++;
+            speculated = 0;
+        }
+
+        Speculation &speculation = speculations[chunk];
+        while( speculated<speculation.tokens.size() && offsetOf(speculation.tokens[speculated]) < tokenizer.position )
+            speculated++;
+
+        if( speculated<speculation.tokens.size() && offsetOf(speculation.tokens[speculated])==tokenizer.position ) {
+            // In sync with the speculation. Take the rest of it wholesale
+            unsigned lineDelta = tokenizer.location.line - speculation.tokens[speculated].location.line;
+            ASSERT( tokenizer.location.col == speculation.tokens[speculated].location.col );
+
+            for( ; speculated<speculation.tokens.size(); ++speculated ) {
+                Token &token = tokens.emplace_back( std::move(speculation.tokens[speculated]) );
+                token.location.line += lineDelta;
+            }
+
+            tokenizer.position = speculation.endPosition;
+            tokenizer.location = speculation.endLocation;
+            tokenizer.location.line += lineDelta;
+
+            continue;
+        }
+
+        if( !tokenizer.next() )
+            break;
+
+        tokens.emplace_back( tokenizer.current() );
+    }
+
+    return tokens;
+}
+
+} // namespace Tokenizer
@@ -0,0 +1,99 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_PERFECT_HASH_H
+#define TOKENIZER_PERFECT_HASH_H
+
+#include "tokenizer/spellings.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace Tokenizer {
+
+constexpr size_t spellingLength(const char *text) {
+    size_t length = 0;
+    while( text[length]!='\0' )
+        ++length;
+
+    return length;
+}
+
+constexpr uint32_t spellingHash(const char *text, size_t length, uint32_t seed) {
+    uint32_t hash = seed ^ static_cast<uint32_t>(length);
+    for( size_t i=0; i<length; ++i )
+        hash = (hash ^ static_cast<unsigned char>(text[i])) * 16777619u;
+
+    return hash;
+}
+
+// Collision free hash table over a fixed list of spellings, built at compile time.
+//
+// The seed of the hash function is searched for until no two spellings share a slot, so a lookup is one hash
+// calculation and at most one string comparison.
+template<size_t N, size_t TableSize>
+class PerfectHash {
+    static_assert( (TableSize & (TableSize-1))==0, "Table size must be a power of 2" );
+    static_assert( N<TableSize && TableSize<=256, "Slots must fit in a byte" );
+    static constexpr uint8_t Empty = 0xff;
+    static constexpr uint32_t MaxSeed = 10000;
+
+    const std::array<Spelling, N> &spellings;
+    std::array<uint8_t, N> lengths{};
+    std::array<uint8_t, TableSize> slots{};
+    uint32_t seed = 0;
+    size_t maxLength = 0;
+
+public:
+    constexpr explicit PerfectHash(const std::array<Spelling, N> &spellings) : spellings(spellings) {
+        for( size_t i=0; i<N; ++i ) {
+            lengths[i] = spellingLength( spellings[i].text );
+            if( lengths[i]>maxLength )
+                maxLength = lengths[i];
+        }
+
+        while( !tryBuild() ) {
+            if( ++seed==MaxSeed )
+                throw std::logic_error("No perfect hash seed found. Enlarge the table");
+        }
+    }
+
+    // Returns notFound if text is not one of the spellings
+    Tokens lookup(String text, Tokens notFound) const {
+        if( text.size()>maxLength || text.size()==0 )
+            return notFound;
+
+        uint8_t slot = slots[ spellingHash( text.get(), text.size(), seed ) & (TableSize-1) ];
+        if( slot==Empty || lengths[slot]!=text.size() || memcmp( spellings[slot].text, text.get(), text.size() )!=0 )
+            return notFound;
+
+        return spellings[slot].token;
+    }
+
+private:
+    constexpr bool tryBuild() {
+        for( auto &slot : slots )
+            slot = Empty;
+
+        for( size_t i=0; i<N; ++i ) {
+            uint8_t &slot = slots[ spellingHash( spellings[i].text, lengths[i], seed ) & (TableSize-1) ];
+            if( slot!=Empty )
+                return false;
+
+            slot = i;
+        }
+
+        return true;
+    }
+};
+
+} // namespace Tokenizer
+
+#endif // TOKENIZER_PERFECT_HASH_H
@@ -0,0 +1,113 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2018-2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_SPELLINGS_H
+#define TOKENIZER_SPELLINGS_H
+
+#include "tokenizer.h"
+
+#include <array>
+
+namespace Tokenizer {
+
+struct Spelling {
+    const char *text;
+    Tokens token;
+};
+
+// Characters that may form part of an operator. A run of these is consumed as a single operator
+static constexpr char OperatorChars[] = "~!#/$%^&*-=+<>.|:@";
+
+// All multi-character spellings must have every one of their prefixes also be a valid operator. Both tokenizer engines
+// rely on that.
+static constexpr std::array<Spelling, 42> OperatorSpellings {{
+    // Precedence 1
+    { "::", Tokens::OP_DOUBLE_COLON },
+    // Precedence 2
+    { "++", Tokens::OP_PLUS_PLUS },
+    { "--", Tokens::OP_MINUS_MINUS },
+    { ".", Tokens::OP_DOT },
+    { "->", Tokens::OP_ARROW },
+    { "@", Tokens::OP_PTR },
+    // Precedence 3
+    { "+", Tokens::OP_PLUS },
+    { "-", Tokens::OP_MINUS },
+    { "~", Tokens::OP_BIT_NOT },
+    { "!", Tokens::OP_LOGIC_NOT },
+    { "*", Tokens::OP_MULTIPLY },
+    { "&", Tokens::OP_AMPERSAND },
+    // Precedence 5
+    { "/", Tokens::OP_DIVIDE },
+    { "%", Tokens::OP_MODULOUS },
+    // Precedence 6
+    { "|", Tokens::OP_BIT_OR },
+    { "^", Tokens::OP_BIT_XOR },
+    // Precedence 8
+    { "<<", Tokens::OP_SHIFT_LEFT },
+    { ">>", Tokens::OP_SHIFT_RIGHT },
+    // Precedence 9
+    { "<", Tokens::OP_LESS_THAN },
+    { "<=", Tokens::OP_LESS_THAN_EQ },
+    { ">", Tokens::OP_GREATER_THAN },
+    { ">=", Tokens::OP_GREATER_THAN_EQ },
+    // Precedence 10
+    { "==", Tokens::OP_EQUALS },
+    { "!=", Tokens::OP_NOT_EQUALS },
+    // Precedence 11
+    { "&&", Tokens::OP_LOGIC_AND },
+    // Precedence 12
+    { "||", Tokens::OP_LOGIC_OR },
+    // Precedence 13
+    { "=", Tokens::OP_ASSIGN },
+    { "+=", Tokens::OP_ASSIGN_PLUS },
+    { "-=", Tokens::OP_ASSIGN_MINUS },
+    { "*=", Tokens::OP_ASSIGN_MULTIPLY },
+    { "/=", Tokens::OP_ASSIGN_DIVIDE },
+    { "%=", Tokens::OP_ASSIGN_MODULOUS },
+    { "<<=", Tokens::OP_ASSIGN_LEFT_SHIFT },
+    { ">>=", Tokens::OP_ASSIGN_RIGHT_SHIFT },
+    { "&=", Tokens::OP_ASSIGN_BIT_AND },
+    { "^=", Tokens::OP_ASSIGN_BIT_XOR },
+    { "|=", Tokens::OP_ASSIGN_BIT_OR },
+
+    // Miscellany
+    { "+++", Tokens::OP_RUNON_ERROR },
+    { "---", Tokens::OP_RUNON_ERROR },
+    { ":", Tokens::OP_COLON },
+    { "//", Tokens::COMMENT_LINE_END },
+    { "/*", Tokens::COMMENT_MULTILINE },
+}};
+
+// Single character tokens that never combine with their neighbours
+static constexpr std::array<Spelling, 8> PunctuationSpellings {{
+    { ";", Tokens::SEMICOLON },
+    { ",", Tokens::COMMA },
+    { "(", Tokens::BRACKET_ROUND_OPEN },
+    { ")", Tokens::BRACKET_ROUND_CLOSE },
+    { "[", Tokens::BRACKET_SQUARE_OPEN },
+    { "]", Tokens::BRACKET_SQUARE_CLOSE },
+    { "{", Tokens::BRACKET_CURLY_OPEN },
+    { "}", Tokens::BRACKET_CURLY_CLOSE },
+}};
+
+static constexpr std::array<Spelling, 10> ReservedWordSpellings {{
+    { "def", Tokens::RESERVED_DEF },
+    { "decl", Tokens::RESERVED_DECL },
+    { "expect", Tokens::RESERVED_EXPECT },
+    { "true", Tokens::RESERVED_TRUE },
+    { "false", Tokens::RESERVED_FALSE },
+    { "if", Tokens::RESERVED_IF },
+    { "else", Tokens::RESERVED_ELSE },
+    { "ref", Tokens::RESERVED_REF },
+    { "null", Tokens::RESERVED_NULL },
+    { "struct", Tokens::RESERVED_STRUCT },
+}};
+
+} // namespace Tokenizer
+
+#endif // TOKENIZER_SPELLINGS_H
@@ -0,0 +1,113 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer/streaming.h"
+
+#include "asserts.h"
+
+namespace Tokenizer {
+
+StreamingTokenizer::StreamingTokenizer(String source, size_t lookahead, Engine engine) :
+    tokenizer(source, engine),
+    ring(lookahead)
+{
+    ASSERT( lookahead>0 );
+}
+
+Slice<const Token> StreamingTokenizer::nextDefinition() {
+    std::vector<Token> segment;
+    unsigned depth = 0;
+    bool done = false;
+
+    while( !done ) {
+        const Token *token = peek();
+        if( token==nullptr )
+            break;
+
+        switch( token->token ) {
+        case Tokens::BRACKET_ROUND_OPEN:
+        case Tokens::BRACKET_SQUARE_OPEN:
+        case Tokens::BRACKET_CURLY_OPEN:
+            depth++;
+            break;
+        case Tokens::BRACKET_ROUND_CLOSE:
+        case Tokens::BRACKET_SQUARE_CLOSE:
+            if( depth>0 )
+                depth--;
+            break;
+        case Tokens::BRACKET_CURLY_CLOSE:
+            if( depth>0 )
+                depth--;
+            done = depth==0;
+            break;
+        case Tokens::SEMICOLON:
+            done = depth==0;
+            break;
+        default:
+            break;
+        }
+
+        if( !Tokenizer::isTrivia(token->token) )
+            segment.push_back( *token );
+        pop();
+    }
+
+    if( segment.empty() )
+        return Slice<const Token>();
+
+    segments.emplace_back( std::move(segment) );
+    return segments.back();
+}
+
+Slice<const Token> StreamingTokenizer::pinRemaining(Slice<const Token> unparsed) {
+    std::vector<Token> segment( unparsed.get(), unparsed.get() + unparsed.size() );
+
+    while( const Token *token = peek() ) {
+        if( !Tokenizer::isTrivia(token->token) )
+            segment.push_back( *token );
+        pop();
+    }
+
+    segments.emplace_back( std::move(segment) );
+    return segments.back();
+}
+
+size_t StreamingTokenizer::numPinnedTokens() const {
+    size_t ret = 0;
+    for( const auto &segment : segments )
+        ret += segment.size();
+
+    return ret;
+}
+
+const Token *StreamingTokenizer::peek() {
+    if( count==0 ) {
+        // Refill the whole ring in one go, which keeps the tokenizer's loop hot
+        head = 0;
+        while( !eof && count<ring.size() ) {
+            if( tokenizer.next() )
+                ring[count++] = tokenizer.current();
+            else
+                eof = true;
+        }
+
+        if( count==0 )
+            return nullptr;
+    }
+
+    return &ring[head];
+}
+
+void StreamingTokenizer::pop() {
+    ASSERT( count>0 );
+
+    head = (head+1) % ring.size();
+    count--;
+}
+
+} // namespace Tokenizer
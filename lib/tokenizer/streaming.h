@@ -0,0 +1,64 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_STREAMING_H
+#define TOKENIZER_STREAMING_H
+
+#include "tokenizer.h"
+
+#include "nocopy.h"
+
+#include <vector>
+
+namespace Tokenizer {
+
+// Pull based tokenizer for parsing a module one top level definition at a time.
+//
+// Tokens are lexed on demand into a fixed size lookahead ring. Whenever the parser asks for the next definition, the
+// tokens up to the end of it (a `;` or `}` outside of any brackets) are moved into a pinned segment. Pinned segments
+// never move, as the parse tree keeps pointers into them. White space and comments are dropped, as nothing refers to
+// them after parsing.
+class StreamingTokenizer : private NoCopy {
+public:
+    static constexpr size_t DefaultLookahead = 64;
+
+    explicit StreamingTokenizer(String source, size_t lookahead = DefaultLookahead, Engine engine = Engine::Table);
+
+    // Tokens of the next top level definition. Empty once the source is exhausted
+    Slice<const Token> nextDefinition();
+
+    // Pin the unparsed tokens together with everything not yet lexed, as a single range. For when a definition does not
+    // end where its brackets suggested.
+    Slice<const Token> pinRemaining(Slice<const Token> unparsed);
+
+    bool exhausted() const {
+        return eof && count==0;
+    }
+
+    size_t numPinnedTokens() const;
+
+    const std::vector< std::vector<Token> > &pinnedSegments() const {
+        return segments;
+    }
+
+private:
+    const Token *peek();
+    void pop();
+
+    Tokenizer tokenizer;
+
+    std::vector<Token> ring;
+    size_t head = 0, count = 0;
+    bool eof = false;
+
+    std::vector< std::vector<Token> > segments;
+};
+
+} // namespace Tokenizer
+
+#endif // TOKENIZER_STREAMING_H
@@ -0,0 +1,107 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer/symbols.h"
+
+#include "asserts.h"
+
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace Tokenizer {
+
+namespace {
+
+struct Table {
+    std::shared_mutex lock;
+    // Deque, so the strings the index points into never move. Id n lives at n-1
+    std::deque<std::string> spellings;
+    std::unordered_map<String, SymbolId> index;
+};
+
+Table &table() {
+    static Table table;
+
+    return table;
+}
+
+// The id, and the table's own copy of the spelling
+std::pair<SymbolId, String> internShared(String text) {
+    Table &symbols = table();
+
+    {
+        std::shared_lock<std::shared_mutex> reader( symbols.lock );
+        auto found = symbols.index.find(text);
+        if( found!=symbols.index.end() )
+            return std::make_pair( found->second, found->first );
+    }
+
+    std::unique_lock<std::shared_mutex> writer( symbols.lock );
+    // Someone may have beaten us to it while the lock was released
+    auto found = symbols.index.find(text);
+    if( found!=symbols.index.end() )
+        return std::make_pair( found->second, found->first );
+
+    ASSERT( symbols.spellings.size() < std::numeric_limits<SymbolId>::max() ) << "Out of symbol ids";
+    const std::string &spelling = symbols.spellings.emplace_back( text.get(), text.size() );
+    SymbolId id = symbols.spellings.size();
+    symbols.index.emplace( String(spelling), id );
+
+    return std::make_pair( id, String(spelling) );
+}
+
+} // anonymous namespace
+
+SymbolId Symbols::intern(String text) {
+    // Every identifier the lexer sees is interned, and most of them were seen before. Remember the ones this thread
+    // already has an id for, so those do not touch the shared lock. Spellings in the table never move, so the cache
+    // can point to them
+    thread_local std::unordered_map<String, SymbolId> seen;
+
+    auto cached = seen.find(text);
+    if( cached!=seen.end() )
+        return cached->second;
+
+    auto [id, spelling] = internShared(text);
+    seen.emplace( spelling, id );
+
+    return id;
+}
+
+SymbolId Symbols::find(String text) {
+    Table &symbols = table();
+    std::shared_lock<std::shared_mutex> reader( symbols.lock );
+
+    auto found = symbols.index.find(text);
+    if( found==symbols.index.end() )
+        return NoSymbol;
+
+    return found->second;
+}
+
+String Symbols::text(SymbolId id) {
+    Table &symbols = table();
+    std::shared_lock<std::shared_mutex> reader( symbols.lock );
+
+    ASSERT( id!=NoSymbol && id<=symbols.spellings.size() ) << "Invalid symbol id "<<id;
+    return symbols.spellings[id-1];
+}
+
+size_t Symbols::size() {
+    Table &symbols = table();
+    std::shared_lock<std::shared_mutex> reader( symbols.lock );
+
+    return symbols.spellings.size();
+}
+
+} // namespace Tokenizer
@@ -0,0 +1,40 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_SYMBOLS_H
+#define TOKENIZER_SYMBOLS_H
+
+#include <practical/slice.h>
+
+#include <cstdint>
+
+namespace Tokenizer {
+
+// Dense id of an identifier spelling. Equal ids mean equal spellings
+using SymbolId = uint32_t;
+static constexpr SymbolId NoSymbol = 0;
+
+// Process wide identifier interning table. Safe to use from multiple threads.
+//
+// Spellings are copied into the table, so text returned remains valid after the source it came from is gone.
+class Symbols {
+public:
+    Symbols() = delete;
+
+    // Id for the spelling, allocating a new one the first time it is seen
+    static SymbolId intern(String text);
+    // NoSymbol if the spelling was never interned
+    static SymbolId find(String text);
+    static String text(SymbolId id);
+
+    static size_t size();
+};
+
+} // namespace Tokenizer
+
+#endif // TOKENIZER_SYMBOLS_H
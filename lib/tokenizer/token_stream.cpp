@@ -0,0 +1,117 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer/token_stream.h"
+
+#include <practical/errors.h>
+
+#include <algorithm>
+#include <limits>
+
+using PracticalSemanticAnalyzer::tokenizer_error;
+
+namespace Tokenizer {
+
+static_assert( static_cast<size_t>(Tokens::RESERVED_STRUCT) <= std::numeric_limits<uint8_t>::max(),
+        "Token kinds must fit in a byte" );
+
+TokenStream TokenStream::tokenize(String source, Engine engine) {
+    if( source.size() > std::numeric_limits<uint32_t>::max() )
+        throw tokenizer_error("Source too big for a packed token stream", SourceLocation{ .line=1, .col=1 });
+
+    TokenStream stream;
+    stream.source = source;
+
+    Tokenizer tokenizer(source, engine);
+    while( tokenizer.next() )
+        stream.push( tokenizer.current(), source );
+
+    return stream;
+}
+
+void TokenStream::push(const Token &token, String source) {
+    uint32_t start = token.text.get() - source.get();
+    uint32_t index = kinds.size();
+
+    kinds.push_back( static_cast<uint8_t>(token.token) );
+    starts.push_back( start );
+    lengths.push_back( token.text.size() );
+    symbols.push_back( token.symbol );
+
+    if( lineAnchors.empty() || lineAnchors.back().line != token.location.line )
+        lineAnchors.push_back( LineAnchor{ .offset = start - (token.location.col - 1), .line = token.location.line } );
+
+    if( !std::holds_alternative<std::monostate>(token.value) )
+        values.push_back( IndexedValue{ .index = index, .value = token.value } );
+}
+
+SourceLocation TokenStream::location(size_t index) const {
+    uint32_t start = offset(index);
+
+    auto anchor = std::upper_bound( lineAnchors.begin(), lineAnchors.end(), start,
+            []( uint32_t offset, const LineAnchor &anchor ) { return offset < anchor.offset; } );
+    ASSERT( anchor!=lineAnchors.begin() );
+    --anchor;
+
+    return SourceLocation{ .line = anchor->line, .col = start - anchor->offset + 1 };
+}
+
+const LiteralValue &TokenStream::value(size_t index) const {
+    static const LiteralValue NoValue;
+
+    auto found = std::lower_bound( values.begin(), values.end(), index,
+            []( const IndexedValue &value, size_t index ) { return value.index < index; } );
+    if( found==values.end() || found->index!=index )
+        return NoValue;
+
+    return found->value;
+}
+
+Token TokenStream::token(size_t index) const {
+    Token ret;
+
+    ret.text = text(index);
+    ret.token = kind(index);
+    ret.location = location(index);
+    ret.value = value(index);
+    ret.symbol = symbol(index);
+
+    return ret;
+}
+
+std::vector<Token> TokenStream::materialize() const {
+    std::vector<Token> ret;
+    ret.reserve( size() );
+
+    size_t nextValue = 0;
+    auto anchor = lineAnchors.begin();
+    for( size_t i=0; i<size(); ++i ) {
+        // Tokens are sorted, so the anchors and values can be walked in parallel instead of searched
+        while( anchor+1 != lineAnchors.end() && (anchor+1)->offset <= starts[i] )
+            ++anchor;
+
+        Token &token = ret.emplace_back();
+        token.text = text(i);
+        token.token = kind(i);
+        token.location = SourceLocation{ .line = anchor->line, .col = starts[i] - anchor->offset + 1 };
+
+        if( nextValue<values.size() && values[nextValue].index==i )
+            token.value = values[nextValue++].value;
+        token.symbol = symbols[i];
+    }
+
+    return ret;
+}
+
+size_t TokenStream::memoryUsage() const {
+    return kinds.capacity() * sizeof(kinds[0]) + starts.capacity() * sizeof(starts[0]) +
+            lengths.capacity() * sizeof(lengths[0]) + symbols.capacity() * sizeof(symbols[0]) +
+            lineAnchors.capacity() * sizeof(LineAnchor) + values.capacity() * sizeof(IndexedValue);
+}
+
+} // namespace Tokenizer
@@ -0,0 +1,211 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_TOKEN_STREAM_H
+#define TOKENIZER_TOKEN_STREAM_H
+
+#include "tokenizer.h"
+
+#include "asserts.h"
+#include "nocopy.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Tokenizer {
+
+class TokenView;
+
+// Packed, structure of arrays, token storage.
+//
+// Each token costs a byte for its kind, two 32 bit offsets into the source and its symbol id. Locations are recomputed
+// from a table with one entry per line, and decoded literal values live in a side table. The source must outlive the
+// stream.
+class TokenStream : private NoCopy {
+    String source;
+    std::vector<uint8_t> kinds;
+    std::vector<uint32_t> starts, lengths;
+    // NoSymbol for anything but identifiers
+    std::vector<SymbolId> symbols;
+
+    struct LineAnchor {
+        uint32_t offset;
+        unsigned line;
+    };
+    // Start offset of every line a token starts on, sorted
+    std::vector<LineAnchor> lineAnchors;
+
+    struct IndexedValue {
+        uint32_t index;
+        LiteralValue value;
+    };
+    // Sorted by token index
+    std::vector<IndexedValue> values;
+
+public:
+    TokenStream() = default;
+    TokenStream(TokenStream &&that) = default;
+    TokenStream &operator=(TokenStream &&that) = default;
+
+    static TokenStream tokenize(String source, Engine engine = Engine::Table);
+
+    size_t size() const {
+        return kinds.size();
+    }
+
+    Tokens kind(size_t index) const {
+        ASSERT( index<size() );
+        return static_cast<Tokens>( kinds[index] );
+    }
+
+    String text(size_t index) const {
+        ASSERT( index<size() );
+        return source.subslice( starts[index], starts[index] + lengths[index] );
+    }
+
+    size_t offset(size_t index) const {
+        ASSERT( index<size() );
+        return starts[index];
+    }
+
+    SourceLocation location(size_t index) const;
+    const LiteralValue &value(size_t index) const;
+
+    SymbolId symbol(size_t index) const {
+        ASSERT( index<size() );
+        return symbols[index];
+    }
+
+    // Reconstruct the full token
+    Token token(size_t index) const;
+    // Convert to the format the parser currently consumes
+    std::vector<Token> materialize() const;
+
+    TokenView view() const;
+
+    // Memory used by the token storage, excluding the source itself
+    size_t memoryUsage() const;
+
+private:
+    void push(const Token &token, String source);
+};
+
+// A range of tokens inside a stream. Mirrors the parts of Slice<const Token> the parser uses.
+class TokenView {
+    const TokenStream *stream = nullptr;
+    size_t first = 0, len = 0;
+
+public:
+    // Lightweight handle of a single token
+    class Ref {
+        const TokenStream *stream;
+        size_t idx;
+
+    public:
+        Ref(const TokenStream *stream, size_t index) : stream(stream), idx(index) {}
+
+        size_t index() const {
+            return idx;
+        }
+
+        Tokens kind() const {
+            return stream->kind(idx);
+        }
+
+        String text() const {
+            return stream->text(idx);
+        }
+
+        SourceLocation location() const {
+            return stream->location(idx);
+        }
+
+        const LiteralValue &value() const {
+            return stream->value(idx);
+        }
+
+        SymbolId symbol() const {
+            return stream->symbol(idx);
+        }
+
+        Token token() const {
+            return stream->token(idx);
+        }
+
+        bool operator==(const Ref &that) const {
+            return stream==that.stream && idx==that.idx;
+        }
+    };
+
+    class iterator {
+        const TokenStream *stream;
+        size_t idx;
+
+    public:
+        iterator(const TokenStream *stream, size_t index) : stream(stream), idx(index) {}
+
+        Ref operator*() const {
+            return Ref(stream, idx);
+        }
+
+        iterator &operator++() {
+            ++idx;
+            return *this;
+        }
+
+        bool operator==(const iterator &that) const {
+            return idx==that.idx;
+        }
+
+        bool operator!=(const iterator &that) const {
+            return idx!=that.idx;
+        }
+    };
+
+    TokenView() = default;
+    TokenView(const TokenStream *stream, size_t first, size_t length) : stream(stream), first(first), len(length) {}
+
+    size_t size() const {
+        return len;
+    }
+
+    Ref operator[](size_t index) const {
+        ASSERT( index<len );
+        return Ref(stream, first+index);
+    }
+
+    TokenView subslice(size_t start) const {
+        return subslice(start, len);
+    }
+
+    TokenView subslice(size_t start, size_t end) const {
+        if( end<=start )
+            return TokenView();
+
+        ASSERT( start<len );
+        ASSERT( end<=len );
+
+        return TokenView(stream, first+start, end-start);
+    }
+
+    iterator begin() const {
+        return iterator(stream, first);
+    }
+
+    iterator end() const {
+        return iterator(stream, first+len);
+    }
+};
+
+inline TokenView TokenStream::view() const {
+    return TokenView(this, 0, size());
+}
+
+} // namespace Tokenizer
+
+#endif // TOKENIZER_TOKEN_STREAM_H
@@ -0,0 +1,225 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer/trivia.h"
+
+#include <cstdint>
+#include <initializer_list>
+
+#if defined(__x86_64__)
+#define TRIVIA_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Tokenizer::Trivia {
+
+enum class Kind { WhiteSpace, NewLine, CommentSpecial, NonAscii };
+
+template<Kind kind>
+static bool isStop(char c) {
+    switch( kind ) {
+    case Kind::WhiteSpace:
+        return c!=' ' && c!='\t' && c!='\r' && c!='\n';
+    case Kind::NewLine:
+        return c=='\n';
+    case Kind::CommentSpecial:
+        return c=='*' || c=='/';
+    case Kind::NonAscii:
+        return (c & 0x80)!=0;
+    }
+
+    return true;
+}
+
+template<Kind kind>
+static Scan scanScalar(const char *begin, const char *end) {
+    Scan scan;
+
+    const char *current = begin;
+    while( current<end && !isStop<kind>(*current) ) {
+        if( *current=='\n' ) {
+            scan.newLines++;
+            scan.lastNewLine = current;
+        }
+
+        ++current;
+    }
+
+    scan.stop = current;
+
+    return scan;
+}
+
+#if TRIVIA_X86
+// Account for one block, given the bit masks of its stop characters and new lines. Returns whether the scan stopped
+// inside the block.
+static inline bool consumeBlock(Scan &scan, const char *block, uint32_t stopMask, uint32_t newLineMask) {
+    if( stopMask!=0 ) {
+        unsigned index = __builtin_ctz(stopMask);
+        newLineMask &= (uint32_t(1) << index) - 1;
+        scan.stop = block + index;
+    }
+
+    if( newLineMask!=0 ) {
+        scan.newLines += __builtin_popcount(newLineMask);
+        scan.lastNewLine = block + 31 - __builtin_clz(newLineMask);
+    }
+
+    return stopMask!=0;
+}
+
+// Merge the scalar scan of the tail into the block scan so far
+static inline Scan finishTail(Scan scan, const char *current, const char *end, Scan (*tailScan)(const char *, const char *)) {
+    Scan tail = tailScan(current, end);
+    tail.newLines += scan.newLines;
+    if( tail.lastNewLine==nullptr )
+        tail.lastNewLine = scan.lastNewLine;
+
+    return tail;
+}
+
+template<Kind kind>
+static Scan scanSse2(const char *begin, const char *end) {
+    static constexpr size_t Width = 16;
+    const __m128i newLine = _mm_set1_epi8('\n');
+
+    Scan scan;
+    const char *current = begin;
+    while( end-current >= static_cast<ptrdiff_t>(Width) ) {
+        __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i *>(current) );
+        __m128i newLines = _mm_cmpeq_epi8(block, newLine);
+        uint32_t stopMask = 0, newLineMask = _mm_movemask_epi8(newLines);
+
+        switch( kind ) {
+        case Kind::WhiteSpace: {
+            __m128i ws = _mm_or_si128(
+                    _mm_or_si128( _mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\t')) ),
+                    _mm_or_si128( _mm_cmpeq_epi8(block, _mm_set1_epi8('\r')), newLines ) );
+            stopMask = ~_mm_movemask_epi8(ws) & 0xffff;
+            break;
+        }
+        case Kind::NewLine:
+            stopMask = newLineMask;
+            newLineMask = 0;
+            break;
+        case Kind::CommentSpecial:
+            stopMask = _mm_movemask_epi8( _mm_or_si128(
+                        _mm_cmpeq_epi8(block, _mm_set1_epi8('*')), _mm_cmpeq_epi8(block, _mm_set1_epi8('/')) ) );
+            break;
+        case Kind::NonAscii:
+            stopMask = _mm_movemask_epi8(block);
+            break;
+        }
+
+        if( consumeBlock(scan, current, stopMask, newLineMask) )
+            return scan;
+
+        current += Width;
+    }
+
+    return finishTail(scan, current, end, scanScalar<kind>);
+}
+
+template<Kind kind>
+__attribute__((target("avx2")))
+static Scan scanAvx2(const char *begin, const char *end) {
+    static constexpr size_t Width = 32;
+    const __m256i newLine = _mm256_set1_epi8('\n');
+
+    Scan scan;
+    const char *current = begin;
+    while( end-current >= static_cast<ptrdiff_t>(Width) ) {
+        __m256i block = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(current) );
+        __m256i newLines = _mm256_cmpeq_epi8(block, newLine);
+        uint32_t stopMask = 0, newLineMask = _mm256_movemask_epi8(newLines);
+
+        switch( kind ) {
+        case Kind::WhiteSpace: {
+            __m256i ws = _mm256_or_si256(
+                    _mm256_or_si256(
+                        _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t')) ),
+                    _mm256_or_si256( _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r')), newLines ) );
+            stopMask = ~static_cast<uint32_t>( _mm256_movemask_epi8(ws) );
+            break;
+        }
+        case Kind::NewLine:
+            stopMask = newLineMask;
+            newLineMask = 0;
+            break;
+        case Kind::CommentSpecial:
+            stopMask = _mm256_movemask_epi8( _mm256_or_si256(
+                        _mm256_cmpeq_epi8(block, _mm256_set1_epi8('*')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('/')) ) );
+            break;
+        case Kind::NonAscii:
+            stopMask = _mm256_movemask_epi8(block);
+            break;
+        }
+
+        if( consumeBlock(scan, current, stopMask, newLineMask) )
+            return scan;
+
+        current += Width;
+    }
+
+    return finishTail(scan, current, end, scanSse2<kind>);
+}
+#endif // TRIVIA_X86
+
+static const Kernels ScalarKernels {
+    scanScalar<Kind::WhiteSpace>, scanScalar<Kind::NewLine>, scanScalar<Kind::CommentSpecial>,
+    scanScalar<Kind::NonAscii>
+};
+
+#if TRIVIA_X86
+static const Kernels Sse2Kernels {
+    scanSse2<Kind::WhiteSpace>, scanSse2<Kind::NewLine>, scanSse2<Kind::CommentSpecial>,
+    scanSse2<Kind::NonAscii>
+};
+
+static const Kernels Avx2Kernels {
+    scanAvx2<Kind::WhiteSpace>, scanAvx2<Kind::NewLine>, scanAvx2<Kind::CommentSpecial>,
+    scanAvx2<Kind::NonAscii>
+};
+#endif
+
+const Kernels *kernelsFor(Isa isa) {
+    switch( isa ) {
+    case Isa::Scalar:
+        return &ScalarKernels;
+#if TRIVIA_X86
+    case Isa::Sse2:
+        // Part of the x86_64 baseline
+        return &Sse2Kernels;
+    case Isa::Avx2:
+        if( __builtin_cpu_supports("avx2") )
+            return &Avx2Kernels;
+        break;
+#else
+    default:
+        break;
+#endif
+    }
+
+    return nullptr;
+}
+
+const Kernels &activeKernels() {
+    static const Kernels &kernels = []() -> const Kernels & {
+        for( Isa isa : { Isa::Avx2, Isa::Sse2 } ) {
+            const Kernels *candidate = kernelsFor(isa);
+            if( candidate!=nullptr )
+                return *candidate;
+        }
+
+        return ScalarKernels;
+    }();
+
+    return kernels;
+}
+
+} // namespace Tokenizer::Trivia
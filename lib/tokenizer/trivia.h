@@ -0,0 +1,49 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_TRIVIA_H
+#define TOKENIZER_TRIVIA_H
+
+#include <cstddef>
+
+// Block-at-a-time scanners for the parts of the source that are mostly skipped over: white space and comments, and
+// the ASCII text the UTF-8 validation has nothing to check in
+namespace Tokenizer::Trivia {
+
+struct Scan {
+    // First character not skipped over. end if the scan ran out of input
+    const char *stop = nullptr;
+    // New lines skipped over, and the last of them (nullptr if none)
+    size_t newLines = 0;
+    const char *lastNewLine = nullptr;
+};
+
+using ScanFunction = Scan (*)(const char *begin, const char *end);
+
+struct Kernels {
+    // Skip spaces, tabs, carriage returns and new lines
+    ScanFunction skipWhiteSpace;
+    // Stop at the next new line
+    ScanFunction findNewLine;
+    // Stop at the next '*' or '/', which are the only characters that may open or close a nested comment
+    ScanFunction findCommentSpecial;
+    // Stop at the next byte with the high bit set
+    ScanFunction findNonAscii;
+};
+
+enum class Isa { Scalar, Sse2, Avx2 };
+
+// Returns nullptr if the kernels are not available in this build or on this CPU
+const Kernels *kernelsFor(Isa isa);
+
+// The best kernels available on this CPU
+const Kernels &activeKernels();
+
+} // namespace Tokenizer::Trivia
+
+#endif // TOKENIZER_TRIVIA_H
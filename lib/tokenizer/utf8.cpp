@@ -0,0 +1,136 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer/utf8.h"
+
+#include "asserts.h"
+#include "tokenizer/trivia.h"
+#include "tokenizer/xid_table.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace Tokenizer::Utf8 {
+
+Validation validate(const char *begin, const char *end) {
+    Validation ret;
+    ret.firstInvalid = end - begin;
+
+    const Trivia::Kernels &kernels = Trivia::activeKernels();
+    const char *current = begin;
+    while( (current = kernels.findNonAscii(current, end).stop) < end ) {
+        ret.ascii = false;
+
+        // Decode up to the next ASCII byte, then go back to skipping whole blocks
+        do {
+            size_t length;
+            if( decode(current, end, length)==InvalidCodePoint ) {
+                ret.firstInvalid = current - begin;
+                return ret;
+            }
+
+            current += length;
+        } while( current<end && (*current & 0x80)!=0 );
+    }
+
+    return ret;
+}
+
+char32_t decode(const char *begin, const char *end, size_t &length) {
+    ASSERT( begin<end );
+
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(begin);
+    unsigned char lead = bytes[0];
+    // Range of the second byte. Narrower than a plain continuation byte where that's what rules out overlong
+    // encodings, surrogates and code points past U+10FFFF
+    unsigned char secondMin = 0x80, secondMax = 0xbf;
+    char32_t codePoint;
+
+    length = 0;
+    if( lead<0x80 ) {
+        length = 1;
+        return lead;
+    } else if( lead>=0xc2 && lead<=0xdf ) {
+        length = 2;
+        codePoint = lead & 0x1f;
+    } else if( lead>=0xe0 && lead<=0xef ) {
+        length = 3;
+        codePoint = lead & 0x0f;
+        if( lead==0xe0 )
+            secondMin = 0xa0;
+        else if( lead==0xed )
+            secondMax = 0x9f;
+    } else if( lead>=0xf0 && lead<=0xf4 ) {
+        length = 4;
+        codePoint = lead & 0x07;
+        if( lead==0xf0 )
+            secondMin = 0x90;
+        else if( lead==0xf4 )
+            secondMax = 0x8f;
+    } else {
+        return InvalidCodePoint;
+    }
+
+    if( static_cast<size_t>(end - begin) < length || bytes[1]<secondMin || bytes[1]>secondMax ) {
+        length = 0;
+        return InvalidCodePoint;
+    }
+
+    for( size_t i=1; i<length; ++i ) {
+        if( (bytes[i] & 0xc0)!=0x80 ) {
+            length = 0;
+            return InvalidCodePoint;
+        }
+
+        codePoint = (codePoint << 6) | (bytes[i] & 0x3f);
+    }
+
+    return codePoint;
+}
+
+static Xid::Class xidClass(char32_t codePoint) {
+    ASSERT( codePoint>=0x80 && codePoint<=0x10ffff );
+
+    // The last run starting at or before the code point
+    const uint32_t *run = std::upper_bound(
+            std::begin(Xid::Runs), std::end(Xid::Runs), (codePoint << Xid::ClassBits) | ((1 << Xid::ClassBits) - 1) );
+
+    return static_cast<Xid::Class>( run[-1] & ((1 << Xid::ClassBits) - 1) );
+}
+
+bool isXidStart(char32_t codePoint) {
+    if( codePoint<0x80 )
+        return (codePoint>='a' && codePoint<='z') || (codePoint>='A' && codePoint<='Z') || codePoint=='_';
+
+    return xidClass(codePoint)==Xid::Start;
+}
+
+bool isXidContinue(char32_t codePoint) {
+    if( codePoint<0x80 )
+        return isXidStart(codePoint) || (codePoint>='0' && codePoint<='9');
+
+    return xidClass(codePoint)!=Xid::None;
+}
+
+size_t identifierLength(const char *begin, const char *end, bool start) {
+    const char *current = begin;
+
+    while( current<end ) {
+        size_t length;
+        char32_t codePoint = decode(current, end, length);
+        if( codePoint==InvalidCodePoint || !(start ? isXidStart(codePoint) : isXidContinue(codePoint)) )
+            break;
+
+        current += length;
+        start = false;
+    }
+
+    return current - begin;
+}
+
+} // namespace Tokenizer::Utf8
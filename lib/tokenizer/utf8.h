@@ -0,0 +1,42 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_UTF8_H
+#define TOKENIZER_UTF8_H
+
+#include <cstddef>
+
+namespace Tokenizer::Utf8 {
+
+// What a buffer is made of, as far as encoding goes
+struct Validation {
+    // No byte in the buffer has its high bit set, so none of the non-ASCII paths will ever be taken
+    bool ascii = true;
+    // Offset of the first byte that is not part of a well formed UTF-8 sequence. The buffer's size if there is none
+    size_t firstInvalid = 0;
+};
+
+// One pass over the buffer. ASCII stretches are skipped a block at a time, only multi byte sequences are decoded
+Validation validate(const char *begin, const char *end);
+
+static constexpr char32_t InvalidCodePoint = 0xffffffff;
+
+// Decode the sequence at begin, setting length to its size. Returns InvalidCodePoint, and a length of 0, for a
+// malformed or truncated sequence
+char32_t decode(const char *begin, const char *end, size_t &length);
+
+bool isXidStart(char32_t codePoint);
+bool isXidContinue(char32_t codePoint);
+
+// Length in bytes of the run of identifier characters at begin. If `start`, the first character must also be able to
+// open an identifier. ASCII follows the language's own rules, the rest of Unicode the XID classes.
+size_t identifierLength(const char *begin, const char *end, bool start);
+
+} // namespace Tokenizer::Utf8
+
+#endif // TOKENIZER_UTF8_H
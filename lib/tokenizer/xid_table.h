@@ -0,0 +1,251 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * To the extent header files enjoy copyright protection, this file is file is copyright (C) 2020 by its authors
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#ifndef TOKENIZER_XID_TABLE_H
+#define TOKENIZER_XID_TABLE_H
+
+#include <cstdint>
+
+// Generated from the Unicode 14.0.0 character database: XID_Start and XID_Continue of all code points above 0x7f.
+//
+// Each entry opens a run of code points that share a class. The code point of the run's first member is in the upper
+// bits, the class of the run is in the lower two bits.
+namespace Tokenizer::Utf8::Xid {
+
+enum Class : uint32_t { None = 0, Continue = 1, Start = 2 };
+
+static constexpr unsigned ClassBits = 2;
+
+static constexpr uint32_t Runs[] = {
+    0x00000200, 0x000002aa, 0x000002ac, 0x000002d6, 0x000002d8, 0x000002dd, 0x000002e0, 0x000002ea,
+    0x000002ec, 0x00000302, 0x0000035c, 0x00000362, 0x000003dc, 0x000003e2, 0x00000b08, 0x00000b1a,
+    0x00000b48, 0x00000b82, 0x00000b94, 0x00000bb2, 0x00000bb4, 0x00000bba, 0x00000bbc, 0x00000c01,
+    0x00000dc2, 0x00000dd4, 0x00000dda, 0x00000de0, 0x00000dee, 0x00000df8, 0x00000dfe, 0x00000e00,
+    0x00000e1a, 0x00000e1d, 0x00000e22, 0x00000e2c, 0x00000e32, 0x00000e34, 0x00000e3a, 0x00000e88,
+    0x00000e8e, 0x00000fd8, 0x00000fde, 0x00001208, 0x0000120d, 0x00001220, 0x0000122a, 0x000014c0,
+    0x000014c6, 0x0000155c, 0x00001566, 0x00001568, 0x00001582, 0x00001624, 0x00001645, 0x000016f8,
+    0x000016fd, 0x00001700, 0x00001705, 0x0000170c, 0x00001711, 0x00001718, 0x0000171d, 0x00001720,
+    0x00001742, 0x000017ac, 0x000017be, 0x000017cc, 0x00001841, 0x0000186c, 0x00001882, 0x0000192d,
+    0x000019a8, 0x000019ba, 0x000019c1, 0x000019c6, 0x00001b50, 0x00001b56, 0x00001b59, 0x00001b74,
+    0x00001b7d, 0x00001b96, 0x00001b9d, 0x00001ba4, 0x00001ba9, 0x00001bba, 0x00001bc1, 0x00001bea,
+    0x00001bf4, 0x00001bfe, 0x00001c00, 0x00001c42, 0x00001c45, 0x00001c4a, 0x00001cc1, 0x00001d2c,
+    0x00001d36, 0x00001e99, 0x00001ec6, 0x00001ec8, 0x00001f01, 0x00001f2a, 0x00001fad, 0x00001fd2,
+    0x00001fd8, 0x00001fea, 0x00001fec, 0x00001ff5, 0x00001ff8, 0x00002002, 0x00002059, 0x0000206a,
+    0x0000206d, 0x00002092, 0x00002095, 0x000020a2, 0x000020a5, 0x000020b8, 0x00002102, 0x00002165,
+    0x00002170, 0x00002182, 0x000021ac, 0x000021c2, 0x00002220, 0x00002226, 0x0000223c, 0x00002261,
+    0x00002282, 0x00002329, 0x00002388, 0x0000238d, 0x00002412, 0x000024e9, 0x000024f6, 0x000024f9,
+    0x00002542, 0x00002545, 0x00002562, 0x00002589, 0x00002590, 0x00002599, 0x000025c0, 0x000025c6,
+    0x00002605, 0x00002610, 0x00002616, 0x00002634, 0x0000263e, 0x00002644, 0x0000264e, 0x000026a4,
+    0x000026aa, 0x000026c4, 0x000026ca, 0x000026cc, 0x000026da, 0x000026e8, 0x000026f1, 0x000026f6,
+    0x000026f9, 0x00002714, 0x0000271d, 0x00002724, 0x0000272d, 0x0000273a, 0x0000273c, 0x0000275d,
+    0x00002760, 0x00002772, 0x00002778, 0x0000277e, 0x00002789, 0x00002790, 0x00002799, 0x000027c2,
+    0x000027c8, 0x000027f2, 0x000027f4, 0x000027f9, 0x000027fc, 0x00002805, 0x00002810, 0x00002816,
+    0x0000282c, 0x0000283e, 0x00002844, 0x0000284e, 0x000028a4, 0x000028aa, 0x000028c4, 0x000028ca,
+    0x000028d0, 0x000028d6, 0x000028dc, 0x000028e2, 0x000028e8, 0x000028f1, 0x000028f4, 0x000028f9,
+    0x0000290c, 0x0000291d, 0x00002924, 0x0000292d, 0x00002938, 0x00002945, 0x00002948, 0x00002966,
+    0x00002974, 0x0000297a, 0x0000297c, 0x00002999, 0x000029ca, 0x000029d5, 0x000029d8, 0x00002a05,
+    0x00002a10, 0x00002a16, 0x00002a38, 0x00002a3e, 0x00002a48, 0x00002a4e, 0x00002aa4, 0x00002aaa,
+    0x00002ac4, 0x00002aca, 0x00002ad0, 0x00002ad6, 0x00002ae8, 0x00002af1, 0x00002af6, 0x00002af9,
+    0x00002b18, 0x00002b1d, 0x00002b28, 0x00002b2d, 0x00002b38, 0x00002b42, 0x00002b44, 0x00002b82,
+    0x00002b89, 0x00002b90, 0x00002b99, 0x00002bc0, 0x00002be6, 0x00002be9, 0x00002c00, 0x00002c05,
+    0x00002c10, 0x00002c16, 0x00002c34, 0x00002c3e, 0x00002c44, 0x00002c4e, 0x00002ca4, 0x00002caa,
+    0x00002cc4, 0x00002cca, 0x00002cd0, 0x00002cd6, 0x00002ce8, 0x00002cf1, 0x00002cf6, 0x00002cf9,
+    0x00002d14, 0x00002d1d, 0x00002d24, 0x00002d2d, 0x00002d38, 0x00002d55, 0x00002d60, 0x00002d72,
+    0x00002d78, 0x00002d7e, 0x00002d89, 0x00002d90, 0x00002d99, 0x00002dc0, 0x00002dc6, 0x00002dc8,
+    0x00002e09, 0x00002e0e, 0x00002e10, 0x00002e16, 0x00002e2c, 0x00002e3a, 0x00002e44, 0x00002e4a,
+    0x00002e58, 0x00002e66, 0x00002e6c, 0x00002e72, 0x00002e74, 0x00002e7a, 0x00002e80, 0x00002e8e,
+    0x00002e94, 0x00002ea2, 0x00002eac, 0x00002eba, 0x00002ee8, 0x00002ef9, 0x00002f0c, 0x00002f19,
+    0x00002f24, 0x00002f29, 0x00002f38, 0x00002f42, 0x00002f44, 0x00002f5d, 0x00002f60, 0x00002f99,
+    0x00002fc0, 0x00003001, 0x00003016, 0x00003034, 0x0000303a, 0x00003044, 0x0000304a, 0x000030a4,
+    0x000030aa, 0x000030e8, 0x000030f1, 0x000030f6, 0x000030f9, 0x00003114, 0x00003119, 0x00003124,
+    0x00003129, 0x00003138, 0x00003155, 0x0000315c, 0x00003162, 0x0000316c, 0x00003176, 0x00003178,
+    0x00003182, 0x00003189, 0x00003190, 0x00003199, 0x000031c0, 0x00003202, 0x00003205, 0x00003210,
+    0x00003216, 0x00003234, 0x0000323a, 0x00003244, 0x0000324a, 0x000032a4, 0x000032aa, 0x000032d0,
+    0x000032d6, 0x000032e8, 0x000032f1, 0x000032f6, 0x000032f9, 0x00003314, 0x00003319, 0x00003324,
+    0x00003329, 0x00003338, 0x00003355, 0x0000335c, 0x00003376, 0x0000337c, 0x00003382, 0x00003389,
+    0x00003390, 0x00003399, 0x000033c0, 0x000033c6, 0x000033cc, 0x00003401, 0x00003412, 0x00003434,
+    0x0000343a, 0x00003444, 0x0000344a, 0x000034ed, 0x000034f6, 0x000034f9, 0x00003514, 0x00003519,
+    0x00003524, 0x00003529, 0x0000353a, 0x0000353c, 0x00003552, 0x0000355d, 0x00003560, 0x0000357e,
+    0x00003589, 0x00003590, 0x00003599, 0x000035c0, 0x000035ea, 0x00003600, 0x00003605, 0x00003610,
+    0x00003616, 0x0000365c, 0x0000366a, 0x000036c8, 0x000036ce, 0x000036f0, 0x000036f6, 0x000036f8,
+    0x00003702, 0x0000371c, 0x00003729, 0x0000372c, 0x0000373d, 0x00003754, 0x00003759, 0x0000375c,
+    0x00003761, 0x00003780, 0x00003799, 0x000037c0, 0x000037c9, 0x000037d0, 0x00003806, 0x000038c5,
+    0x000038ca, 0x000038cd, 0x000038ec, 0x00003902, 0x0000391d, 0x0000393c, 0x00003941, 0x00003968,
+    0x00003a06, 0x00003a0c, 0x00003a12, 0x00003a14, 0x00003a1a, 0x00003a2c, 0x00003a32, 0x00003a90,
+    0x00003a96, 0x00003a98, 0x00003a9e, 0x00003ac5, 0x00003aca, 0x00003acd, 0x00003af6, 0x00003af8,
+    0x00003b02, 0x00003b14, 0x00003b1a, 0x00003b1c, 0x00003b21, 0x00003b38, 0x00003b41, 0x00003b68,
+    0x00003b72, 0x00003b80, 0x00003c02, 0x00003c04, 0x00003c61, 0x00003c68, 0x00003c81, 0x00003ca8,
+    0x00003cd5, 0x00003cd8, 0x00003cdd, 0x00003ce0, 0x00003ce5, 0x00003ce8, 0x00003cf9, 0x00003d02,
+    0x00003d20, 0x00003d26, 0x00003db4, 0x00003dc5, 0x00003e14, 0x00003e19, 0x00003e22, 0x00003e35,
+    0x00003e60, 0x00003e65, 0x00003ef4, 0x00003f19, 0x00003f1c, 0x00004002, 0x000040ad, 0x000040fe,
+    0x00004101, 0x00004128, 0x00004142, 0x00004159, 0x0000416a, 0x00004179, 0x00004186, 0x00004189,
+    0x00004196, 0x0000419d, 0x000041ba, 0x000041c5, 0x000041d6, 0x00004209, 0x0000423a, 0x0000423d,
+    0x00004278, 0x00004282, 0x00004318, 0x0000431e, 0x00004320, 0x00004336, 0x00004338, 0x00004342,
+    0x000043ec, 0x000043f2, 0x00004924, 0x0000492a, 0x00004938, 0x00004942, 0x0000495c, 0x00004962,
+    0x00004964, 0x0000496a, 0x00004978, 0x00004982, 0x00004a24, 0x00004a2a, 0x00004a38, 0x00004a42,
+    0x00004ac4, 0x00004aca, 0x00004ad8, 0x00004ae2, 0x00004afc, 0x00004b02, 0x00004b04, 0x00004b0a,
+    0x00004b18, 0x00004b22, 0x00004b5c, 0x00004b62, 0x00004c44, 0x00004c4a, 0x00004c58, 0x00004c62,
+    0x00004d6c, 0x00004d75, 0x00004d80, 0x00004da5, 0x00004dc8, 0x00004e02, 0x00004e40, 0x00004e82,
+    0x00004fd8, 0x00004fe2, 0x00004ff8, 0x00005006, 0x000059b4, 0x000059be, 0x00005a00, 0x00005a06,
+    0x00005a6c, 0x00005a82, 0x00005bac, 0x00005bba, 0x00005be4, 0x00005c02, 0x00005c49, 0x00005c58,
+    0x00005c7e, 0x00005cc9, 0x00005cd4, 0x00005d02, 0x00005d49, 0x00005d50, 0x00005d82, 0x00005db4,
+    0x00005dba, 0x00005dc4, 0x00005dc9, 0x00005dd0, 0x00005e02, 0x00005ed1, 0x00005f50, 0x00005f5e,
+    0x00005f60, 0x00005f72, 0x00005f75, 0x00005f78, 0x00005f81, 0x00005fa8, 0x0000602d, 0x00006038,
+    0x0000603d, 0x00006068, 0x00006082, 0x000061e4, 0x00006202, 0x000062a5, 0x000062aa, 0x000062ac,
+    0x000062c2, 0x000063d8, 0x00006402, 0x0000647c, 0x00006481, 0x000064b0, 0x000064c1, 0x000064f0,
+    0x00006519, 0x00006542, 0x000065b8, 0x000065c2, 0x000065d4, 0x00006602, 0x000066b0, 0x000066c2,
+    0x00006728, 0x00006741, 0x0000676c, 0x00006802, 0x0000685d, 0x00006870, 0x00006882, 0x00006955,
+    0x0000697c, 0x00006981, 0x000069f4, 0x000069fd, 0x00006a28, 0x00006a41, 0x00006a68, 0x00006a9e,
+    0x00006aa0, 0x00006ac1, 0x00006af8, 0x00006afd, 0x00006b3c, 0x00006c01, 0x00006c16, 0x00006cd1,
+    0x00006d16, 0x00006d34, 0x00006d41, 0x00006d68, 0x00006dad, 0x00006dd0, 0x00006e01, 0x00006e0e,
+    0x00006e85, 0x00006eba, 0x00006ec1, 0x00006eea, 0x00006f99, 0x00006fd0, 0x00007002, 0x00007091,
+    0x000070e0, 0x00007101, 0x00007128, 0x00007136, 0x00007141, 0x0000716a, 0x000071f8, 0x00007202,
+    0x00007224, 0x00007242, 0x000072ec, 0x000072f6, 0x00007300, 0x00007341, 0x0000734c, 0x00007351,
+    0x000073a6, 0x000073b5, 0x000073ba, 0x000073d1, 0x000073d6, 0x000073dd, 0x000073ea, 0x000073ec,
+    0x00007402, 0x00007701, 0x00007802, 0x00007c58, 0x00007c62, 0x00007c78, 0x00007c82, 0x00007d18,
+    0x00007d22, 0x00007d38, 0x00007d42, 0x00007d60, 0x00007d66, 0x00007d68, 0x00007d6e, 0x00007d70,
+    0x00007d76, 0x00007d78, 0x00007d7e, 0x00007df8, 0x00007e02, 0x00007ed4, 0x00007eda, 0x00007ef4,
+    0x00007efa, 0x00007efc, 0x00007f0a, 0x00007f14, 0x00007f1a, 0x00007f34, 0x00007f42, 0x00007f50,
+    0x00007f5a, 0x00007f70, 0x00007f82, 0x00007fb4, 0x00007fca, 0x00007fd4, 0x00007fda, 0x00007ff4,
+    0x000080fd, 0x00008104, 0x00008151, 0x00008154, 0x000081c6, 0x000081c8, 0x000081fe, 0x00008200,
+    0x00008242, 0x00008274, 0x00008341, 0x00008374, 0x00008385, 0x00008388, 0x00008395, 0x000083c4,
+    0x0000840a, 0x0000840c, 0x0000841e, 0x00008420, 0x0000842a, 0x00008450, 0x00008456, 0x00008458,
+    0x00008462, 0x00008478, 0x00008492, 0x00008494, 0x0000849a, 0x0000849c, 0x000084a2, 0x000084a4,
+    0x000084aa, 0x000084e8, 0x000084f2, 0x00008500, 0x00008516, 0x00008528, 0x0000853a, 0x0000853c,
+    0x00008582, 0x00008624, 0x0000b002, 0x0000b394, 0x0000b3ae, 0x0000b3bd, 0x0000b3ca, 0x0000b3d0,
+    0x0000b402, 0x0000b498, 0x0000b49e, 0x0000b4a0, 0x0000b4b6, 0x0000b4b8, 0x0000b4c2, 0x0000b5a0,
+    0x0000b5be, 0x0000b5c0, 0x0000b5fd, 0x0000b602, 0x0000b65c, 0x0000b682, 0x0000b69c, 0x0000b6a2,
+    0x0000b6bc, 0x0000b6c2, 0x0000b6dc, 0x0000b6e2, 0x0000b6fc, 0x0000b702, 0x0000b71c, 0x0000b722,
+    0x0000b73c, 0x0000b742, 0x0000b75c, 0x0000b762, 0x0000b77c, 0x0000b781, 0x0000b800, 0x0000c016,
+    0x0000c020, 0x0000c086, 0x0000c0a9, 0x0000c0c0, 0x0000c0c6, 0x0000c0d8, 0x0000c0e2, 0x0000c0f4,
+    0x0000c106, 0x0000c25c, 0x0000c265, 0x0000c26c, 0x0000c276, 0x0000c280, 0x0000c286, 0x0000c3ec,
+    0x0000c3f2, 0x0000c400, 0x0000c416, 0x0000c4c0, 0x0000c4c6, 0x0000c63c, 0x0000c682, 0x0000c700,
+    0x0000c7c2, 0x0000c800, 0x0000d002, 0x00013700, 0x00013802, 0x00029234, 0x00029342, 0x000293f8,
+    0x00029402, 0x00029834, 0x00029842, 0x00029881, 0x000298aa, 0x000298b0, 0x00029902, 0x000299bd,
+    0x000299c0, 0x000299d1, 0x000299f8, 0x000299fe, 0x00029a79, 0x00029a82, 0x00029bc1, 0x00029bc8,
+    0x00029c5e, 0x00029c80, 0x00029c8a, 0x00029e24, 0x00029e2e, 0x00029f2c, 0x00029f42, 0x00029f48,
+    0x00029f4e, 0x00029f50, 0x00029f56, 0x00029f68, 0x00029fca, 0x0002a009, 0x0002a00e, 0x0002a019,
+    0x0002a01e, 0x0002a02d, 0x0002a032, 0x0002a08d, 0x0002a0a0, 0x0002a0b1, 0x0002a0b4, 0x0002a102,
+    0x0002a1d0, 0x0002a201, 0x0002a20a, 0x0002a2d1, 0x0002a318, 0x0002a341, 0x0002a368, 0x0002a381,
+    0x0002a3ca, 0x0002a3e0, 0x0002a3ee, 0x0002a3f0, 0x0002a3f6, 0x0002a3fd, 0x0002a42a, 0x0002a499,
+    0x0002a4b8, 0x0002a4c2, 0x0002a51d, 0x0002a550, 0x0002a582, 0x0002a5f4, 0x0002a601, 0x0002a612,
+    0x0002a6cd, 0x0002a704, 0x0002a73e, 0x0002a741, 0x0002a768, 0x0002a782, 0x0002a795, 0x0002a79a,
+    0x0002a7c1, 0x0002a7ea, 0x0002a7fc, 0x0002a802, 0x0002a8a5, 0x0002a8dc, 0x0002a902, 0x0002a90d,
+    0x0002a912, 0x0002a931, 0x0002a938, 0x0002a941, 0x0002a968, 0x0002a982, 0x0002a9dc, 0x0002a9ea,
+    0x0002a9ed, 0x0002a9fa, 0x0002aac1, 0x0002aac6, 0x0002aac9, 0x0002aad6, 0x0002aadd, 0x0002aae6,
+    0x0002aaf9, 0x0002ab02, 0x0002ab05, 0x0002ab0a, 0x0002ab0c, 0x0002ab6e, 0x0002ab78, 0x0002ab82,
+    0x0002abad, 0x0002abc0, 0x0002abca, 0x0002abd5, 0x0002abdc, 0x0002ac06, 0x0002ac1c, 0x0002ac26,
+    0x0002ac3c, 0x0002ac46, 0x0002ac5c, 0x0002ac82, 0x0002ac9c, 0x0002aca2, 0x0002acbc, 0x0002acc2,
+    0x0002ad6c, 0x0002ad72, 0x0002ada8, 0x0002adc2, 0x0002af8d, 0x0002afac, 0x0002afb1, 0x0002afb8,
+    0x0002afc1, 0x0002afe8, 0x0002b002, 0x00035e90, 0x00035ec2, 0x00035f1c, 0x00035f2e, 0x00035ff0,
+    0x0003e402, 0x0003e9b8, 0x0003e9c2, 0x0003eb68, 0x0003ec02, 0x0003ec1c, 0x0003ec4e, 0x0003ec60,
+    0x0003ec76, 0x0003ec79, 0x0003ec7e, 0x0003eca4, 0x0003ecaa, 0x0003ecdc, 0x0003ece2, 0x0003ecf4,
+    0x0003ecfa, 0x0003ecfc, 0x0003ed02, 0x0003ed08, 0x0003ed0e, 0x0003ed14, 0x0003ed1a, 0x0003eec8,
+    0x0003ef4e, 0x0003f178, 0x0003f192, 0x0003f4f8, 0x0003f542, 0x0003f640, 0x0003f64a, 0x0003f720,
+    0x0003f7c2, 0x0003f7e8, 0x0003f801, 0x0003f840, 0x0003f881, 0x0003f8c0, 0x0003f8cd, 0x0003f8d4,
+    0x0003f935, 0x0003f940, 0x0003f9c6, 0x0003f9c8, 0x0003f9ce, 0x0003f9d0, 0x0003f9de, 0x0003f9e0,
+    0x0003f9e6, 0x0003f9e8, 0x0003f9ee, 0x0003f9f0, 0x0003f9f6, 0x0003f9f8, 0x0003f9fe, 0x0003fbf4,
+    0x0003fc41, 0x0003fc68, 0x0003fc86, 0x0003fcec, 0x0003fcfd, 0x0003fd00, 0x0003fd06, 0x0003fd6c,
+    0x0003fd9a, 0x0003fe79, 0x0003fe82, 0x0003fefc, 0x0003ff0a, 0x0003ff20, 0x0003ff2a, 0x0003ff40,
+    0x0003ff4a, 0x0003ff60, 0x0003ff6a, 0x0003ff74, 0x00040002, 0x00040030, 0x00040036, 0x0004009c,
+    0x000400a2, 0x000400ec, 0x000400f2, 0x000400f8, 0x000400fe, 0x00040138, 0x00040142, 0x00040178,
+    0x00040202, 0x000403ec, 0x00040502, 0x000405d4, 0x000407f5, 0x000407f8, 0x00040a02, 0x00040a74,
+    0x00040a82, 0x00040b44, 0x00040b81, 0x00040b84, 0x00040c02, 0x00040c80, 0x00040cb6, 0x00040d2c,
+    0x00040d42, 0x00040dd9, 0x00040dec, 0x00040e02, 0x00040e78, 0x00040e82, 0x00040f10, 0x00040f22,
+    0x00040f40, 0x00040f46, 0x00040f58, 0x00041002, 0x00041278, 0x00041281, 0x000412a8, 0x000412c2,
+    0x00041350, 0x00041362, 0x000413f0, 0x00041402, 0x000414a0, 0x000414c2, 0x00041590, 0x000415c2,
+    0x000415ec, 0x000415f2, 0x0004162c, 0x00041632, 0x0004164c, 0x00041652, 0x00041658, 0x0004165e,
+    0x00041688, 0x0004168e, 0x000416c8, 0x000416ce, 0x000416e8, 0x000416ee, 0x000416f4, 0x00041802,
+    0x00041cdc, 0x00041d02, 0x00041d58, 0x00041d82, 0x00041da0, 0x00041e02, 0x00041e18, 0x00041e1e,
+    0x00041ec4, 0x00041eca, 0x00041eec, 0x00042002, 0x00042018, 0x00042022, 0x00042024, 0x0004202a,
+    0x000420d8, 0x000420de, 0x000420e4, 0x000420f2, 0x000420f4, 0x000420fe, 0x00042158, 0x00042182,
+    0x000421dc, 0x00042202, 0x0004227c, 0x00042382, 0x000423cc, 0x000423d2, 0x000423d8, 0x00042402,
+    0x00042458, 0x00042482, 0x000424e8, 0x00042602, 0x000426e0, 0x000426fa, 0x00042700, 0x00042802,
+    0x00042805, 0x00042810, 0x00042815, 0x0004281c, 0x00042831, 0x00042842, 0x00042850, 0x00042856,
+    0x00042860, 0x00042866, 0x000428d8, 0x000428e1, 0x000428ec, 0x000428fd, 0x00042900, 0x00042982,
+    0x000429f4, 0x00042a02, 0x00042a74, 0x00042b02, 0x00042b20, 0x00042b26, 0x00042b95, 0x00042b9c,
+    0x00042c02, 0x00042cd8, 0x00042d02, 0x00042d58, 0x00042d82, 0x00042dcc, 0x00042e02, 0x00042e48,
+    0x00043002, 0x00043124, 0x00043202, 0x000432cc, 0x00043302, 0x000433cc, 0x00043402, 0x00043491,
+    0x000434a0, 0x000434c1, 0x000434e8, 0x00043a02, 0x00043aa8, 0x00043aad, 0x00043ab4, 0x00043ac2,
+    0x00043ac8, 0x00043c02, 0x00043c74, 0x00043c9e, 0x00043ca0, 0x00043cc2, 0x00043d19, 0x00043d44,
+    0x00043dc2, 0x00043e09, 0x00043e18, 0x00043ec2, 0x00043f14, 0x00043f82, 0x00043fdc, 0x00044001,
+    0x0004400e, 0x000440e1, 0x0004411c, 0x00044199, 0x000441c6, 0x000441cd, 0x000441d6, 0x000441d8,
+    0x000441fd, 0x0004420e, 0x000442c1, 0x000442ec, 0x00044309, 0x0004430c, 0x00044342, 0x000443a4,
+    0x000443c1, 0x000443e8, 0x00044401, 0x0004440e, 0x0004449d, 0x000444d4, 0x000444d9, 0x00044500,
+    0x00044512, 0x00044515, 0x0004451e, 0x00044520, 0x00044542, 0x000445cd, 0x000445d0, 0x000445da,
+    0x000445dc, 0x00044601, 0x0004460e, 0x000446cd, 0x00044706, 0x00044714, 0x00044725, 0x00044734,
+    0x00044739, 0x0004476a, 0x0004476c, 0x00044772, 0x00044774, 0x00044802, 0x00044848, 0x0004484e,
+    0x000448b1, 0x000448e0, 0x000448f9, 0x000448fc, 0x00044a02, 0x00044a1c, 0x00044a22, 0x00044a24,
+    0x00044a2a, 0x00044a38, 0x00044a3e, 0x00044a78, 0x00044a7e, 0x00044aa4, 0x00044ac2, 0x00044b7d,
+    0x00044bac, 0x00044bc1, 0x00044be8, 0x00044c01, 0x00044c10, 0x00044c16, 0x00044c34, 0x00044c3e,
+    0x00044c44, 0x00044c4e, 0x00044ca4, 0x00044caa, 0x00044cc4, 0x00044cca, 0x00044cd0, 0x00044cd6,
+    0x00044ce8, 0x00044ced, 0x00044cf6, 0x00044cf9, 0x00044d14, 0x00044d1d, 0x00044d24, 0x00044d2d,
+    0x00044d38, 0x00044d42, 0x00044d44, 0x00044d5d, 0x00044d60, 0x00044d76, 0x00044d89, 0x00044d90,
+    0x00044d99, 0x00044db4, 0x00044dc1, 0x00044dd4, 0x00045002, 0x000450d5, 0x0004511e, 0x0004512c,
+    0x00045141, 0x00045168, 0x00045179, 0x0004517e, 0x00045188, 0x00045202, 0x000452c1, 0x00045312,
+    0x00045318, 0x0004531e, 0x00045320, 0x00045341, 0x00045368, 0x00045602, 0x000456bd, 0x000456d8,
+    0x000456e1, 0x00045704, 0x00045762, 0x00045771, 0x00045778, 0x00045802, 0x000458c1, 0x00045904,
+    0x00045912, 0x00045914, 0x00045941, 0x00045968, 0x00045a02, 0x00045aad, 0x00045ae2, 0x00045ae4,
+    0x00045b01, 0x00045b28, 0x00045c02, 0x00045c6c, 0x00045c75, 0x00045cb0, 0x00045cc1, 0x00045ce8,
+    0x00045d02, 0x00045d1c, 0x00046002, 0x000460b1, 0x000460ec, 0x00046282, 0x00046381, 0x000463a8,
+    0x000463fe, 0x0004641c, 0x00046426, 0x00046428, 0x00046432, 0x00046450, 0x00046456, 0x0004645c,
+    0x00046462, 0x000464c1, 0x000464d8, 0x000464dd, 0x000464e4, 0x000464ed, 0x000464fe, 0x00046501,
+    0x00046506, 0x00046509, 0x00046510, 0x00046541, 0x00046568, 0x00046682, 0x000466a0, 0x000466aa,
+    0x00046745, 0x00046760, 0x00046769, 0x00046786, 0x00046788, 0x0004678e, 0x00046791, 0x00046794,
+    0x00046802, 0x00046805, 0x0004682e, 0x000468cd, 0x000468ea, 0x000468ed, 0x000468fc, 0x0004691d,
+    0x00046920, 0x00046942, 0x00046945, 0x00046972, 0x00046a29, 0x00046a68, 0x00046a76, 0x00046a78,
+    0x00046ac2, 0x00046be4, 0x00047002, 0x00047024, 0x0004702a, 0x000470bd, 0x000470dc, 0x000470e1,
+    0x00047102, 0x00047104, 0x00047141, 0x00047168, 0x000471ca, 0x00047240, 0x00047249, 0x000472a0,
+    0x000472a5, 0x000472dc, 0x00047402, 0x0004741c, 0x00047422, 0x00047428, 0x0004742e, 0x000474c5,
+    0x000474dc, 0x000474e9, 0x000474ec, 0x000474f1, 0x000474f8, 0x000474fd, 0x0004751a, 0x0004751d,
+    0x00047520, 0x00047541, 0x00047568, 0x00047582, 0x00047598, 0x0004759e, 0x000475a4, 0x000475aa,
+    0x00047629, 0x0004763c, 0x00047641, 0x00047648, 0x0004764d, 0x00047662, 0x00047664, 0x00047681,
+    0x000476a8, 0x00047b82, 0x00047bcd, 0x00047bdc, 0x00047ec2, 0x00047ec4, 0x00048002, 0x00048e68,
+    0x00049002, 0x000491bc, 0x00049202, 0x00049510, 0x0004be42, 0x0004bfc4, 0x0004c002, 0x0004d0bc,
+    0x00051002, 0x0005191c, 0x0005a002, 0x0005a8e4, 0x0005a902, 0x0005a97c, 0x0005a981, 0x0005a9a8,
+    0x0005a9c2, 0x0005aafc, 0x0005ab01, 0x0005ab28, 0x0005ab42, 0x0005abb8, 0x0005abc1, 0x0005abd4,
+    0x0005ac02, 0x0005acc1, 0x0005acdc, 0x0005ad02, 0x0005ad10, 0x0005ad41, 0x0005ad68, 0x0005ad8e,
+    0x0005ade0, 0x0005adf6, 0x0005ae40, 0x0005b902, 0x0005ba00, 0x0005bc02, 0x0005bd2c, 0x0005bd3d,
+    0x0005bd42, 0x0005bd45, 0x0005be20, 0x0005be3d, 0x0005be4e, 0x0005be80, 0x0005bf82, 0x0005bf88,
+    0x0005bf8e, 0x0005bf91, 0x0005bf94, 0x0005bfc1, 0x0005bfc8, 0x0005c002, 0x00061fe0, 0x00062002,
+    0x00063358, 0x00063402, 0x00063424, 0x0006bfc2, 0x0006bfd0, 0x0006bfd6, 0x0006bff0, 0x0006bff6,
+    0x0006bffc, 0x0006c002, 0x0006c48c, 0x0006c542, 0x0006c54c, 0x0006c592, 0x0006c5a0, 0x0006c5c2,
+    0x0006cbf0, 0x0006f002, 0x0006f1ac, 0x0006f1c2, 0x0006f1f4, 0x0006f202, 0x0006f224, 0x0006f242,
+    0x0006f268, 0x0006f275, 0x0006f27c, 0x00073c01, 0x00073cb8, 0x00073cc1, 0x00073d1c, 0x00074595,
+    0x000745a8, 0x000745b5, 0x000745cc, 0x000745ed, 0x0007460c, 0x00074615, 0x00074630, 0x000746a9,
+    0x000746b8, 0x00074909, 0x00074914, 0x00075002, 0x00075154, 0x0007515a, 0x00075274, 0x0007527a,
+    0x00075280, 0x0007528a, 0x0007528c, 0x00075296, 0x0007529c, 0x000752a6, 0x000752b4, 0x000752ba,
+    0x000752e8, 0x000752ee, 0x000752f0, 0x000752f6, 0x00075310, 0x00075316, 0x00075418, 0x0007541e,
+    0x0007542c, 0x00075436, 0x00075454, 0x0007545a, 0x00075474, 0x0007547a, 0x000754e8, 0x000754ee,
+    0x000754fc, 0x00075502, 0x00075514, 0x0007551a, 0x0007551c, 0x0007552a, 0x00075544, 0x0007554a,
+    0x00075a98, 0x00075aa2, 0x00075b04, 0x00075b0a, 0x00075b6c, 0x00075b72, 0x00075bec, 0x00075bf2,
+    0x00075c54, 0x00075c5a, 0x00075cd4, 0x00075cda, 0x00075d3c, 0x00075d42, 0x00075dbc, 0x00075dc2,
+    0x00075e24, 0x00075e2a, 0x00075ea4, 0x00075eaa, 0x00075f0c, 0x00075f12, 0x00075f30, 0x00075f39,
+    0x00076000, 0x00076801, 0x000768dc, 0x000768ed, 0x000769b4, 0x000769d5, 0x000769d8, 0x00076a11,
+    0x00076a14, 0x00076a6d, 0x00076a80, 0x00076a85, 0x00076ac0, 0x00077c02, 0x00077c7c, 0x00078001,
+    0x0007801c, 0x00078021, 0x00078064, 0x0007806d, 0x00078088, 0x0007808d, 0x00078094, 0x00078099,
+    0x000780ac, 0x00078402, 0x000784b4, 0x000784c1, 0x000784de, 0x000784f8, 0x00078501, 0x00078528,
+    0x0007853a, 0x0007853c, 0x00078a42, 0x00078ab9, 0x00078abc, 0x00078b02, 0x00078bb1, 0x00078be8,
+    0x00079f82, 0x00079f9c, 0x00079fa2, 0x00079fb0, 0x00079fb6, 0x00079fbc, 0x00079fc2, 0x00079ffc,
+    0x0007a002, 0x0007a314, 0x0007a341, 0x0007a35c, 0x0007a402, 0x0007a511, 0x0007a52e, 0x0007a530,
+    0x0007a541, 0x0007a568, 0x0007b802, 0x0007b810, 0x0007b816, 0x0007b880, 0x0007b886, 0x0007b88c,
+    0x0007b892, 0x0007b894, 0x0007b89e, 0x0007b8a0, 0x0007b8a6, 0x0007b8cc, 0x0007b8d2, 0x0007b8e0,
+    0x0007b8e6, 0x0007b8e8, 0x0007b8ee, 0x0007b8f0, 0x0007b90a, 0x0007b90c, 0x0007b91e, 0x0007b920,
+    0x0007b926, 0x0007b928, 0x0007b92e, 0x0007b930, 0x0007b936, 0x0007b940, 0x0007b946, 0x0007b94c,
+    0x0007b952, 0x0007b954, 0x0007b95e, 0x0007b960, 0x0007b966, 0x0007b968, 0x0007b96e, 0x0007b970,
+    0x0007b976, 0x0007b978, 0x0007b97e, 0x0007b980, 0x0007b986, 0x0007b98c, 0x0007b992, 0x0007b994,
+    0x0007b99e, 0x0007b9ac, 0x0007b9b2, 0x0007b9cc, 0x0007b9d2, 0x0007b9e0, 0x0007b9e6, 0x0007b9f4,
+    0x0007b9fa, 0x0007b9fc, 0x0007ba02, 0x0007ba28, 0x0007ba2e, 0x0007ba70, 0x0007ba86, 0x0007ba90,
+    0x0007ba96, 0x0007baa8, 0x0007baae, 0x0007baf0, 0x0007efc1, 0x0007efe8, 0x00080002, 0x000a9b80,
+    0x000a9c02, 0x000adce4, 0x000add02, 0x000ae078, 0x000ae082, 0x000b3a88, 0x000b3ac2, 0x000baf84,
+    0x000be002, 0x000be878, 0x000c0002, 0x000c4d2c, 0x00380401, 0x003807c0,
+};
+
+} // namespace Tokenizer::Utf8::Xid
+
+#endif // TOKENIZER_XID_TABLE_H
@@ -0,0 +1,465 @@
+/* This file is part of the Practical programming langauge. https://github.com/Practical/practical-sa
+ *
+ * This file is file is copyright (C) 2020 by its authors.
+ * You can see the file's authors in the AUTHORS file in the project's home repository.
+ *
+ * This is available under the Boost license. The license's text is available under the LICENSE file in the project's
+ * home directory.
+ */
+#include "tokenizer.h"
+#include "tokenizer/spellings.h"
+
+#include <practical/errors.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+// Tokenizer throughput benchmark
+//
+// Generates synthetic corpora, each dominated by one kind of token, and reports how fast the tokenizer gets through
+// them. Corpora are generated from a fixed seed, so numbers from different builds are comparable.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t cycles() {
+#if HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+class Generator {
+    static constexpr size_t VocabularySize = 2048;
+
+    std::mt19937 random;
+    std::string text;
+    std::vector<std::string> vocabulary;
+
+public:
+    explicit Generator(unsigned seed) : random(seed) {
+        static const char First[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_";
+        static const char Rest[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789";
+
+        vocabulary.resize( VocabularySize );
+        for( std::string &word : vocabulary ) {
+            word += First[ pick(sizeof(First)-1) ];
+            for( unsigned length = pick(12); length>0; --length )
+                word += Rest[ pick(sizeof(Rest)-1) ];
+        }
+    }
+
+    std::string take() {
+        return std::move(text);
+    }
+
+    size_t size() const {
+        return text.size();
+    }
+
+    unsigned pick(unsigned limit) {
+        return random() % limit;
+    }
+
+    Generator &operator<<(const char *str) {
+        text += str;
+        return *this;
+    }
+
+    Generator &operator<<(char c) {
+        text += c;
+        return *this;
+    }
+
+    void identifier() {
+        if( pick(10)==0 ) {
+            *this << Tokenizer::ReservedWordSpellings[ pick(Tokenizer::ReservedWordSpellings.size()) ].text;
+            return;
+        }
+
+        // Real code keeps referring to the same names
+        text += vocabulary[ pick(vocabulary.size()) ];
+    }
+
+    void digits(const char *alphabet, unsigned maxLength) {
+        size_t numDigits = strlen(alphabet);
+
+        text += alphabet[ 1 + pick(numDigits-1) ];
+        for( unsigned length = pick(maxLength); length>0; --length ) {
+            if( pick(6)==0 )
+                text += '_';
+            text += alphabet[ pick(numDigits) ];
+        }
+    }
+
+    void number() {
+        switch( pick(6) ) {
+        case 0:
+            *this << "0x";
+            digits("0123456789abcdefABCDEF", 12);
+            break;
+        case 1:
+            *this << "0b";
+            digits("01", 30);
+            break;
+        case 2:
+            *this << "0o";
+            digits("01234567", 14);
+            break;
+        case 3:
+            digits("0123456789", 6);
+            *this << '.';
+            digits("0123456789", 6);
+            if( pick(2)==0 ) {
+                *this << (pick(2)==0 ? "e-" : "e");
+                digits("0123456789", 2);
+            }
+            break;
+        default:
+            digits("0123456789", 10);
+            break;
+        }
+    }
+
+    void words(unsigned count) {
+        for( ; count>0; --count ) {
+            identifier();
+            text += ' ';
+        }
+    }
+
+    void string() {
+        text += '"';
+        for( unsigned length = pick(60); length>0; --length ) {
+            if( pick(15)==0 ) {
+                static const char Escaped[] = "\"\\nt0";
+                text += '\\';
+                text += Escaped[ pick(sizeof(Escaped)-1) ];
+            } else {
+                text += static_cast<char>( ' ' + 1 + pick('~' - ' ') );
+                if( text.back()=='"' || text.back()=='\\' )
+                    text.back() = '_';
+            }
+        }
+        text += '"';
+    }
+
+    void op() {
+        while( true ) {
+            const Tokenizer::Spelling &spelling =
+                    Tokenizer::OperatorSpellings[ pick(Tokenizer::OperatorSpellings.size()) ];
+
+            switch( spelling.token ) {
+            case Tokenizer::Tokens::COMMENT_LINE_END:
+            case Tokenizer::Tokens::COMMENT_MULTILINE:
+            case Tokenizer::Tokens::OP_RUNON_ERROR:
+                continue;
+            default:
+                *this << spelling.text;
+                return;
+            }
+        }
+    }
+
+    void blockComment(unsigned depth) {
+        *this << "/* ";
+        for( unsigned lines = 1 + pick(4); lines>0; --lines ) {
+            words( pick(8) );
+            if( depth<3 && pick(8)==0 )
+                blockComment(depth+1);
+            *this << "\n * ";
+        }
+        *this << "*/";
+    }
+};
+
+struct Corpus {
+    const char *name;
+    std::function<void (Generator &)> line;
+};
+
+const Corpus Corpora[] = {
+    { "identifiers", []( Generator &gen ) {
+            for( unsigned count = 1 + gen.pick(8); count>0; --count ) {
+                gen.identifier();
+                gen << (gen.pick(3)==0 ? "(" : gen.pick(2)==0 ? ", " : " ");
+            }
+            gen << "\n";
+        } },
+    { "numbers", []( Generator &gen ) {
+            for( unsigned count = 1 + gen.pick(8); count>0; --count ) {
+                gen.number();
+                gen << ", ";
+            }
+            gen << "\n";
+        } },
+    { "comments", []( Generator &gen ) {
+            if( gen.pick(3)==0 ) {
+                gen.blockComment(0);
+            } else {
+                gen << "// ";
+                gen.words( gen.pick(12) );
+            }
+            gen << "\n";
+        } },
+    { "strings", []( Generator &gen ) {
+            for( unsigned count = 1 + gen.pick(3); count>0; --count ) {
+                gen.string();
+                gen << " ";
+            }
+            gen << "\n";
+        } },
+    { "operators", []( Generator &gen ) {
+            static const char Operands[] = "abcxyz";
+            for( unsigned count = 4 + gen.pick(16); count>0; --count ) {
+                gen << Operands[ gen.pick(sizeof(Operands)-1) ];
+                gen.op();
+            }
+            gen << "a;\n";
+        } },
+    { "mixed", []( Generator &gen ) {
+            switch( gen.pick(5) ) {
+            case 0:
+                gen << "    // ";
+                gen.words( gen.pick(10) );
+                break;
+            case 1:
+                gen << "def ";
+                gen.identifier();
+                gen << "( a : S32, b : U64 ) -> S32 {";
+                break;
+            case 2:
+                gen << "    def ";
+                gen.identifier();
+                gen << " : S32 = ";
+                gen.number();
+                gen << " + ";
+                gen.identifier();
+                gen << ";";
+                break;
+            case 3:
+                gen << "    if( ";
+                gen.identifier();
+                gen << " < ";
+                gen.number();
+                gen << " ) { f(";
+                gen.string();
+                gen << ") } else { 2 }";
+                break;
+            default:
+                gen << "}";
+                break;
+            }
+            gen << "\n";
+        } },
+};
+
+enum class TokenClass { WhiteSpace, Comment, Identifier, Number, String, Operator, Punctuation, NumClasses };
+
+const char *const TokenClassNames[] = { "white space", "comment", "identifier", "number", "string", "operator",
+        "punctuation" };
+
+TokenClass classify(Tokenizer::Tokens token) {
+    using Tokenizer::Tokens;
+
+    switch( token ) {
+    case Tokens::WS:
+        return TokenClass::WhiteSpace;
+    case Tokens::COMMENT_LINE_END:
+    case Tokens::COMMENT_MULTILINE:
+        return TokenClass::Comment;
+    case Tokens::SEMICOLON:
+    case Tokens::COMMA:
+    case Tokens::BRACKET_ROUND_OPEN:
+    case Tokens::BRACKET_ROUND_CLOSE:
+    case Tokens::BRACKET_SQUARE_OPEN:
+    case Tokens::BRACKET_SQUARE_CLOSE:
+    case Tokens::BRACKET_CURLY_OPEN:
+    case Tokens::BRACKET_CURLY_CLOSE:
+        return TokenClass::Punctuation;
+    case Tokens::LITERAL_INT_2:
+    case Tokens::LITERAL_INT_8:
+    case Tokens::LITERAL_INT_10:
+    case Tokens::LITERAL_INT_16:
+    case Tokens::LITERAL_FP:
+        return TokenClass::Number;
+    case Tokens::LITERAL_STRING:
+        return TokenClass::String;
+    default:
+        break;
+    }
+
+    if( token>=Tokens::IDENTIFIER )
+        return TokenClass::Identifier;
+
+    return TokenClass::Operator;
+}
+
+struct Options {
+    size_t size = 4*1024*1024;
+    unsigned repetitions = 5;
+    unsigned seed = 1;
+    Tokenizer::Engine engine = Tokenizer::Engine::Table;
+    const char *only = nullptr;
+    bool breakdown = true;
+};
+
+void printRate(const char *label, double bytes, double tokens, double seconds, double cycles) {
+    printf( "  %-12s %9.1f MB/s %9.2f Mtokens/s", label, bytes / seconds / 1e6, tokens / seconds / 1e6 );
+    if( HAVE_TSC )
+        printf( " %7.2f cycles/byte", cycles / bytes );
+    printf( "\n" );
+}
+
+void runCorpus(const Corpus &corpus, const Options &options) {
+    Generator generator( options.seed );
+    while( generator.size() < options.size )
+        corpus.line( generator );
+    std::string text = generator.take();
+    String source( text );
+
+    // Warm up, and count the tokens
+    size_t numTokens = Tokenizer::Tokenizer::tokenize( source, options.engine ).size();
+
+    double bestSeconds = 0;
+    uint64_t bestCycles = 0;
+    for( unsigned i=0; i<options.repetitions; ++i ) {
+        auto start = Clock::now();
+        uint64_t startCycles = cycles();
+
+        auto tokens = Tokenizer::Tokenizer::tokenize( source, options.engine );
+
+        uint64_t elapsedCycles = cycles() - startCycles;
+        double seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+
+        if( i==0 || seconds<bestSeconds ) {
+            bestSeconds = seconds;
+            bestCycles = elapsedCycles;
+        }
+    }
+
+    printf( "%s: %zu bytes, %zu tokens\n", corpus.name, text.size(), numTokens );
+    printRate( "total", text.size(), numTokens, bestSeconds, bestCycles );
+
+    if( !options.breakdown || !HAVE_TSC )
+        return;
+
+    // Per class breakdown. Timing each token separately adds overhead, which we measure and take out
+    uint64_t overhead = ~uint64_t(0);
+    for( unsigned i=0; i<1000; ++i ) {
+        uint64_t start = cycles();
+        overhead = std::min( overhead, cycles() - start );
+    }
+
+    constexpr size_t NumClasses = static_cast<size_t>( TokenClass::NumClasses );
+    uint64_t classCycles[NumClasses] = {};
+    size_t classBytes[NumClasses] = {}, classTokens[NumClasses] = {};
+
+    Tokenizer::Tokenizer tokenizer( source, options.engine );
+    while( true ) {
+        uint64_t start = cycles();
+        if( !tokenizer.next() )
+            break;
+        uint64_t elapsed = cycles() - start;
+
+        size_t cls = static_cast<size_t>( classify( tokenizer.currentToken() ) );
+        classCycles[cls] += elapsed>overhead ? elapsed-overhead : 0;
+        classBytes[cls] += tokenizer.currentTokenText().size();
+        classTokens[cls]++;
+    }
+
+    for( size_t cls=0; cls<NumClasses; ++cls ) {
+        if( classTokens[cls]==0 )
+            continue;
+
+        printf( "    %-12s %5.1f%% of bytes %7.2f cycles/byte %7.1f cycles/token\n", TokenClassNames[cls],
+                100.0 * classBytes[cls] / text.size(), double(classCycles[cls]) / classBytes[cls],
+                double(classCycles[cls]) / classTokens[cls] );
+    }
+}
+
+void help() {
+    std::cout <<
+            "practical-sa-bench: measure tokenizer throughput over synthetic corpora\n"
+            "Usage: practical-sa-bench [options]\n"
+            "Options:\n"
+            "-s<KiB>\tSize of each corpus (default 4096)\n"
+            "-r<num>\tNumber of timed runs, best one is reported (default 5)\n"
+            "-S<num>\tRandom seed for the corpus generator (default 1)\n"
+            "-c<name>\tOnly run the named corpus\n"
+            "-l\tUse the legacy tokenizer engine\n"
+            "-q\tSkip the per token class breakdown\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+    int opt;
+
+    while( (opt=getopt(argc, argv, "s:r:S:c:lq?")) != -1 ) {
+        switch( opt ) {
+        case 's':
+            options.size = strtoul( optarg, nullptr, 10 ) * 1024;
+            break;
+        case 'r':
+            options.repetitions = std::max( strtoul( optarg, nullptr, 10 ), 1ul );
+            break;
+        case 'S':
+            options.seed = strtoul( optarg, nullptr, 10 );
+            break;
+        case 'c':
+            options.only = optarg;
+            break;
+        case 'l':
+            options.engine = Tokenizer::Engine::Legacy;
+            break;
+        case 'q':
+            options.breakdown = false;
+            break;
+        case '?':
+            help();
+            return 0;
+        default:
+            std::cerr << "Invalid option '-" << static_cast<char>(opt) << "'. Use -? for help." << std::endl;
+            help();
+            return 1;
+        }
+    }
+
+    bool found = false;
+    try {
+        for( const Corpus &corpus : Corpora ) {
+            if( options.only!=nullptr && strcmp( options.only, corpus.name )!=0 )
+                continue;
+
+            found = true;
+            runCorpus( corpus, options );
+        }
+    } catch( PracticalSemanticAnalyzer::tokenizer_error &error ) {
+        std::cerr << "Generated corpus failed to tokenize: " << error.what() << "\n";
+        return 1;
+    }
+
+    if( !found ) {
+        std::cerr << "No corpus named " << options.only << "\n";
+        return 1;
+    }
+}
@@ -7,6 +7,10 @@
  * home directory.
  */
 #include "tokenizer.h"
+#include "tokenizer/perfect_hash.h"
+#include "tokenizer/streaming.h"
+#include "tokenizer/token_stream.h"
+#include "tokenizer/trivia.h"
 
 #include "mmap.h"
 #include "ut/dirscan.h"
@@ -16,7 +20,9 @@
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <algorithm>
+#include <random>
 #include <regex>
+#include <sstream>
 
 class TokenizerTest : public CppUnit::TestFixture  {
     static constexpr size_t TEST_NAME_MAX_LENGTH = 200;
@@ -25,6 +31,11 @@ class TokenizerTest : public CppUnit::TestFixture  {
         Tokenizer::Tokens token;
     };
 
+    struct TestPoint {
+        Tokenizer::Tokens token;
+        SourceLocation location;
+    };
+
     template <typename T>
     static Slice<T> consumeLine(Slice<T> &buffer) {
         if( buffer.size()==0 )
@@ -63,10 +74,6 @@ class TokenizerTest : public CppUnit::TestFixture  {
 
         std::cout<<testName<<"\n";
 
-        struct TestPoint {
-            Tokenizer::Tokens token;
-            SourceLocation location;
-        };
         std::vector<TestPoint> testPoints;
         SourceLocation finishLocation;
 
@@ -154,6 +161,15 @@ class TokenizerTest : public CppUnit::TestFixture  {
                 // Identifier like
                 else CASE(IDENTIFIER)
                 else CASE(RESERVED_DEF)
+                else CASE(RESERVED_DECL)
+                else CASE(RESERVED_EXPECT)
+                else CASE(RESERVED_TRUE)
+                else CASE(RESERVED_FALSE)
+                else CASE(RESERVED_IF)
+                else CASE(RESERVED_ELSE)
+                else CASE(RESERVED_REF)
+                else CASE(RESERVED_NULL)
+                else CASE(RESERVED_STRUCT)
                 else if( parsedFields[1].str()=="END" ) {
                     done = true;
                     finishLocation = location;
@@ -168,41 +184,61 @@ class TokenizerTest : public CppUnit::TestFixture  {
             }
         }
 
+        std::vector<Tokenizer::Token> legacyStream = runEngine(
+                Tokenizer::Engine::Legacy, testData, testPoints, finishLocation );
+        std::vector<Tokenizer::Token> tableStream = runEngine(
+                Tokenizer::Engine::Table, testData, testPoints, finishLocation );
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Engines returned different number of tokens", legacyStream.size(), tableStream.size() );
+        for( size_t i=0; i<legacyStream.size(); ++i ) {
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Engines disagree on token", legacyStream[i].token, tableStream[i].token );
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Engines disagree on location", legacyStream[i].location, tableStream[i].location );
+            CPPUNIT_ASSERT_MESSAGE("Engines disagree on text", legacyStream[i].text==tableStream[i].text );
+        }
+    }
+
+    // Returns the full token stream, including white spaces and errors, for comparing the engines
+    static std::vector<Tokenizer::Token> runEngine(
+            Tokenizer::Engine engine, String testData, const std::vector<TestPoint> &testPoints,
+            SourceLocation finishLocation )
+    {
+        std::vector<Tokenizer::Token> stream;
         size_t expectedIndex = 0;
-        Tokenizer::Tokenizer tokenizer(testData);
+        Tokenizer::Tokenizer tokenizer(testData, engine);
         while( true ) {
-            TestPoint *point = &testPoints[expectedIndex];
+            const TestPoint *point = &testPoints[expectedIndex];
 
-            Tokenizer::Tokens currentToken;
-            SourceLocation currentLocation;
+            Tokenizer::Token current;
             try {
                 if( !tokenizer.next() )
                     break;
 
-                currentToken = tokenizer.currentToken();
-                currentLocation = tokenizer.currentLocation();
+                current = tokenizer.current();
             } catch( PracticalSemanticAnalyzer::tokenizer_error &ex ) {
-                currentToken = Tokenizer::Tokens::ERR;
-                currentLocation = ex.getLocation();
+                current.token = Tokenizer::Tokens::ERR;
+                current.location = ex.getLocation();
             }
-            std::cout<<"Tokenizer matched "<<currentToken<<"\n";
+            stream.push_back(current);
+            std::cout<<"Tokenizer matched "<<current.token<<"\n";
 
-            if( currentToken == point->token ) {
-                CPPUNIT_ASSERT_EQUAL_MESSAGE("Unexpected token line", point->location, currentLocation );
+            if( current.token == point->token ) {
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("Unexpected token line", point->location, current.location );
                 expectedIndex++;
-            } else if( currentToken==Tokenizer::Tokens::WS ) {
+            } else if( current.token==Tokenizer::Tokens::WS ) {
                 // Do nothing: we're allowed to ignore white spaces
             } else {
-                std::cerr << "At " << currentLocation << ": Detected token " << currentToken <<
+                std::cerr << "At " << current.location << ": Detected token " << current.token <<
                         ", expected " << point->token << " " << point->location << ": text was \"" <<
                         tokenizer.currentTokenText() << "\"\n";
-                CPPUNIT_ASSERT_EQUAL_MESSAGE("Tokenizer returned unexpected token", point->token, currentToken);
+                CPPUNIT_ASSERT_EQUAL_MESSAGE("Tokenizer returned unexpected token", point->token, current.token);
                 CPPUNIT_FAIL("Unreachable code reached");
             }
         }
 
         CPPUNIT_ASSERT_EQUAL_MESSAGE("Not all expected tokens were matched", testPoints.size(), expectedIndex );
         CPPUNIT_ASSERT_EQUAL_MESSAGE("Tokenizer finish line incorrect", finishLocation, tokenizer.currentLocation() );
+
+        return stream;
     }
 
     void test() {
@@ -222,6 +258,429 @@ class TokenizerTest : public CppUnit::TestFixture  {
         }
     }
 
+    static ExactInt intValue(const char *source) {
+        auto legacy = Tokenizer::Tokenizer::tokenize(source, Tokenizer::Engine::Legacy);
+        auto table = Tokenizer::Tokenizer::tokenize(source, Tokenizer::Engine::Table);
+        CPPUNIT_ASSERT_EQUAL( size_t(1), table.size() );
+        CPPUNIT_ASSERT( legacy.size()==1 && legacy[0].value==table[0].value );
+
+        return std::get<ExactInt>(table[0].value);
+    }
+
+    static double fpValue(const char *source) {
+        auto tokens = Tokenizer::Tokenizer::tokenize(source);
+        CPPUNIT_ASSERT_EQUAL( size_t(1), tokens.size() );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::LITERAL_FP, tokens[0].token );
+
+        return std::get<double>(tokens[0].value);
+    }
+
+    static void expectInvalid(const char *source) {
+        for( auto engine : { Tokenizer::Engine::Legacy, Tokenizer::Engine::Table } ) {
+            CPPUNIT_ASSERT_THROW_MESSAGE( source, Tokenizer::Tokenizer::tokenize(source, engine),
+                    PracticalSemanticAnalyzer::tokenizer_error );
+        }
+    }
+
+    void numericValues() {
+        CPPUNIT_ASSERT( intValue("0") == ExactInt(0u) );
+        CPPUNIT_ASSERT( intValue("12_39_84") == ExactInt(123984u) );
+        CPPUNIT_ASSERT( intValue("0x5afe__dc67") == ExactInt(0x5afedc67u) );
+        CPPUNIT_ASSERT( intValue("0XFF") == ExactInt(255u) );
+        CPPUNIT_ASSERT( intValue("0b1101_1110") == ExactInt(0xdeu) );
+        CPPUNIT_ASSERT( intValue("0o7232") == ExactInt(07232u) );
+        CPPUNIT_ASSERT( intValue("18446744073709551616") == ExactInt( (unsigned __int128)1<<64 ) );
+
+        CPPUNIT_ASSERT_EQUAL( 1.5, fpValue("1.5") );
+        CPPUNIT_ASSERT_EQUAL( 1e10, fpValue("1e1_0") );
+        CPPUNIT_ASSERT_EQUAL( 2.5e-3, fpValue("2.5e-3") );
+
+        expectInvalid("12a");
+        expectInvalid("0x");
+        expectInvalid("0b12");
+        expectInvalid("0o8");
+        expectInvalid("1e");
+        expectInvalid("340282366920938463463374607431768211456");
+        expectInvalid("12\xc3\xa9");
+
+        // A dot not followed by a digit is not part of the literal
+        auto tokens = Tokenizer::Tokenizer::tokenize("1.a");
+        CPPUNIT_ASSERT_EQUAL( size_t(3), tokens.size() );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::LITERAL_INT_10, tokens[0].token );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::OP_DOT, tokens[1].token );
+    }
+
+    static void compareScans(
+            const Tokenizer::Trivia::Scan &expected, const Tokenizer::Trivia::Scan &actual, const char *name)
+    {
+        CPPUNIT_ASSERT_MESSAGE( name, expected.stop==actual.stop );
+        CPPUNIT_ASSERT_MESSAGE( name, expected.newLines==actual.newLines );
+        CPPUNIT_ASSERT_MESSAGE( name, expected.lastNewLine==actual.lastNewLine );
+    }
+
+    void triviaKernels() {
+        using namespace Tokenizer::Trivia;
+
+        const Kernels *scalar = kernelsFor(Isa::Scalar);
+        CPPUNIT_ASSERT( scalar!=nullptr );
+
+        // Mostly trivia, with the occasional character that stops one of the scans
+        static const char Alphabet[] = "    \t\t\r\n\n\n    *//a\xc3";
+        std::mt19937 random(1);
+        std::vector<char> buffer(200);
+
+        for( Isa isa : { Isa::Sse2, Isa::Avx2 } ) {
+            const Kernels *kernels = kernelsFor(isa);
+            if( kernels==nullptr )
+                continue;
+
+            for( unsigned iteration=0; iteration<5000; ++iteration ) {
+                for( char &c : buffer )
+                    c = Alphabet[ random() % (sizeof(Alphabet)-1) ];
+
+                size_t start = random() % buffer.size();
+                size_t end = start + random() % (buffer.size() - start + 1);
+                const char *begin = buffer.data() + start, *finish = buffer.data() + end;
+
+                compareScans( scalar->skipWhiteSpace(begin, finish), kernels->skipWhiteSpace(begin, finish),
+                        "skipWhiteSpace" );
+                compareScans( scalar->findNewLine(begin, finish), kernels->findNewLine(begin, finish),
+                        "findNewLine" );
+                compareScans( scalar->findCommentSpecial(begin, finish), kernels->findCommentSpecial(begin, finish),
+                        "findCommentSpecial" );
+                compareScans( scalar->findNonAscii(begin, finish), kernels->findNonAscii(begin, finish),
+                        "findNonAscii" );
+            }
+        }
+    }
+
+    void reservedWords() {
+        static constexpr Tokenizer::PerfectHash<Tokenizer::ReservedWordSpellings.size(), 32> hash(
+                Tokenizer::ReservedWordSpellings );
+
+        for( const Tokenizer::Spelling &spelling : Tokenizer::ReservedWordSpellings ) {
+            CPPUNIT_ASSERT_EQUAL( spelling.token, hash.lookup( spelling.text, Tokenizer::Tokens::IDENTIFIER ) );
+            CPPUNIT_ASSERT_EQUAL( spelling.token, Tokenizer::Tokenizer::tokenize( spelling.text ).at(0).token );
+        }
+
+        for( const char *word : { "d", "de", "deff", "Def", "iff", "structs", "elsewhere", "_" } )
+            CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::IDENTIFIER, hash.lookup( word, Tokenizer::Tokens::IDENTIFIER ) );
+    }
+
+    void tokenStream() {
+        static const char Source[] =
+                "/* Multi\n * line */\n"
+                "def main() -> S32 {\n"
+                "    // Comment\n"
+                "    return 0x10 + 1.5 + \"str\\\"ing\";\n"
+                "}\n";
+
+        auto tokens = Tokenizer::Tokenizer::tokenize(Source);
+        auto stream = Tokenizer::TokenStream::tokenize(Source);
+
+        CPPUNIT_ASSERT_EQUAL( tokens.size(), stream.size() );
+        std::vector<Tokenizer::Token> materialized = stream.materialize();
+        Tokenizer::TokenView view = stream.view();
+
+        size_t index = 0;
+        for( Tokenizer::TokenView::Ref ref : view ) {
+            const Tokenizer::Token &expected = tokens[index];
+
+            CPPUNIT_ASSERT_EQUAL( expected.token, ref.kind() );
+            CPPUNIT_ASSERT( expected.text==ref.text() );
+            CPPUNIT_ASSERT_EQUAL( expected.location, ref.location() );
+            CPPUNIT_ASSERT( expected.value==ref.value() );
+            CPPUNIT_ASSERT_EQUAL( expected.symbol, ref.symbol() );
+
+            CPPUNIT_ASSERT_EQUAL( expected.token, materialized[index].token );
+            CPPUNIT_ASSERT( expected.text==materialized[index].text );
+            CPPUNIT_ASSERT_EQUAL( expected.location, materialized[index].location );
+            CPPUNIT_ASSERT( expected.value==materialized[index].value );
+            CPPUNIT_ASSERT_EQUAL( expected.symbol, materialized[index].symbol );
+
+            ++index;
+        }
+        CPPUNIT_ASSERT_EQUAL( tokens.size(), index );
+
+        Tokenizer::TokenView tail = view.subslice(3);
+        CPPUNIT_ASSERT_EQUAL( view.size()-3, tail.size() );
+        CPPUNIT_ASSERT_EQUAL( size_t(3), tail[0].index() );
+        CPPUNIT_ASSERT_EQUAL( size_t(0), view.subslice(5, 5).size() );
+
+        CPPUNIT_ASSERT( stream.memoryUsage() < tokens.size() * sizeof(Tokenizer::Token) );
+    }
+
+    void streaming() {
+        static const char Source[] =
+                "decl (\"C\") f( a : S32 ) -> S32;\n"
+                "// Comment\n"
+                "def g() -> S32 { if( true ) { 1 } else { 2 } }\n"
+                "struct S { a : S32; }\n"
+                "def h() -> S32 { 3 } tail";
+
+        auto tokens = Tokenizer::Tokenizer::tokenize(Source);
+        std::vector<const Tokenizer::Token *> expected;
+        for( const Tokenizer::Token &token : tokens ) {
+            if( token.token!=Tokenizer::Tokens::WS && token.token!=Tokenizer::Tokens::COMMENT_LINE_END )
+                expected.push_back( &token );
+        }
+
+        // A tiny lookahead makes the ring wrap around many times
+        Tokenizer::StreamingTokenizer stream(Source, 3);
+        std::vector<Slice<const Tokenizer::Token>> definitions;
+        for( auto definition = stream.nextDefinition(); definition.size()>0; definition = stream.nextDefinition() )
+            definitions.push_back( definition );
+
+        CPPUNIT_ASSERT_EQUAL( size_t(5), definitions.size() );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::RESERVED_DECL, definitions[0][0].token );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::RESERVED_DEF, definitions[1][0].token );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::RESERVED_STRUCT, definitions[2][0].token );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::RESERVED_DEF, definitions[3][0].token );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::IDENTIFIER, definitions[4][0].token );
+        CPPUNIT_ASSERT( stream.exhausted() );
+
+        // Pinned tokens stay put, and match the full tokenization
+        size_t index = 0;
+        for( auto definition : definitions ) {
+            for( const Tokenizer::Token &token : definition ) {
+                CPPUNIT_ASSERT( index<expected.size() );
+                CPPUNIT_ASSERT_EQUAL( expected[index]->token, token.token );
+                CPPUNIT_ASSERT_EQUAL( expected[index]->location, token.location );
+                ++index;
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL( expected.size(), index );
+        CPPUNIT_ASSERT_EQUAL( expected.size(), stream.numPinnedTokens() );
+
+        Tokenizer::StreamingTokenizer partial(Source);
+        auto first = partial.nextDefinition();
+        auto rest = partial.pinRemaining( first.subslice(1) );
+        CPPUNIT_ASSERT_EQUAL( expected.size()-1, rest.size() );
+        CPPUNIT_ASSERT( partial.exhausted() );
+    }
+
+    void significant() {
+        static const char Source[] =
+                "  /* Leading */ def f() -> S32 {\n"
+                "    // Comment\n"
+                "    1 }  \n";
+
+        auto tokens = Tokenizer::Tokenizer::tokenize(Source);
+        Tokenizer::TriviaTable trivia;
+        auto significant = Tokenizer::Tokenizer::tokenizeSignificant(Source, &trivia);
+
+        CPPUNIT_ASSERT_EQUAL( size_t(9), significant.size() );
+        CPPUNIT_ASSERT_EQUAL( tokens.size(), significant.size() + trivia.size() );
+        CPPUNIT_ASSERT_EQUAL( size_t(3), trivia.before(0).size() );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::COMMENT_MULTILINE, trivia.before(0)[1].token );
+        CPPUNIT_ASSERT_EQUAL( size_t(0), trivia.before(2).size() );
+
+        // Interleaving the two gives back the full stream
+        size_t index = 0;
+        for( size_t i=0; i<=significant.size(); ++i ) {
+            for( const Tokenizer::Token &token : trivia.before(i) ) {
+                CPPUNIT_ASSERT( Tokenizer::Tokenizer::isTrivia(token.token) );
+                CPPUNIT_ASSERT_EQUAL( tokens[index].location, token.location );
+                ++index;
+            }
+
+            if( i<significant.size() ) {
+                CPPUNIT_ASSERT_EQUAL( tokens[index].token, significant[i].token );
+                CPPUNIT_ASSERT_EQUAL( tokens[index].location, significant[i].location );
+                ++index;
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL( tokens.size(), index );
+    }
+
+    static std::string dumpTokens(const std::vector<Tokenizer::Token> &tokens, const char *base) {
+        std::ostringstream out;
+        for( const Tokenizer::Token &token : tokens )
+            out<<token<<" @"<<(token.text.get() - base)<<" "<<token.value.index()<<"\n";
+
+        return out.str();
+    }
+
+    void relex() {
+        // Edits that open, close and nest comments and strings, and join or split UTF-8 sequences
+        static const char Alphabet[] = "ab 1.\n\n/**/\"\"\\;{}+-<\xc3\xa9";
+        std::mt19937 random(2);
+
+        for( unsigned iteration=0; iteration<20000; ++iteration ) {
+            std::string old;
+            for( size_t length = random() % 60; length>0; --length )
+                old += Alphabet[ random() % (sizeof(Alphabet)-1) ];
+
+            std::vector<Tokenizer::Token> previous;
+            try {
+                previous = Tokenizer::Tokenizer::tokenize(old);
+            } catch( PracticalSemanticAnalyzer::tokenizer_error & ) {
+                continue;
+            }
+
+            Tokenizer::Edit edit;
+            edit.begin = random() % (old.size()+1);
+            edit.end = edit.begin + random() % (old.size() - edit.begin + 1);
+            std::string replacement;
+            for( size_t length = random() % 4; length>0; --length )
+                replacement += Alphabet[ random() % (sizeof(Alphabet)-1) ];
+            edit.replacement = replacement;
+
+            std::string source = old.substr(0, edit.begin) + replacement + old.substr(edit.end);
+            std::string expected, actual;
+            try {
+                expected = dumpTokens( Tokenizer::Tokenizer::tokenize(source), source.c_str() );
+            } catch( PracticalSemanticAnalyzer::tokenizer_error &error ) {
+                expected = error.what();
+            }
+            try {
+                auto replaced = Tokenizer::Tokenizer::relex(previous, edit, source);
+                CPPUNIT_ASSERT( replaced.first<=replaced.second && replaced.second<=previous.size() );
+                actual = dumpTokens( previous, source.c_str() );
+            } catch( PracticalSemanticAnalyzer::tokenizer_error &error ) {
+                actual = error.what();
+            }
+
+            CPPUNIT_ASSERT_EQUAL_MESSAGE( old + " -> " + source, expected, actual );
+        }
+    }
+
+    void symbols() {
+        static const char Source[] = "def counter() { counter2 + counter + Counter }";
+
+        auto tokens = Tokenizer::Tokenizer::tokenizeSignificant(Source);
+        const Tokenizer::Token &first = tokens[1], &second = tokens[7], &other = tokens[5], &upper = tokens[9];
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::IDENTIFIER, first.token );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::NoSymbol, tokens[0].symbol );
+
+        CPPUNIT_ASSERT( first.symbol!=Tokenizer::NoSymbol );
+        CPPUNIT_ASSERT_EQUAL( first.symbol, second.symbol );
+        CPPUNIT_ASSERT( first.symbol!=other.symbol );
+        CPPUNIT_ASSERT( first.symbol!=upper.symbol );
+
+        CPPUNIT_ASSERT( Tokenizer::Symbols::text( first.symbol )==String("counter") );
+        CPPUNIT_ASSERT_EQUAL( first.symbol, Tokenizer::Symbols::find("counter") );
+        CPPUNIT_ASSERT_EQUAL( first.symbol, Tokenizer::Symbols::intern( std::string("counter") ) );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::NoSymbol, Tokenizer::Symbols::find("neverSeenInAnySource") );
+
+        auto stream = Tokenizer::TokenStream::tokenize(Source);
+        CPPUNIT_ASSERT_EQUAL( other.symbol, stream.symbol(8) );
+    }
+
+    static size_t firstInvalid(const std::string &text) {
+        Tokenizer::Utf8::Validation validation = Tokenizer::Utf8::validate( text.data(), text.data() + text.size() );
+        CPPUNIT_ASSERT( !validation.ascii || validation.firstInvalid==text.size() );
+
+        return validation.firstInvalid;
+    }
+
+    void utf8() {
+        using namespace Tokenizer::Utf8;
+
+        // Long enough for the block scans to get involved
+        const std::string ascii(100, 'a');
+        CPPUNIT_ASSERT( validate( ascii.data(), ascii.data() + ascii.size() ).ascii );
+        CPPUNIT_ASSERT_EQUAL( ascii.size(), firstInvalid(ascii) );
+
+        const std::string valid = ascii + "\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 \xf4\x8f\xbf\xbf" + ascii;
+        CPPUNIT_ASSERT( !validate( valid.data(), valid.data() + valid.size() ).ascii );
+        CPPUNIT_ASSERT_EQUAL( valid.size(), firstInvalid(valid) );
+
+        for( const char *bad : {
+                "\x80",                 // Stray continuation
+                "\xc0\x80",             // Overlong
+                "\xe0\x9f\xbf",         // Overlong
+                "\xed\xa0\x80",         // Surrogate
+                "\xf4\x90\x80\x80",     // Past U+10FFFF
+                "\xf5\x80\x80\x80",
+                "\xe2\x82",             // Truncated
+                "\xe2\x82z",
+                "\xff" } )
+        {
+            CPPUNIT_ASSERT_EQUAL_MESSAGE( bad, ascii.size() + 3, firstInvalid( ascii + "\xc3\xa9" "a" + bad + ascii ) );
+        }
+
+        size_t length;
+        CPPUNIT_ASSERT_EQUAL( char32_t(0x20ac), decode( "\xe2\x82\xac", "\xe2\x82\xac" + 3, length ) );
+        CPPUNIT_ASSERT_EQUAL( size_t(3), length );
+
+        CPPUNIT_ASSERT( isXidStart(0x5e9) );      // Hebrew shin
+        CPPUNIT_ASSERT( isXidStart(0x5909) );     // CJK ideograph
+        CPPUNIT_ASSERT( !isXidStart(0x301) );     // Combining acute accent
+        CPPUNIT_ASSERT( isXidContinue(0x301) );
+        CPPUNIT_ASSERT( !isXidContinue(0x2192) ); // Rightwards arrow
+        CPPUNIT_ASSERT( !isXidContinue(0xa0) );   // No-break space
+
+        // Both engines agree on identifiers beyond ASCII, and intern them like any other
+        static const char Source[] = "e\xcc\x81t\xc3\xa9 \xd7\xa9\xd7\x9c\xd7\x95\xd7\x9d" "2 \xc3\xa9t\xc3\xa9";
+        auto legacy = Tokenizer::Tokenizer::tokenizeSignificant(Source, nullptr, Tokenizer::Engine::Legacy);
+        auto table = Tokenizer::Tokenizer::tokenizeSignificant(Source);
+        CPPUNIT_ASSERT_EQUAL( size_t(3), table.size() );
+        CPPUNIT_ASSERT_EQUAL( dumpTokens(table, Source), dumpTokens(legacy, Source) );
+        CPPUNIT_ASSERT( table[1].text==String("\xd7\xa9\xd7\x9c\xd7\x95\xd7\x9d" "2") );
+        CPPUNIT_ASSERT_EQUAL( Tokenizer::Tokens::IDENTIFIER, table[2].token );
+        CPPUNIT_ASSERT_EQUAL( 18u, table[2].location.col );
+        CPPUNIT_ASSERT( table[0].symbol!=table[2].symbol );
+        CPPUNIT_ASSERT_EQUAL( table[2].symbol, Tokenizer::Symbols::find("\xc3\xa9t\xc3\xa9") );
+
+        // Neither a combining mark nor a symbol may start one
+        expectInvalid("\xcc\x81t");
+        expectInvalid("a\xe2\x86\x92" "b");
+        // Bad sequences are caught even where the lexer never looks at the characters
+        expectInvalid("// \xc3(\n");
+        expectInvalid("\"\xed\xa0\x80\"");
+
+        // An edit that breaks up a sequence
+        std::string source = "a /* \xc3\xa9 */ b";
+        std::vector<Tokenizer::Token> tokens = Tokenizer::Tokenizer::tokenize(source);
+        source.erase(5, 1);
+        CPPUNIT_ASSERT_THROW_MESSAGE( "relex",
+                Tokenizer::Tokenizer::relex( tokens, Tokenizer::Edit{ 5, 6, String() }, source ),
+                PracticalSemanticAnalyzer::tokenizer_error );
+    }
+
+    static std::string tokenizeOrError(const std::string &source, unsigned threads) {
+        std::ostringstream out;
+
+        try {
+            std::vector<Tokenizer::Token> tokens = threads==0 ?
+                    Tokenizer::Tokenizer::tokenize(source) :
+                    Tokenizer::Tokenizer::tokenizeParallel(source, threads, 1);
+
+            for( const Tokenizer::Token &token : tokens )
+                out<<token<<" "<<static_cast<const void *>(token.text.get())<<" "<<token.value.index()<<"\n";
+        } catch( PracticalSemanticAnalyzer::tokenizer_error &error ) {
+            out<<error.what();
+        }
+
+        return out.str();
+    }
+
+    void parallel() {
+        // Chunk boundaries land inside comments, strings and tokens
+        static const char Unit[] =
+                "def f() -> S32 { // Comment \"\n"
+                "    /* Multi\n line\n /* nested\n */ \"*/\n"
+                "    \"str\\\"ing /*\" + 0x1_0 + 1.5e3;\n"
+                "}\n";
+
+        std::string source;
+        for( int i=0; i<50; ++i )
+            source += Unit;
+
+        std::string expected = tokenizeOrError(source, 0);
+        for( unsigned threads : { 1, 2, 3, 7, 16, 64 } )
+            CPPUNIT_ASSERT_EQUAL( expected, tokenizeOrError(source, threads) );
+
+        // Errors, including ones a chunk's guess would hide, are those of the sequential scan
+        for( const char *tail : { "/* Unterminated\n", "\"Unterminated\n", "\n  $\n", "\n  @@\n" } ) {
+            std::string bad = source + tail + source;
+            expected = tokenizeOrError(bad, 0);
+            for( unsigned threads : { 2, 5, 16 } )
+                CPPUNIT_ASSERT_EQUAL( expected, tokenizeOrError(bad, threads) );
+        }
+    }
+
 public:
     static CppUnit::Test *suite()
     {
@@ -229,6 +688,36 @@ public:
         suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
                     "test",
                     &TokenizerTest::test ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "numericValues",
+                    &TokenizerTest::numericValues ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "triviaKernels",
+                    &TokenizerTest::triviaKernels ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "reservedWords",
+                    &TokenizerTest::reservedWords ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "tokenStream",
+                    &TokenizerTest::tokenStream ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "streaming",
+                    &TokenizerTest::streaming ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "parallel",
+                    &TokenizerTest::parallel ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "significant",
+                    &TokenizerTest::significant ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "relex",
+                    &TokenizerTest::relex ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "symbols",
+                    &TokenizerTest::symbols ) );
+        suiteOfTests->addTest( new CppUnit::TestCaller<TokenizerTest>(
+                    "utf8",
+                    &TokenizerTest::utf8 ) );
         return suiteOfTests;
     }
 };